@@ -0,0 +1,294 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "BuildCache.h"
+#include "../Tokenizer/SourceBuffer.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace nand2tetris::jack {
+
+    namespace {
+        // Manifest layout (one record per line, tab-separated):
+        //   JACKCACHE 1 <configKey>
+        //   F <sourcePath> <sourceHash> <outputSize> <outputStamp> <className>
+        //   M <name> <returnType> <isStatic> <line> <column> [<paramType>...]   (belongs to the last F)
+        //   D <className> <methodName> <hash>                                   (belongs to the last F)
+
+        std::vector<std::string_view> splitFields(const std::string_view line) {
+            std::vector<std::string_view> fields;
+            std::size_t start = 0;
+            while (true) {
+                const std::size_t tab = line.find('\t', start);
+                fields.push_back(line.substr(start, tab == std::string_view::npos ? std::string_view::npos : tab - start));
+                if (tab == std::string_view::npos) break;
+                start = tab + 1;
+            }
+            return fields;
+        }
+
+        std::uint64_t parseHex(const std::string_view s) {
+            std::size_t used = 0;
+            const std::string text(s);
+            const std::uint64_t value = std::stoull(text, &used, 16);
+            if (used != text.size()) throw std::invalid_argument("bad hex");
+            return value;
+        }
+
+        long long parseInt(const std::string_view s) {
+            std::size_t used = 0;
+            const std::string text(s);
+            const long long value = std::stoll(text, &used, 10);
+            if (used != text.size()) throw std::invalid_argument("bad integer");
+            return value;
+        }
+
+        void mix(std::uint64_t& hash, const std::string_view bytes) {
+            for (const char c : bytes) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 0x100000001b3ULL;
+            }
+            // Field separator, so ("ab","c") and ("a","bc") differ.
+            hash ^= 0xff;
+            hash *= 0x100000001b3ULL;
+        }
+
+        constexpr std::uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+
+        // Size and modification time of a file; false if it does not exist.
+        bool outputState(const std::string& path, std::uintmax_t& size, long long& stamp) {
+            std::error_code ec;
+            size = fs::file_size(path, ec);
+            if (ec) return false;
+            const auto time = fs::last_write_time(path, ec);
+            if (ec) return false;
+            stamp = static_cast<long long>(time.time_since_epoch().count());
+            return true;
+        }
+
+        // "/proj/./Main.jack" and "/proj/Main.jack" must share an entry.
+        std::string cacheKey(const std::string& sourcePath) {
+            return fs::path(sourcePath).lexically_normal().string();
+        }
+    }
+
+    BuildCache::BuildCache(std::string manifestPath, std::string configKey)
+        : manifestPath(std::move(manifestPath)), configKey(std::move(configKey)) {}
+
+    std::uint64_t BuildCache::hashBytes(const std::string_view bytes) {
+        std::uint64_t hash = FNV_OFFSET;
+        for (const char c : bytes) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    std::uint64_t BuildCache::dependencyHash(const GlobalRegistry &registry, const SymbolId className,
+                                             const SymbolId methodName) {
+        if (methodName == NO_SYMBOL) {
+            return registry.classExists(className) ? 1 : 0;
+        }
+        if (!registry.methodExists(className, methodName)) {
+            return 0;
+        }
+
+        // Declaration line/column are left out: moving a subroutine does not affect its callers.
+        const MethodSignature& sig = registry.getSignature(className, methodName);
+        std::uint64_t hash = FNV_OFFSET;
+        // Hash the text, not the ids: the manifest outlives this process's interner.
+        mix(hash, nameOf(sig.returnType));
+        mix(hash, sig.isStatic ? "static" : "member");
+        for (const SymbolId param : sig.parameters) mix(hash, nameOf(param));
+        return hash == 0 ? 1 : hash; // 0 is reserved for "does not exist".
+    }
+
+    void BuildCache::load() {
+        previous.clear();
+
+        std::ifstream in(manifestPath, std::ios::binary);
+        if (!in) return;
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        const std::string text = buffer.str();
+
+        std::unordered_map<std::string, CacheEntry> loaded;
+        CacheEntry* current = nullptr;
+        std::size_t lineStart = 0;
+        bool headerSeen = false;
+
+        try {
+            while (lineStart < text.size()) {
+                std::size_t lineEnd = text.find('\n', lineStart);
+                if (lineEnd == std::string::npos) lineEnd = text.size();
+                const std::string_view line(text.data() + lineStart, lineEnd - lineStart);
+                lineStart = lineEnd + 1;
+                if (line.empty()) continue;
+
+                const std::vector<std::string_view> f = splitFields(line);
+                if (!headerSeen) {
+                    // A different format or different code-affecting options: start from scratch.
+                    if (f.size() != 2 || f[0] != FORMAT_TAG || f[1] != configKey) return;
+                    headerSeen = true;
+                    continue;
+                }
+
+                if (f[0] == "F" && f.size() == 6) {
+                    CacheEntry entry;
+                    entry.sourceHash = parseHex(f[2]);
+                    entry.outputSize = static_cast<std::uintmax_t>(parseInt(f[3]));
+                    entry.outputStamp = parseInt(f[4]);
+                    entry.className = std::string(f[5]);
+                    current = &(loaded[std::string(f[1])] = std::move(entry));
+                } else if (f[0] == "M" && f.size() >= 6 && current) {
+                    CachedMethod method;
+                    method.name = std::string(f[1]);
+                    method.returnType = std::string(f[2]);
+                    method.isStatic = f[3] == "1";
+                    method.line = static_cast<int>(parseInt(f[4]));
+                    method.column = static_cast<int>(parseInt(f[5]));
+                    for (std::size_t i = 6; i < f.size(); ++i) method.parameters.emplace_back(f[i]);
+                    current->methods.push_back(std::move(method));
+                } else if (f[0] == "D" && f.size() == 4 && current) {
+                    current->dependencies.push_back({std::string(f[1]), std::string(f[2]), parseHex(f[3])});
+                } else {
+                    return; // Corrupt manifest: ignore it.
+                }
+            }
+        } catch (const std::exception&) {
+            return; // Corrupt manifest: ignore it.
+        }
+
+        previous = std::move(loaded);
+    }
+
+    void BuildCache::save() const {
+        std::vector<const std::pair<const std::string, CacheEntry>*> ordered;
+        {
+            std::scoped_lock lock(mtx);
+            ordered.reserve(next.size());
+            for (const auto& item : next) ordered.push_back(&item);
+        }
+        std::sort(ordered.begin(), ordered.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+        std::ostringstream out;
+        out << FORMAT_TAG << '\t' << configKey << '\n' << std::hex;
+        for (const auto* item : ordered) {
+            const CacheEntry& e = item->second;
+            out << "F\t" << item->first << '\t' << e.sourceHash << '\t' << std::dec << e.outputSize << '\t'
+                << e.outputStamp << std::hex << '\t' << e.className << '\n';
+            for (const CachedMethod& m : e.methods) {
+                out << "M\t" << m.name << '\t' << m.returnType << '\t' << (m.isStatic ? 1 : 0) << '\t'
+                    << std::dec << m.line << '\t' << m.column << std::hex;
+                for (const std::string& param : m.parameters) out << '\t' << param;
+                out << '\n';
+            }
+            for (const CachedDependency& d : e.dependencies) {
+                out << "D\t" << d.className << '\t' << d.methodName << '\t' << d.hash << '\n';
+            }
+        }
+
+        // Write beside the manifest and rename over it, so an interrupted build never leaves half a file.
+        const std::string tempPath = manifestPath + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            const std::string bytes = out.str();
+            if (!file || !file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()))) {
+                throw std::runtime_error("Could not write build cache: " + tempPath);
+            }
+        }
+        std::error_code ec;
+        fs::rename(tempPath, manifestPath, ec);
+        if (ec) {
+            fs::remove(tempPath, ec);
+            throw std::runtime_error("Could not write build cache: " + manifestPath);
+        }
+    }
+
+    const CacheEntry* BuildCache::lookup(const std::string &sourcePath, const std::uint64_t sourceHash) const {
+        const auto it = previous.find(cacheKey(sourcePath));
+        if (it == previous.end() || it->second.sourceHash != sourceHash) {
+            return nullptr;
+        }
+
+        // The output must still be the one we wrote (a failed build may have overwritten it).
+        if (!outputUnchanged(it->second, fs::path(sourcePath).replace_extension(".vm").string())) {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    bool BuildCache::outputUnchanged(const CacheEntry &entry, const std::string &outputPath) {
+        std::uintmax_t size = 0;
+        long long stamp = 0;
+        return outputState(outputPath, size, stamp) && size == entry.outputSize && stamp == entry.outputStamp;
+    }
+
+    void BuildCache::registerEntry(const CacheEntry &entry, GlobalRegistry &registry) {
+        const SymbolId className = intern(entry.className);
+        if (!registry.registerClass(className)) {
+            throw std::runtime_error("Duplicate class definition: Class '" + entry.className + "' is already defined.");
+        }
+
+        std::vector<SymbolId> params;
+        for (const CachedMethod& m : entry.methods) {
+            params.clear();
+            for (const std::string& p : m.parameters) params.push_back(intern(p));
+            registry.registerMethod(className, intern(m.name), intern(m.returnType), params, m.isStatic, m.line, m.column);
+        }
+    }
+
+    bool BuildCache::dependenciesUnchanged(const CacheEntry &entry, const GlobalRegistry &registry) {
+        return std::all_of(entry.dependencies.begin(), entry.dependencies.end(), [&](const CachedDependency& d) {
+            return dependencyHash(registry, intern(d.className), intern(d.methodName)) == d.hash;
+        });
+    }
+
+    CacheEntry BuildCache::makeEntry(const std::uint64_t sourceHash, const SymbolId className,
+                                     const GlobalRegistry &registry, std::vector<RegistryDependency> lookups,
+                                     const std::string &outputPath) {
+        CacheEntry entry;
+        entry.sourceHash = sourceHash;
+        if (!outputState(outputPath, entry.outputSize, entry.outputStamp)) {
+            throw std::runtime_error("Could not stat output file: " + outputPath);
+        }
+        entry.className = std::string(nameOf(className));
+
+        for (const SymbolId name : registry.getMethodNames(className)) {
+            const MethodSignature& sig = registry.getSignature(className, name);
+            CachedMethod method;
+            method.name = std::string(nameOf(name));
+            method.returnType = std::string(nameOf(sig.returnType));
+            for (const SymbolId param : sig.parameters) method.parameters.emplace_back(nameOf(param));
+            method.isStatic = sig.isStatic;
+            method.line = sig.line;
+            method.column = sig.column;
+            entry.methods.push_back(std::move(method));
+        }
+
+        // Ordered by text so the manifest reads the same from run to run.
+        const auto key = [](const RegistryDependency& d) { return std::make_pair(nameOf(d.className), nameOf(d.methodName)); };
+        std::sort(lookups.begin(), lookups.end(), [&](const auto& a, const auto& b) { return key(a) < key(b); });
+        lookups.erase(std::unique(lookups.begin(), lookups.end(), [&](const auto& a, const auto& b) { return key(a) == key(b); }),
+                      lookups.end());
+
+        entry.dependencies.reserve(lookups.size());
+        for (const RegistryDependency& d : lookups) {
+            entry.dependencies.push_back({std::string(nameOf(d.className)), std::string(nameOf(d.methodName)),
+                                          dependencyHash(registry, d.className, d.methodName)});
+        }
+        return entry;
+    }
+
+    void BuildCache::record(const std::string &sourcePath, CacheEntry entry) {
+        std::scoped_lock lock(mtx);
+        next[cacheKey(sourcePath)] = std::move(entry);
+    }
+}
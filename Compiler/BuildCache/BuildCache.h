@@ -0,0 +1,150 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_BUILD_CACHE_H
+#define NAND2TETRIS_BUILD_CACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../SemanticAnalyser/GlobalRegistry.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief A subroutine signature exported by a cached class, owned by the cache.
+     */
+    struct CachedMethod {
+        std::string name;
+        std::string returnType;
+        std::vector<std::string> parameters;
+        bool isStatic = false;
+        int line = 0;
+        int column = 0;
+    };
+
+    /**
+     * @brief One registry lookup a class made, with the hash of what it saw.
+     *
+     * An empty methodName is a class-existence check.
+     */
+    struct CachedDependency {
+        std::string className;
+        std::string methodName;
+        std::uint64_t hash = 0;
+    };
+
+    /**
+     * @brief Everything needed to skip a class whose inputs have not changed.
+     */
+    struct CacheEntry {
+        std::uint64_t sourceHash = 0;  ///< Hash of the .jack file contents.
+        std::uintmax_t outputSize = 0; ///< Size of the .vm file that was written...
+        long long outputStamp = 0;     ///< ...and its modification time, so any later rewrite is noticed.
+        std::string className;         ///< The class the file declares.
+        std::vector<CachedMethod> methods;          ///< Signatures to re-register instead of parsing.
+        std::vector<CachedDependency> dependencies; ///< Registry lookups made during analysis.
+    };
+
+    /**
+     * @brief The persistent per-class cache behind --incremental.
+     *
+     * A manifest next to the outputs maps each source file to a CacheEntry. A class is up to date
+     * when its source hash matches, its .vm file is still the one it wrote, and every registry signature it
+     * looked up last time hashes the same now. Up-to-date classes skip parsing, analysis and code
+     * generation; their exported signatures are registered straight from the manifest.
+     *
+     * Manifests store names as text (ids are only meaningful within one process) and are interned on load.
+     */
+    class BuildCache {
+        public:
+            static constexpr std::string_view MANIFEST_NAME = ".jack_build_cache"; ///< File name inside the project folder.
+
+            /**
+             * @param manifestPath Where the manifest is read from and written to.
+             * @param configKey Describes the options that affect generated code; a different key invalidates every entry.
+             */
+            BuildCache(std::string manifestPath, std::string configKey);
+
+            BuildCache(const BuildCache&) = delete;
+            BuildCache& operator=(const BuildCache&) = delete;
+
+            /**
+             * @brief Reads the manifest. A missing, corrupt or mismatched manifest yields an empty cache.
+             */
+            void load();
+
+            /**
+             * @brief Writes the entries recorded during this build (write-temp-then-rename).
+             *
+             * @throws std::runtime_error if the manifest cannot be written.
+             */
+            void save() const;
+
+            /**
+             * @brief Finds the entry for a source file whose contents and output are unchanged.
+             *
+             * @param sourcePath Absolute path of the .jack file.
+             * @param sourceHash hashBytes() of its current contents.
+             * @return The entry, or nullptr if the file must be compiled.
+             */
+            const CacheEntry* lookup(const std::string& sourcePath, std::uint64_t sourceHash) const;
+
+            /**
+             * @brief True if 'outputPath' is still the file the entry's build wrote (same size and time).
+             */
+            static bool outputUnchanged(const CacheEntry& entry, const std::string& outputPath);
+
+            /**
+             * @brief Registers a cached class and its signatures, as the Parser would have.
+             */
+            static void registerEntry(const CacheEntry& entry, GlobalRegistry& registry);
+
+            /**
+             * @brief True if every dependency still hashes to the recorded value.
+             */
+            static bool dependenciesUnchanged(const CacheEntry& entry, const GlobalRegistry& registry);
+
+            /**
+             * @brief Builds the entry for a class that was just compiled.
+             *
+             * @param sourceHash Hash of the source that was compiled.
+             * @param className The class it declares (already registered).
+             * @param registry The complete registry.
+             * @param lookups The lookups recorded by the SemanticAnalyser (duplicates allowed).
+             * @param outputPath The .vm file that was written.
+             */
+            static CacheEntry makeEntry(std::uint64_t sourceHash, SymbolId className, const GlobalRegistry& registry,
+                                        std::vector<RegistryDependency> lookups, const std::string& outputPath);
+
+            /**
+             * @brief Stores an entry for the next manifest. Thread-safe.
+             */
+            void record(const std::string& sourcePath, CacheEntry entry);
+
+            /**
+             * @brief 64-bit FNV-1a hash.
+             */
+            static std::uint64_t hashBytes(std::string_view bytes);
+
+            /**
+             * @brief Hash of what a lookup returns now: the signature, or whether the class exists.
+             */
+            static std::uint64_t dependencyHash(const GlobalRegistry& registry, SymbolId className, SymbolId methodName);
+
+        private:
+            static constexpr std::string_view FORMAT_TAG = "JACKCACHE 1"; ///< Bumped when the manifest layout changes.
+
+            std::string manifestPath;
+            std::string configKey;
+            std::unordered_map<std::string, CacheEntry> previous; ///< Loaded entries; never modified after load().
+            std::unordered_map<std::string, CacheEntry> next;     ///< Entries for the manifest written by save().
+            mutable std::mutex mtx;                               ///< Guards 'next'.
+    };
+}
+
+#endif //NAND2TETRIS_BUILD_CACHE_H
@@ -3,31 +3,55 @@
 //
 
 #include "CodeGenerator.h"
+#include "../Optimizer/ConstantFolder.h"
+#include "../Optimizer/StrengthReducer.h"
+#include "../Trace/Trace.h"
 
 namespace nand2tetris::jack {
-    CodeGenerator::CodeGenerator(const GlobalRegistry &registry, std::ostream &out,SymbolTable& table):registry
-    (registry),writer(out),symbolTable(table){}
+    CodeGenerator::CodeGenerator(const GlobalRegistry &registry, VMSink &sink,SymbolTable& table,
+                                 const CodeGenOptions& options):registry
+    (registry),writer(sink),symbolTable(table),options(options) {
+        writer.setOptimizing(options.optimizationLevel > 0);
+    }
+
+    CodeGenerator::CodeGenerator(const GlobalRegistry &registry, VMCodeSink &sink,SymbolTable& table,
+                                 const CodeGenOptions& options):registry
+    (registry),writer(sink),symbolTable(table),options(options) {
+        writer.setOptimizing(options.optimizationLevel > 0);
+    }
 
-    std::string CodeGenerator::getUniqueLabel() {
-        return "L" + std::to_string(labelCounter++);
+    int CodeGenerator::getUniqueLabel() {
+        return labelCounter++;
     }
 
     void CodeGenerator::compileClass(const ClassNode &node) {
-        currentClassName=node.getClassName();
+        currentClassName=node.getClassSymbol();
 
         // Compile Subroutines
+        // The analyser visited the subroutines in this same order, so the position is the scope id.
+        int subroutineId = 0;
         for (const auto& sub : node.subroutineDecs) {
-            compileSubroutine(*sub);
+            const int id = subroutineId++;
+            if (options.reachable &&
+                !options.reachable->count(registry.getSignature(currentClassName, sub->name).qualifiedName)) {
+                continue; // Nothing can call it.
+            }
+            compileSubroutine(*sub, id);
         }
+
+        // Deliver the whole class to the sink in one write.
+        TraceScope trace("write", nameOf(currentClassName));
+        writer.flush();
+        trace.setBytes(writer.getBytesEmitted());
     }
 
-    void CodeGenerator::compileSubroutine(const SubroutineDecNode& node) {
-        symbolTable.startSubroutineFromHistory(node.name);
+    void CodeGenerator::compileSubroutine(const SubroutineDecNode& node, const int subroutineId) {
+        symbolTable.enterSubroutine(subroutineId);
 
         // Write Function Declaration
-        const std::string funcName=std::string(currentClassName) + "." + std::string(node.name);
         const int nLocals = symbolTable.varCount(SymbolKind::LCL);
-        writer.writeFunction(funcName, nLocals);
+        // The registry already holds "Class.name"; no need to build it again.
+        writer.writeFunction(registry.getSignature(currentClassName, node.name).qualifiedName, nLocals);
 
         // Handle Constructor/Method specific setup
         if (node.subType == SubroutineType::CONSTRUCTOR) {
@@ -48,7 +72,7 @@ namespace nand2tetris::jack {
     }
 
 
-    void CodeGenerator::compileStatements(const std::vector<std::unique_ptr<StatementNode>> &stmts) {
+    void CodeGenerator::compileStatements(const ArenaList<StatementNode*> &stmts) {
         for (const auto& stmt : stmts) {
             switch (stmt->getType()) {
                 case ASTNodeType::LET_STATEMENT: compileLet(static_cast<const LetStatementNode&>(*stmt));break; // NOLINT(*-pro-type-static-cast-downcast)
@@ -62,6 +86,9 @@ namespace nand2tetris::jack {
     }
 
     void CodeGenerator::compileDo(const DoStatementNode& node) {
+        // An inlined body leaves nothing on the stack when its result is unused.
+        if (options.inliner && compileInlined(*node.callExpression, false)) return;
+
         // 'do' statements execute a subroutine for side effects.
         // The return value is pushed onto the stack, so we must pop it to keep the stack clean.
         compileSubroutineCall(*node.callExpression);
@@ -128,8 +155,20 @@ namespace nand2tetris::jack {
     }
 
     void CodeGenerator::compileWhile(const WhileStatementNode& node) {
-        const std::string labelExp = getUniqueLabel();
-        const std::string labelEnd = getUniqueLabel();
+        const int labelExp = getUniqueLabel();
+        const int labelEnd = getUniqueLabel();
+
+        if (options.optimizationLevel > 0) {
+            // Test at the bottom: one jump per iteration instead of two, and no 'not'.
+            const int labelBody = labelEnd;
+            writer.writeGoto(labelExp);
+            writer.writeLabel(labelBody);
+            compileStatements(node.body);
+            writer.writeLabel(labelExp);
+            compileExpression(*node.condition);
+            writer.writeIf(labelBody);
+            return;
+        }
 
         writer.writeLabel(labelExp);
 
@@ -145,8 +184,21 @@ namespace nand2tetris::jack {
     }
 
     void CodeGenerator::compileIf(const IfStatementNode& node) {
-        const std::string labelElse = getUniqueLabel();
-        const std::string labelEnd = getUniqueLabel();
+        const int labelElse = getUniqueLabel();
+        const int labelEnd = getUniqueLabel();
+
+        if (options.optimizationLevel > 0 && !node.elseStatements.empty()) {
+            // Jump on the condition itself and put the else branch first, which saves the 'not'.
+            const int labelThen = labelElse;
+            compileExpression(*node.condition);
+            writer.writeIf(labelThen);
+            compileStatements(node.elseStatements);
+            writer.writeGoto(labelEnd);
+            writer.writeLabel(labelThen);
+            compileStatements(node.ifStatements);
+            writer.writeLabel(labelEnd);
+            return;
+        }
 
         // Evaluate condition
         compileExpression(*node.condition);
@@ -164,25 +216,22 @@ namespace nand2tetris::jack {
     }
 
     void CodeGenerator::compileExpression(const ExpressionNode &node) {
+        if (options.optimizationLevel > 0) {
+            if (const std::optional<int> value = ConstantFolder::fold(node)) {
+                writer.writePush(Segment::CONST, *value); // The writer prints negative constants itself.
+                return;
+            }
+        }
+
         if (node.getType()==ASTNodeType::BINARY_OP) {
             const auto& bin = static_cast<const BinaryOpNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+            if (options.strengthReduction && (bin.op == '*' || bin.op == '/') && compileStrengthReduced(bin)) return;
             compileExpression(*bin.left);
             compileExpression(*bin.right);
-            switch(bin.op) {
-                case '+': writer.writeArithmetic(Command::ADD); break;
-                case '-': writer.writeArithmetic(Command::SUB); break;
-                case '*': writer.writeCall("Math.multiply", 2); break;
-                case '/': writer.writeCall("Math.divide", 2); break;
-                case '&': writer.writeArithmetic(Command::AND); break;
-                case '|': writer.writeArithmetic(Command::OR); break;
-                case '<': writer.writeArithmetic(Command::LT); break;
-                case '>': writer.writeArithmetic(Command::GT); break;
-                case '=': writer.writeArithmetic(Command::EQ); break;
-                default: break;
-            }
+            writeBinaryOp(bin.op);
         }else if (node.getType()==ASTNodeType::UNARY_OP) {
             const auto& un = static_cast<const UnaryOpNode&>(node);// NOLINT(*-pro-type-static-cast-downcast)
-            compileTerm(*un.term); // Evaluate term first
+            compileExpression(*un.term); // Evaluate the operand first (it may be a parenthesized expression)
 
             if (un.op == '-') writer.writeArithmetic(Command::NEG);
             else if (un.op == '~') writer.writeArithmetic(Command::NOT);
@@ -200,7 +249,12 @@ namespace nand2tetris::jack {
             }
             case ASTNodeType::STRING_LITERAL:{
                 auto& n = static_cast<const StringLiteralNode&>(node);// NOLINT(*-pro-type-static-cast-downcast)
-                writer.writeStringConstant(n.value);
+                const SymbolId pooled = options.stringPool ? options.stringPool->accessorOf(n.value) : NO_SYMBOL;
+                if (pooled != NO_SYMBOL) {
+                    writer.writeCall(pooled, 0);
+                } else {
+                    writer.writeStringConstant(n.value);
+                }
                 break;
             }
             case ASTNodeType::KEYWORD_LITERAL: {
@@ -242,22 +296,62 @@ namespace nand2tetris::jack {
                 break;
             }
             case ASTNodeType::SUBROUTINE_CALL: {
-                compileSubroutineCall(static_cast<const CallNode&>(node));// NOLINT(*-pro-type-static-cast-downcast)
+                const auto& call = static_cast<const CallNode&>(node);// NOLINT(*-pro-type-static-cast-downcast)
+                if (!options.inliner || !compileInlined(call, true)) compileSubroutineCall(call);
                 break;
             }
             default:break;
         }
     }
 
+    void CodeGenerator::writeBinaryOp(const char op) {
+        switch(op) {
+            case '+': writer.writeArithmetic(Command::ADD); break;
+            case '-': writer.writeArithmetic(Command::SUB); break;
+            case '*': writer.writeCall("Math.multiply", 2); break;
+            case '/': writer.writeCall("Math.divide", 2); break;
+            case '&': writer.writeArithmetic(Command::AND); break;
+            case '|': writer.writeArithmetic(Command::OR); break;
+            case '<': writer.writeArithmetic(Command::LT); break;
+            case '>': writer.writeArithmetic(Command::GT); break;
+            case '=': writer.writeArithmetic(Command::EQ); break;
+            default: break;
+        }
+    }
+
+    bool CodeGenerator::compileStrengthReduced(const BinaryOpNode &node) {
+        const std::optional<int> right = ConstantFolder::fold(*node.right);
+        if (node.op == '/') {
+            if (!right || !StrengthReducer::reducesDivide(*right)) return false;
+            compileExpression(*node.left);
+            const int firstLabel = labelCounter;
+            labelCounter += StrengthReducer::DIVIDE_LABELS;
+            StrengthReducer::writeDivide(writer, *right, firstLabel);
+            return true;
+        }
+
+        // '*' commutes, and the constant side has nothing to evaluate.
+        const std::optional<int> factor = right ? right : ConstantFolder::fold(*node.left);
+        if (!factor || !StrengthReducer::reducesMultiply(*factor)) return false;
+        const ExpressionNode& operand = right ? *node.left : *node.right;
+        if (*factor == 0 && StrengthReducer::isPure(operand)) {
+            writer.writePush(Segment::CONST, 0);
+            return true;
+        }
+        compileExpression(operand);
+        StrengthReducer::writeMultiply(writer, *factor);
+        return true;
+    }
+
 
     void CodeGenerator::compileSubroutineCall(const CallNode &node) {
         int nArgs=0;
-        std::string funcName = std::string(node.functionName);
+        SymbolId calleeClass = NO_SYMBOL; // The callee is always calleeClass.functionName.
 
-        if (node.classNameOrVar.empty()) {
+        if (node.classNameOrVar == NO_SYMBOL) {
             // Implicit 'this' call: foo() -> Class.foo(this)
             writer.writePush(Segment::POINTER, 0); // Push 'this'
-            funcName = std::string(currentClassName) + "." + funcName;
+            calleeClass = currentClassName;
             nArgs = 1;
         }else {
             // Check if classNameOrVar is a variable (instance call) or a class (static call)
@@ -265,7 +359,7 @@ namespace nand2tetris::jack {
                 // It is a variable: a.foo() -> ClassOfA.foo(a)
                 const SymbolKind kind = symbolTable.kindOf(node.classNameOrVar);
                 const int index = symbolTable.indexOf(node.classNameOrVar);
-                const std::string type = std::string(symbolTable.typeOf(node.classNameOrVar));
+                const SymbolId type = symbolTable.typeOf(node.classNameOrVar);
                 Segment seg;
                 switch(kind) {
                     case SymbolKind::STATIC: seg = Segment::STATIC; break;
@@ -274,11 +368,11 @@ namespace nand2tetris::jack {
                     default: seg = Segment::LOCAL; break;
                 }
                 writer.writePush(seg, index); // Push the object instance
-                funcName = type + "." + funcName;
+                calleeClass = type;
                 nArgs = 1;
             }else {
                 // It is a class: Math.abs() -> Math.abs()
-                funcName = std::string(node.classNameOrVar) + "." + funcName;
+                calleeClass = node.classNameOrVar;
                 nArgs = 0;
             }
 
@@ -290,6 +384,156 @@ namespace nand2tetris::jack {
             nArgs++;
         }
 
-        writer.writeCall(funcName, nArgs);
+        // The analyser has verified the callee exists, so its signature (and interned name) is there.
+        writer.writeCall(registry.getSignature(calleeClass, node.functionName).qualifiedName, nArgs);
+    }
+
+    bool CodeGenerator::compileInlined(const CallNode &node, const bool valueUsed) {
+        // Same resolution as compileSubroutineCall.
+        const bool implicitThis = node.classNameOrVar == NO_SYMBOL;
+        const SymbolKind receiverKind = implicitThis ? SymbolKind::NONE : symbolTable.kindOf(node.classNameOrVar);
+        const bool instanceCall = implicitThis || receiverKind != SymbolKind::NONE;
+        const SymbolId calleeClass = implicitThis ? currentClassName
+                                   : instanceCall ? symbolTable.typeOf(node.classNameOrVar) : node.classNameOrVar;
+
+        const InlineCandidate* callee =
+            options.inliner->find(registry.getSignature(calleeClass, node.functionName).qualifiedName);
+        if (!callee || callee->isMethod != instanceCall ||
+            static_cast<int>(node.arguments.size()) != static_cast<int>(callee->subroutine->parameters.size()) ||
+            (callee->usesStatics && calleeClass != currentClassName)) {
+            return false;
+        }
+
+        // The receiver (unless it is this object) and the arguments go into temp slots, in the
+        // order a call would push them, so side effects happen in the same order too. A body that
+        // indexes no array leaves THAT alone, so the receiver can simply stay in pointer 1.
+        const bool receiverIsThis = implicitThis;
+        const bool receiverInThat = instanceCall && !receiverIsThis && !callee->usesArrays;
+        const int firstArgSlot = Inliner::FIRST_SLOT + (instanceCall && !receiverIsThis && !receiverInThat ? 1 : 0);
+        if (instanceCall && !receiverIsThis) {
+            Segment seg;
+            switch(receiverKind) {
+                case SymbolKind::STATIC: seg = Segment::STATIC; break;
+                case SymbolKind::FIELD:  seg = Segment::THIS;   break;
+                case SymbolKind::ARG:    seg = Segment::ARG;    break;
+                default: seg = Segment::LOCAL; break;
+            }
+            writer.writePush(seg, symbolTable.indexOf(node.classNameOrVar));
+        }
+        for (const auto& arg : node.arguments) compileExpression(*arg);
+        for (int slot = firstArgSlot + static_cast<int>(node.arguments.size()) - 1; slot >= Inliner::FIRST_SLOT; --slot) {
+            writer.writePop(Segment::TEMP, slot);
+        }
+        if (receiverInThat) writer.writePop(Segment::POINTER, 1);
+
+        const InlineFrame frame{*callee, receiverIsThis, receiverInThat, firstArgSlot};
+        const auto& stmts = callee->subroutine->statements;
+        for (std::size_t i = 0; i + 1 < stmts.size(); ++i) {
+            const auto& let = static_cast<const LetStatementNode&>(*stmts[i]); // NOLINT(*-pro-type-static-cast-downcast)
+            const InlineBinding& target = callee->names.at(let.varName);
+            if (let.indexExpr) {
+                compileInlineVariable(target, frame, false);
+                compileInlineExpression(*let.indexExpr, frame);
+                writer.writeArithmetic(Command::ADD);
+                compileInlineExpression(*let.valueExpr, frame);
+                writer.writePop(Segment::TEMP, 0);
+                writer.writePop(Segment::POINTER, 1);
+                writer.writePush(Segment::TEMP, 0);
+                writer.writePop(Segment::THAT, 0);
+            } else {
+                compileInlineExpression(*let.valueExpr, frame);
+                compileInlineVariable(target, frame, true);
+            }
+        }
+        // Bodies make no calls, so an unused result has no side effects to keep.
+        if (valueUsed) {
+            const auto& ret = static_cast<const ReturnStatementNode&>(*stmts[stmts.size() - 1]); // NOLINT(*-pro-type-static-cast-downcast)
+            if (ret.expression) compileInlineExpression(*ret.expression, frame);
+            else writer.writePush(Segment::CONST, 0);
+        }
+
+        callee->sites.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void CodeGenerator::compileInlineExpression(const ExpressionNode &node, const InlineFrame &frame) {
+        if (options.optimizationLevel > 0) {
+            if (const std::optional<int> value = ConstantFolder::fold(node)) {
+                writer.writePush(Segment::CONST, *value);
+                return;
+            }
+        }
+
+        switch (node.getType()) {
+            case ASTNodeType::BINARY_OP: {
+                const auto& bin = static_cast<const BinaryOpNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                compileInlineExpression(*bin.left, frame);
+                compileInlineExpression(*bin.right, frame);
+                writeBinaryOp(bin.op);
+                break;
+            }
+            case ASTNodeType::UNARY_OP: {
+                const auto& un = static_cast<const UnaryOpNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                compileInlineExpression(*un.term, frame);
+                writer.writeArithmetic(un.op == '-' ? Command::NEG : Command::NOT);
+                break;
+            }
+            case ASTNodeType::KEYWORD_LITERAL: {
+                const auto& n = static_cast<const KeywordLiteralNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                if (n.value != Keyword::THIS_) {
+                    compileTerm(node); // Constants mean the same in any frame.
+                } else if (frame.receiverIsThis) {
+                    writer.writePush(Segment::POINTER, 0);
+                } else if (frame.receiverInThat) {
+                    writer.writePush(Segment::POINTER, 1);
+                } else {
+                    writer.writePush(Segment::TEMP, Inliner::FIRST_SLOT);
+                }
+                break;
+            }
+            case ASTNodeType::IDENTIFIER: {
+                const auto& n = static_cast<const IdentifierNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                compileInlineVariable(frame.callee.names.at(n.name), frame, false);
+                if (n.indexExpr) {
+                    compileInlineExpression(*n.indexExpr, frame);
+                    writer.writeArithmetic(Command::ADD);
+                    writer.writePop(Segment::POINTER, 1);
+                    writer.writePush(Segment::THAT, 0);
+                }
+                break;
+            }
+            default:
+                compileTerm(node); // Integer constants; the Inliner admits nothing else.
+                break;
+        }
+    }
+
+    void CodeGenerator::compileInlineVariable(const InlineBinding &binding, const InlineFrame &frame, const bool store) {
+        const auto access = [&](const Segment seg, const int index) {
+            if (store) writer.writePop(seg, index);
+            else writer.writePush(seg, index);
+        };
+        switch (binding.kind) {
+            case SymbolKind::ARG:
+                access(Segment::TEMP, frame.firstArgSlot + binding.index);
+                break;
+            case SymbolKind::STATIC:
+                access(Segment::STATIC, binding.index); // Only inlined into its own class.
+                break;
+            case SymbolKind::FIELD:
+                if (frame.receiverIsThis) {
+                    access(Segment::THIS, binding.index);
+                } else if (frame.receiverInThat) {
+                    access(Segment::THAT, binding.index);
+                } else {
+                    // Another object's field, through THAT (never live across an expression).
+                    writer.writePush(Segment::TEMP, Inliner::FIRST_SLOT);
+                    writer.writePop(Segment::POINTER, 1);
+                    access(Segment::THAT, binding.index);
+                }
+                break;
+            default:
+                break;
+        }
     }
 }
@@ -4,13 +4,32 @@
 
 #ifndef NAND2TETRIS_CODE_GENERATOR_H
 #define NAND2TETRIS_CODE_GENERATOR_H
+#include <unordered_set>
 #include "../Parser/AST.h"
 #include "../SemanticAnalyser/GlobalRegistry.h"
 #include "../SemanticAnalyser/SymbolTable.h"
 #include "../VMWriter/VMWriter.h"
+#include "../Optimizer/StringPool.h"
+#include "../Optimizer/Inliner.h"
 
 namespace nand2tetris::jack {
 
+    /**
+     * @brief Options that change the generated code (and so belong in the build cache's config key).
+     */
+    struct CodeGenOptions {
+        /// 0: direct translation. 1 (-O1): constant folding, branch inversion and the VM peephole pass.
+        int optimizationLevel = 0;
+        /// --tree-shake: compile only these subroutines (qualified names, see TreeShaker); nullptr = all.
+        const std::unordered_set<SymbolId>* reachable = nullptr;
+        /// --string-pool: string literals become calls to this pool's accessors; nullptr = built in place.
+        const StringPool* stringPool = nullptr;
+        /// --inline: calls to its candidates are expanded in place; nullptr = every call is a call.
+        const Inliner* inliner = nullptr;
+        /// --strength-reduce (on by default at -O1): '*' and '/' by a constant without Math calls.
+        bool strengthReduction = false;
+    };
+
     /**
      * @brief Generates VM code from the Abstract Syntax Tree (AST).
      *
@@ -23,29 +42,48 @@ namespace nand2tetris::jack {
              * @brief Constructs a CodeGenerator.
              *
              * @param registry The global registry containing class and method signatures.
-             * @param out The output stream to write VM code to.
+             * @param sink Where the finished VM code is written (file, memory, socket...).
              * @param table Symbol table for code generation
+             * @param options Optimization settings.
              */
-            CodeGenerator(const GlobalRegistry& registry, std::ostream& out,SymbolTable& table);
+            CodeGenerator(const GlobalRegistry& registry, VMSink& sink,SymbolTable& table, const CodeGenOptions& options = {});
+
+            /**
+             * @brief Constructs a CodeGenerator that hands over the VMCode of each class instead of text.
+             */
+            CodeGenerator(const GlobalRegistry& registry, VMCodeSink& sink,SymbolTable& table, const CodeGenOptions& options = {});
 
             /**
              * @brief Compiles a class node into VM code.
              *
+             * The output is buffered and written to the sink once, when the class is complete.
+             *
              * @param node The root node of the class AST.
              */
             void compileClass(const ClassNode& node);
+
+            /**
+             * @brief Total bytes of VM code produced so far.
+             */
+            std::size_t getBytesEmitted() const { return writer.getBytesEmitted(); }
+
+            /**
+             * @brief VM commands removed by the peephole pass (always 0 below -O1).
+             */
+            std::size_t getInstructionsRemoved() const { return writer.getInstructionsRemoved(); }
         private:
             const GlobalRegistry& registry; ///< Reference to the global registry.
             VMWriter writer;                ///< Helper to write VM commands.
             SymbolTable& symbolTable;        ///< Symbol table for variable resolution.
-            std::string_view currentClassName; ///< Name of the class currently being compiled.
+            const CodeGenOptions options;   ///< Optimization settings.
+            SymbolId currentClassName = NO_SYMBOL; ///< Name of the class currently being compiled.
             int labelCounter = 0;           ///< Counter for generating unique labels.
 
             /**
-             * @brief Generates a unique label string.
-             * @return A unique label (e.g., "L1", "L2").
+             * @brief Generates a unique label id.
+             * @return A unique id; VMWriter writes it as "L<id>" (e.g., "L1", "L2").
              */
-            std::string getUniqueLabel();
+            int getUniqueLabel();
 
             /**
              * @brief Compiles a subroutine declaration.
@@ -54,15 +92,16 @@ namespace nand2tetris::jack {
              * and compiles the body statements.
              *
              * @param node The subroutine declaration node.
+             * @param subroutineId Its position in the class, which is its symbol-table scope id.
              */
-            void compileSubroutine(const SubroutineDecNode& node);
+            void compileSubroutine(const SubroutineDecNode& node, int subroutineId);
 
             /**
              * @brief Compiles a list of statements.
              *
-             * @param stmts The vector of statement nodes.
+             * @param stmts The list of statement nodes.
              */
-            void compileStatements(const std::vector<std::unique_ptr<StatementNode>>& stmts);
+            void compileStatements(const ArenaList<StatementNode*>& stmts);
 
             /**
              * @brief Compiles a 'do' statement.
@@ -112,7 +151,8 @@ namespace nand2tetris::jack {
             /**
              * @brief Compiles an expression.
              *
-             * Handles binary operations and delegates to compileTerm.
+             * Handles binary operations and delegates to compileTerm. At -O1, constant subtrees are
+             * replaced by their value.
              *
              * @param node The expression node.
              */
@@ -133,6 +173,46 @@ namespace nand2tetris::jack {
              * @param node The call node.
              */
             void compileSubroutineCall(const CallNode& node);
+
+            /**
+             * @brief Writes the VM command for a binary operator whose operands are on the stack.
+             */
+            void writeBinaryOp(char op);
+
+            /**
+             * @brief Compiles 'x * c', 'c * x' or 'x / c' inline if StrengthReducer can (see there).
+             *
+             * @return false if the operator has to call Math.multiply / Math.divide.
+             */
+            bool compileStrengthReduced(const BinaryOpNode& node);
+
+            /**
+             * @brief The inlined call's receiver and arguments, as seen from its expanded body.
+             */
+            struct InlineFrame {
+                const InlineCandidate& callee;
+                bool receiverIsThis; ///< Implicit 'this' call: the fields are this caller's own.
+                bool receiverInThat; ///< The receiver is in pointer 1 for the whole body (no array access).
+                int firstArgSlot;    ///< temp index of the first argument (the receiver is just below, if not in THAT).
+            };
+
+            /**
+             * @brief Expands the call in place if options.inliner allows it (see Inliner).
+             *
+             * @param valueUsed false for a 'do' statement: the result is then not pushed at all.
+             * @return false if the call has to be compiled as a call.
+             */
+            bool compileInlined(const CallNode& node, bool valueUsed);
+
+            /**
+             * @brief compileExpression for an expression of an inlined body.
+             */
+            void compileInlineExpression(const ExpressionNode& node, const InlineFrame& frame);
+
+            /**
+             * @brief Pushes (or, with 'store', pops into) a variable of an inlined body.
+             */
+            void compileInlineVariable(const InlineBinding& binding, const InlineFrame& frame, bool store);
     };
 
 
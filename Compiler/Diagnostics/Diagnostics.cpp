@@ -0,0 +1,128 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "Diagnostics.h"
+#include <algorithm>
+#include <set>
+#include <tuple>
+
+namespace nand2tetris::jack {
+
+    namespace {
+        void writeJsonString(std::ostream& out, const std::string_view s) {
+            out << '"';
+            for (const char c : s) {
+                switch (c) {
+                    case '"':  out << "\\\""; break;
+                    case '\\': out << "\\\\"; break; // Windows paths
+                    case '\n': out << "\\n"; break;
+                    case '\t': out << "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) out << ' ';
+                        else out << c;
+                }
+            }
+            out << '"';
+        }
+
+        // SARIF wants URIs: forward slashes, even on Windows.
+        std::string toUri(std::string path) {
+            std::replace(path.begin(), path.end(), '\\', '/');
+            return path;
+        }
+    }
+
+    std::string_view phaseName(const DiagnosticPhase phase) {
+        switch (phase) {
+            case DiagnosticPhase::LEXICAL: return "lexical";
+            case DiagnosticPhase::SYNTAX:  return "syntax";
+            case DiagnosticPhase::SEMANTIC: return "semantic";
+        }
+        return "syntax";
+    }
+
+    bool Diagnostics::add(Diagnostic diagnostic) {
+        if (reported.fetch_add(1, std::memory_order_relaxed) >= maxErrors && maxErrors != 0) return false;
+        std::scoped_lock lock(mtx);
+        collected.push_back(std::move(diagnostic));
+        return true;
+    }
+
+    std::size_t Diagnostics::size() const {
+        std::scoped_lock lock(mtx);
+        return collected.size();
+    }
+
+    void Diagnostics::write(std::ostream &out, const DiagnosticFormat format) const {
+        std::vector<Diagnostic> sorted;
+        {
+            std::scoped_lock lock(mtx);
+            sorted = collected;
+        }
+        // Units finish in any order; the report should not.
+        std::sort(sorted.begin(), sorted.end(), [](const Diagnostic& a, const Diagnostic& b) {
+            return std::tie(a.file, a.line, a.column, a.message) < std::tie(b.file, b.line, b.column, b.message);
+        });
+        const bool truncated = limitReached(); // The units still running gave up there.
+
+        if (format == DiagnosticFormat::TEXT) {
+            std::set<std::string_view> files;
+            for (const Diagnostic& d : sorted) {
+                out << d.file << ":" << d.line << ":" << d.column << ": " << phaseName(d.phase) << " error: "
+                    << d.message << "\n";
+                files.insert(d.file);
+            }
+            out << sorted.size() << (sorted.size() == 1 ? " error" : " errors") << " in " << files.size()
+                << (files.size() == 1 ? " file" : " files");
+            if (truncated) out << " (stopped at --max-errors " << maxErrors << ")";
+            out << std::endl;
+            return;
+        }
+
+        if (format == DiagnosticFormat::JSON) {
+            out << "{\"errors\":" << sorted.size() << ",\"truncated\":" << (truncated ? "true" : "false")
+                << ",\"diagnostics\":[";
+            for (std::size_t i = 0; i < sorted.size(); ++i) {
+                const Diagnostic& d = sorted[i];
+                out << (i ? ",\n" : "\n") << "{\"file\":";
+                writeJsonString(out, d.file);
+                out << ",\"line\":" << d.line << ",\"column\":" << d.column << ",\"phase\":\"" << phaseName(d.phase)
+                    << "\",\"severity\":\"error\",\"message\":";
+                writeJsonString(out, d.message);
+                out << "}";
+            }
+            out << "\n]}" << std::endl;
+            return;
+        }
+
+        // SARIF 2.1.0: one run, one rule per phase.
+        out << "{\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\",\"version\":\"2.1.0\",\"runs\":[{"
+            << "\"tool\":{\"driver\":{\"name\":\"JackCompiler\",\"rules\":["
+            << "{\"id\":\"lexical\",\"shortDescription\":{\"text\":\"Lexical error\"}},"
+            << "{\"id\":\"syntax\",\"shortDescription\":{\"text\":\"Syntax error\"}},"
+            << "{\"id\":\"semantic\",\"shortDescription\":{\"text\":\"Semantic error\"}}]}},"
+            << "\"results\":[";
+        for (std::size_t i = 0; i < sorted.size(); ++i) {
+            const Diagnostic& d = sorted[i];
+            out << (i ? ",\n" : "\n") << "{\"ruleId\":\"" << phaseName(d.phase) << "\",\"level\":\"error\",\"message\":{\"text\":";
+            writeJsonString(out, d.message);
+            out << "},\"locations\":[{\"physicalLocation\":{\"artifactLocation\":{\"uri\":";
+            writeJsonString(out, toUri(d.file));
+            out << "},\"region\":{\"startLine\":" << std::max(d.line, 1) << ",\"startColumn\":" << std::max(d.column, 1)
+                << "}}}]}";
+        }
+        out << "\n]";
+        if (truncated) {
+            out << ",\"invocations\":[{\"executionSuccessful\":false,\"toolExecutionNotifications\":[{\"level\":\"note\","
+                << "\"message\":{\"text\":\"Stopped at --max-errors " << maxErrors << "\"}}]}]";
+        }
+        out << "}]}" << std::endl;
+    }
+
+    void DiagnosticSink::report(Diagnostic diagnostic) {
+        if (diagnostic.file.empty()) diagnostic.file = file;
+        ++errors;
+        if (!build.add(std::move(diagnostic)) || build.limitReached()) throw CompilationStopped{};
+    }
+}
@@ -0,0 +1,139 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_DIAGNOSTICS_H
+#define NAND2TETRIS_DIAGNOSTICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief The compiler stage that found an error.
+     */
+    enum class DiagnosticPhase { LEXICAL, SYNTAX, SEMANTIC };
+
+    /**
+     * @brief "lexical", "syntax" or "semantic" (the rule id in JSON / SARIF output).
+     */
+    std::string_view phaseName(DiagnosticPhase phase);
+
+    /**
+     * @brief One error, with its location as separate fields.
+     */
+    struct Diagnostic {
+        std::string file;    ///< Source path. The sink fills it in when the reporter does not know it.
+        int line = 0;
+        int column = 0;
+        DiagnosticPhase phase = DiagnosticPhase::SYNTAX;
+        std::string message; ///< Without the location prefix.
+    };
+
+    /**
+     * @brief The exception every user-facing compile error is thrown as.
+     *
+     * what() is the full one-line message, as it always was; getDiagnostic() has the same
+     * error in pieces, for a DiagnosticSink to collect.
+     */
+    class CompilationError : public std::runtime_error {
+        public:
+            CompilationError(Diagnostic diagnostic, const std::string& what)
+                : std::runtime_error(what), diagnostic(std::move(diagnostic)) {}
+
+            const Diagnostic& getDiagnostic() const { return diagnostic; }
+        private:
+            Diagnostic diagnostic;
+    };
+
+    /**
+     * @brief Thrown to abandon a unit: the build reached its error limit, or the Parser could not
+     *        find a place to resume. Whatever was found up to there is already collected.
+     */
+    struct CompilationStopped {};
+
+    /**
+     * @brief How Diagnostics::write() prints the errors.
+     */
+    enum class DiagnosticFormat {
+        TEXT,  ///< file:line:column: phase error: message, one per line.
+        JSON,  ///< {"errors": N, "truncated": bool, "diagnostics": [...]}
+        SARIF  ///< SARIF 2.1.0, for code-scanning tools.
+    };
+
+    /**
+     * @brief Every error of one build, from all units (thread-safe).
+     */
+    class Diagnostics {
+        public:
+            /**
+             * @param maxErrors Stop once this many errors are collected; 0 = no limit.
+             */
+            explicit Diagnostics(std::size_t maxErrors = 0) : maxErrors(maxErrors) {}
+
+            /**
+             * @brief Number of errors collected (at most the limit).
+             */
+            std::size_t size() const;
+
+            /**
+             * @brief True once the limit is reached: pending work should not start.
+             */
+            bool limitReached() const { return maxErrors != 0 && reported.load(std::memory_order_relaxed) >= maxErrors; }
+
+            /**
+             * @brief Writes the errors sorted by file, line and column.
+             */
+            void write(std::ostream& out, DiagnosticFormat format) const;
+
+        private:
+            friend class DiagnosticSink;
+
+            /**
+             * @brief Adds one error.
+             *
+             * @return false if it was over the limit (and so dropped).
+             */
+            bool add(Diagnostic diagnostic);
+
+            const std::size_t maxErrors;
+            std::atomic<std::size_t> reported{0}; ///< Including dropped ones.
+            mutable std::mutex mtx;               ///< Guards 'collected'.
+            std::vector<Diagnostic> collected;
+    };
+
+    /**
+     * @brief Where the Tokenizer, Parser and SemanticAnalyser of one unit report errors they can
+     *        recover from. Used by one thread at a time.
+     */
+    class DiagnosticSink {
+        public:
+            DiagnosticSink(Diagnostics& build, std::string file) : build(build), file(std::move(file)) {}
+
+            /**
+             * @brief Collects an error.
+             *
+             * @throws CompilationStopped if the build has reached its error limit.
+             */
+            void report(Diagnostic diagnostic);
+
+            /**
+             * @brief Whether this unit has reported anything (its output must not be generated).
+             */
+            bool hasErrors() const { return errors > 0; }
+
+        private:
+            Diagnostics& build;
+            const std::string file;
+            std::size_t errors = 0;
+    };
+}
+
+#endif //NAND2TETRIS_DIAGNOSTICS_H
@@ -0,0 +1,76 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "DirectoryWalker.h"
+#include <stdexcept>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace nand2tetris::jack {
+
+    DirectoryWalker::DirectoryWalker(ThreadPool &pool, FileFound onFile) : pool(pool), onFile(std::move(onFile)) {}
+
+    DirectoryWalker::~DirectoryWalker() {
+        // The tasks still queued or running refer to this walker.
+        waitIdle();
+    }
+
+    void DirectoryWalker::walk(const std::string &root) {
+        // Paths below an absolute root are absolute already: no fs::absolute per entry.
+        schedule(fs::absolute(root));
+    }
+
+    std::size_t DirectoryWalker::wait() {
+        waitIdle();
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!error.empty()) throw std::runtime_error(error);
+        return found.load();
+    }
+
+    void DirectoryWalker::schedule(fs::path directory) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            ++pending;
+        }
+        pool.submit([this, directory = std::move(directory)] {
+            try {
+                scan(directory);
+            } catch (const std::exception& e) {
+                fail(e.what());
+            }
+            std::lock_guard<std::mutex> lock(mtx);
+            if (--pending == 0) idle.notify_all();
+        });
+    }
+
+    void DirectoryWalker::scan(const fs::path &directory) {
+        std::error_code ec;
+        fs::directory_iterator it(directory, ec);
+        const fs::directory_iterator end;
+        for (; !ec && it != end; it.increment(ec)) {
+            const fs::directory_entry& entry = *it;
+            const fs::path& path = entry.path();
+            // Both come from the listing (d_type), except that is_directory() follows a link.
+            if (entry.is_symlink(ec) ? false : entry.is_directory(ec)) {
+                const std::string name = path.filename().string();
+                if (name.empty() || name[0] != '.') schedule(path);
+            } else if (path.extension() == ".jack") {
+                found.fetch_add(1, std::memory_order_relaxed);
+                onFile(path.string());
+            }
+        }
+        if (ec) fail("Cannot read folder " + directory.string() + ": " + ec.message());
+    }
+
+    void DirectoryWalker::fail(const std::string &message) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (error.empty()) error = "Error: " + message;
+    }
+
+    void DirectoryWalker::waitIdle() {
+        std::unique_lock<std::mutex> lock(mtx);
+        idle.wait(lock, [this] { return pending == 0; });
+    }
+}
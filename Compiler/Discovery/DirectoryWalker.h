@@ -0,0 +1,76 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_DIRECTORY_WALKER_H
+#define NAND2TETRIS_DIRECTORY_WALKER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include "../ThreadPool/ThreadPool.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Finds the .jack files under a set of folders (--recursive), one pool task per folder.
+     *
+     * Sibling folders are read in parallel, and each file is handed to the callback as soon as it
+     * is found, so parsing starts while the rest of the tree is still being listed. Entry types
+     * come from the directory listing itself; the only extra stat is for symbolic links.
+     * Hidden folders (".git", ...) and links to folders are not entered.
+     */
+    class DirectoryWalker {
+        public:
+            /**
+             * @brief Called once per .jack file, with its absolute path, from a pool worker.
+             *
+             * Callbacks for different folders run concurrently.
+             */
+            using FileFound = std::function<void(std::string path)>;
+
+            DirectoryWalker(ThreadPool& pool, FileFound onFile);
+
+            /**
+             * @brief Waits for the folders still being listed (an error may have cut the walk short).
+             */
+            ~DirectoryWalker();
+
+            DirectoryWalker(const DirectoryWalker&) = delete;
+            DirectoryWalker& operator=(const DirectoryWalker&) = delete;
+
+            /**
+             * @brief Starts listing 'root' and every folder below it. Returns immediately.
+             */
+            void walk(const std::string& root);
+
+            /**
+             * @brief Blocks until every folder is listed and every callback has returned.
+             *
+             * @return The number of .jack files found.
+             * @throws std::runtime_error with the first error (an unreadable folder, a failed callback).
+             */
+            std::size_t wait();
+
+        private:
+            ThreadPool& pool;
+            FileFound onFile;
+            std::atomic<std::size_t> found{0};
+
+            std::mutex mtx;
+            std::condition_variable idle; ///< Signalled when 'pending' drops to 0.
+            std::size_t pending = 0;      ///< Folders queued or being listed (guarded by mtx).
+            std::string error;            ///< The first error, if any (guarded by mtx).
+
+            void schedule(std::filesystem::path directory);
+            void scan(const std::filesystem::path& directory);
+            void fail(const std::string& message);
+            void waitIdle();
+    };
+}
+
+#endif //NAND2TETRIS_DIRECTORY_WALKER_H
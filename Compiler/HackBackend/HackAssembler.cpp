@@ -0,0 +1,176 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "HackAssembler.h"
+#include <charconv>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace nand2tetris::jack {
+
+    namespace {
+        constexpr int FIRST_VARIABLE = 16;
+        constexpr int MAX_CONSTANT = 32767; ///< A-instructions carry 15 bits.
+
+        // "a" bit and the six ALU control bits of each computation.
+        const std::unordered_map<std::string_view, const char*>& compTable() {
+            static const std::unordered_map<std::string_view, const char*> table = {
+                {"0", "0101010"}, {"1", "0111111"}, {"-1", "0111010"}, {"D", "0001100"},
+                {"A", "0110000"}, {"!D", "0001101"}, {"!A", "0110001"}, {"-D", "0001111"},
+                {"-A", "0110011"}, {"D+1", "0011111"}, {"A+1", "0110111"}, {"D-1", "0001110"},
+                {"A-1", "0110010"}, {"D+A", "0000010"}, {"D-A", "0010011"}, {"A-D", "0000111"},
+                {"D&A", "0000000"}, {"D|A", "0010101"},
+                {"M", "1110000"}, {"!M", "1110001"}, {"-M", "1110011"}, {"M+1", "1110111"},
+                {"M-1", "1110010"}, {"D+M", "1000010"}, {"D-M", "1010011"}, {"M-D", "1000111"},
+                {"D&M", "1000000"}, {"D|M", "1010101"},
+                // Commutative spellings some assemblers accept.
+                {"A+D", "0000010"}, {"M+D", "1000010"}, {"A&D", "0000000"}, {"M&D", "1000000"},
+                {"A|D", "0010101"}, {"M|D", "1010101"},
+            };
+            return table;
+        }
+
+        const std::unordered_map<std::string_view, const char*>& jumpTable() {
+            static const std::unordered_map<std::string_view, const char*> table = {
+                {"", "000"}, {"JGT", "001"}, {"JEQ", "010"}, {"JGE", "011"},
+                {"JLT", "100"}, {"JNE", "101"}, {"JLE", "110"}, {"JMP", "111"},
+            };
+            return table;
+        }
+
+        std::unordered_map<std::string, int> predefinedSymbols() {
+            std::unordered_map<std::string, int> symbols = {
+                {"SP", 0}, {"LCL", 1}, {"ARG", 2}, {"THIS", 3}, {"THAT", 4},
+                {"SCREEN", 16384}, {"KBD", 24576},
+            };
+            for (int i = 0; i < 16; ++i) symbols.emplace("R" + std::to_string(i), i);
+            return symbols;
+        }
+
+        // One instruction or label per line; whitespace and "//" comments are ignored.
+        std::vector<std::string_view> splitLines(const std::string_view source) {
+            std::vector<std::string_view> lines;
+            std::size_t start = 0;
+            while (start < source.size()) {
+                std::size_t end = source.find('\n', start);
+                if (end == std::string_view::npos) end = source.size();
+                std::string_view line = source.substr(start, end - start);
+                start = end + 1;
+
+                if (const std::size_t comment = line.find("//"); comment != std::string_view::npos) {
+                    line = line.substr(0, comment);
+                }
+                while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) line.remove_prefix(1);
+                while (!line.empty() && (line.back() == ' ' || line.back() == '\t' || line.back() == '\r')) {
+                    line.remove_suffix(1);
+                }
+                if (!line.empty()) lines.push_back(line);
+            }
+            return lines;
+        }
+
+        [[noreturn]] void malformed(const std::string_view line) {
+            throw std::runtime_error("Invalid Hack instruction: '" + std::string(line) + "'");
+        }
+
+        void appendBinary(std::string& out, const int value) {
+            for (int bit = 15; bit >= 0; --bit) out += ((value >> bit) & 1) ? '1' : '0';
+            out += '\n';
+        }
+
+        void appendC(std::string& out, const std::string_view line) {
+            std::string_view rest = line;
+            std::string_view dest;
+            std::string_view jump;
+            if (const std::size_t eq = rest.find('='); eq != std::string_view::npos) {
+                dest = rest.substr(0, eq);
+                rest.remove_prefix(eq + 1);
+            }
+            if (const std::size_t semi = rest.find(';'); semi != std::string_view::npos) {
+                jump = rest.substr(semi + 1);
+                rest = rest.substr(0, semi);
+            }
+
+            const auto comp = compTable().find(rest);
+            const auto jmp = jumpTable().find(jump);
+            if (comp == compTable().end() || jmp == jumpTable().end()) malformed(line);
+
+            char destBits[] = "000"; // A, D, M
+            for (const char c : dest) {
+                switch (c) {
+                    case 'A': destBits[0] = '1'; break;
+                    case 'D': destBits[1] = '1'; break;
+                    case 'M': destBits[2] = '1'; break;
+                    default: malformed(line);
+                }
+            }
+
+            out += "111";
+            out += comp->second;
+            out += destBits;
+            out += jmp->second;
+            out += '\n';
+        }
+    }
+
+    std::size_t HackAssembler::countInstructions(const std::string_view source) {
+        std::size_t count = 0;
+        for (const std::string_view line : splitLines(source)) {
+            if (line.front() != '(') ++count;
+        }
+        return count;
+    }
+
+    std::string HackAssembler::assemble(const std::string_view source) {
+        const std::vector<std::string_view> lines = splitLines(source);
+        std::unordered_map<std::string, int> symbols = predefinedSymbols();
+
+        // Pass 1: labels name the address of the next instruction.
+        std::size_t address = 0;
+        for (const std::string_view line : lines) {
+            if (line.front() != '(') {
+                ++address;
+                continue;
+            }
+            if (line.size() < 3 || line.back() != ')') malformed(line);
+            const std::string name(line.substr(1, line.size() - 2));
+            if (!symbols.emplace(name, static_cast<int>(address)).second) {
+                throw std::runtime_error("Label '" + name + "' is defined more than once");
+            }
+        }
+        if (address > ROM_SIZE) {
+            throw std::runtime_error("Program too large for the Hack ROM: " + std::to_string(address) +
+                " instructions (max " + std::to_string(ROM_SIZE) + ")");
+        }
+
+        // Pass 2: encode.
+        std::string out;
+        out.reserve(address * 17);
+        int nextVariable = FIRST_VARIABLE;
+        for (const std::string_view line : lines) {
+            if (line.front() == '(') continue;
+            if (line.front() != '@') {
+                appendC(out, line);
+                continue;
+            }
+
+            const std::string_view operand = line.substr(1);
+            if (operand.empty()) malformed(line);
+            int value = 0;
+            if (operand.front() >= '0' && operand.front() <= '9') {
+                const auto [ptr, ec] = std::from_chars(operand.data(), operand.data() + operand.size(), value);
+                if (ec != std::errc() || ptr != operand.data() + operand.size() || value > MAX_CONSTANT) {
+                    malformed(line);
+                }
+            } else {
+                const auto [it, inserted] = symbols.emplace(std::string(operand), nextVariable);
+                if (inserted) ++nextVariable;
+                value = it->second;
+            }
+            appendBinary(out, value);
+        }
+        return out;
+    }
+}
@@ -0,0 +1,38 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_HACK_ASSEMBLER_H
+#define NAND2TETRIS_HACK_ASSEMBLER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Assembles Hack assembly into the machine code text the CPU emulator loads (.hack).
+     *
+     * The usual two passes: label addresses first, then one 16-digit binary line per instruction, with
+     * the predefined symbols (SP, LCL, ARG, THIS, THAT, R0-R15, SCREEN, KBD) and variables from RAM[16].
+     */
+    class HackAssembler {
+        public:
+            static constexpr std::size_t ROM_SIZE = 32768;
+
+            /**
+             * @brief Assembles a whole program held in memory.
+             *
+             * @throws std::runtime_error on a malformed line, or if the program does not fit the ROM.
+             */
+            static std::string assemble(std::string_view source);
+
+            /**
+             * @brief Number of instructions (ROM words) in an assembly program, labels and comments aside.
+             */
+            static std::size_t countInstructions(std::string_view source);
+    };
+}
+
+#endif //NAND2TETRIS_HACK_ASSEMBLER_H
@@ -0,0 +1,328 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "HackTranslator.h"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include "../Interner/StringInterner.h"
+
+namespace nand2tetris::jack {
+
+    namespace {
+        // Base pointer of each segment (indexed by Segment), for those addressed through one.
+        constexpr std::string_view SEGMENT_BASES[] = {"", "ARG", "LCL", "", "THIS", "THAT", "", ""};
+
+        constexpr int TEMP_BASE = 5;
+        constexpr int INLINE_OFFSET_LIMIT = 6; ///< Up to here "A=A+1" steps beat computing the address in R13.
+        constexpr int INLINE_LOCALS_LIMIT = 3; ///< Up to here zeroing locals inline beats the loop.
+
+        constexpr std::string_view PUSH_D = "@SP\nAM=M+1\nA=A-1\nM=D\n";
+        constexpr std::string_view POP_D = "@SP\nAM=M-1\nD=M\n";
+
+        // Binary commands: y into D, then combine in place with x (the new top of the stack).
+        constexpr std::string_view BINARY_PREFIX = "@SP\nAM=M-1\nD=M\nA=A-1\n";
+    }
+
+    HackTranslator::HackTranslator(std::string className):currentFunction(className) {
+        unit.className = std::move(className);
+    }
+
+    void HackTranslator::emit(const std::string_view lines) {
+        unit.code.append(lines);
+    }
+
+    void HackTranslator::emitInt(const int value) {
+        unit.code += '@';
+        unit.code += std::to_string(value);
+        unit.code += '\n';
+    }
+
+    std::string HackTranslator::label(const SymbolId name, const int labelId) const {
+        std::string text = currentFunction;
+        text += '$';
+        if (name == NO_SYMBOL) text.append(1, 'L').append(std::to_string(labelId));
+        else text.append(nameOf(name));
+        return text;
+    }
+
+    std::string HackTranslator::nextReturnLabel() {
+        return currentFunction + "$ret." + std::to_string(returnCounter++);
+    }
+
+    void HackTranslator::write(const VMCode &code) {
+        for (std::size_t row = 0; row < code.size(); ++row) {
+            const VMInstruction ins = code[row];
+            switch (ins.op) {
+                case VMOp::PUSH: translatePush(ins.segment, ins.arg); break;
+                case VMOp::POP: translatePop(ins.segment, ins.arg); break;
+                case VMOp::ARITHMETIC: translateArithmetic(ins.command); break;
+                case VMOp::LABEL:
+                    emit("(");
+                    emit(label(ins.name, ins.arg));
+                    emit(")\n");
+                    break;
+                case VMOp::GOTO:
+                    emit("@");
+                    emit(label(ins.name, ins.arg));
+                    emit("\n0;JMP\n");
+                    break;
+                case VMOp::IF_GOTO:
+                    emit(POP_D);
+                    emit("@");
+                    emit(label(ins.name, ins.arg));
+                    emit("\nD;JNE\n");
+                    break;
+                case VMOp::CALL: translateCall(nameOf(ins.name), ins.arg); break;
+                case VMOp::FUNCTION: translateFunction(nameOf(ins.name), ins.arg); break;
+                case VMOp::RETURN: emit("@$$RETURN\n0;JMP\n"); break;
+            }
+        }
+    }
+
+    void HackTranslator::translatePush(const Segment segment, const int index) {
+        switch (segment) {
+            case Segment::CONST:
+                if (index >= -1 && index <= 1) {
+                    // The ALU has these three built in.
+                    emit("@SP\nAM=M+1\nA=A-1\n");
+                    emit(index == 0 ? "M=0\n" : index == 1 ? "M=1\n" : "M=-1\n");
+                    return;
+                }
+                if (index < 0) {
+                    // Optimized code may carry negative constants; D=!A turns ~v back into v.
+                    emitInt(~index);
+                    emit("D=!A\n");
+                } else {
+                    emitInt(index);
+                    emit("D=A\n");
+                }
+                break;
+            case Segment::STATIC:
+                emit("@");
+                emit(unit.className);
+                emit(".");
+                emit(std::to_string(index));
+                emit("\nD=M\n");
+                break;
+            case Segment::POINTER:
+                emit(index == 0 ? "@THIS\nD=M\n" : "@THAT\nD=M\n");
+                break;
+            case Segment::TEMP:
+                emitInt(TEMP_BASE + index);
+                emit("D=M\n");
+                break;
+            default: {
+                const std::string_view base = SEGMENT_BASES[static_cast<std::size_t>(segment)];
+                if (index <= 1) {
+                    emit("@");
+                    emit(base);
+                    emit(index == 0 ? "\nA=M\nD=M\n" : "\nA=M+1\nD=M\n");
+                } else {
+                    emitInt(index);
+                    emit("D=A\n@");
+                    emit(base);
+                    emit("\nA=D+M\nD=M\n");
+                }
+                break;
+            }
+        }
+        emit(PUSH_D);
+    }
+
+    void HackTranslator::translatePop(const Segment segment, const int index) {
+        switch (segment) {
+            case Segment::CONST:
+                throw std::runtime_error("Cannot translate 'pop constant " + std::to_string(index) + "' in " + currentFunction);
+            case Segment::STATIC:
+                emit(POP_D);
+                emit("@");
+                emit(unit.className);
+                emit(".");
+                emit(std::to_string(index));
+                emit("\nM=D\n");
+                return;
+            case Segment::POINTER:
+                emit(POP_D);
+                emit(index == 0 ? "@THIS\nM=D\n" : "@THAT\nM=D\n");
+                return;
+            case Segment::TEMP:
+                emit(POP_D);
+                emitInt(TEMP_BASE + index);
+                emit("M=D\n");
+                return;
+            default: {
+                const std::string_view base = SEGMENT_BASES[static_cast<std::size_t>(segment)];
+                if (index <= INLINE_OFFSET_LIMIT) {
+                    emit(POP_D);
+                    emit("@");
+                    emit(base);
+                    emit("\nA=M\n");
+                    for (int i = 0; i < index; ++i) emit("A=A+1\n");
+                    emit("M=D\n");
+                } else {
+                    // The target address has to be computed before D is needed for the value.
+                    emitInt(index);
+                    emit("D=A\n@");
+                    emit(base);
+                    emit("\nD=D+M\n@R13\nM=D\n");
+                    emit(POP_D);
+                    emit("@R13\nA=M\nM=D\n");
+                }
+                return;
+            }
+        }
+    }
+
+    void HackTranslator::translateArithmetic(const Command command) {
+        switch (command) {
+            case Command::ADD: emit(BINARY_PREFIX); emit("M=D+M\n"); return;
+            case Command::SUB: emit(BINARY_PREFIX); emit("M=M-D\n"); return;
+            case Command::AND: emit(BINARY_PREFIX); emit("M=D&M\n"); return;
+            case Command::OR:  emit(BINARY_PREFIX); emit("M=D|M\n"); return;
+            case Command::NEG: emit("@SP\nA=M-1\nM=-M\n"); return;
+            case Command::NOT: emit("@SP\nA=M-1\nM=!M\n"); return;
+            case Command::EQ:
+            case Command::GT:
+            case Command::LT: {
+                // The shared routine returns through R15.
+                const std::string ret = nextReturnLabel();
+                emit("@");
+                emit(ret);
+                emit("\nD=A\n");
+                emit(command == Command::EQ ? "@$$EQ\n" : command == Command::GT ? "@$$GT\n" : "@$$LT\n");
+                emit("0;JMP\n(");
+                emit(ret);
+                emit(")\n");
+                return;
+            }
+        }
+    }
+
+    void HackTranslator::translateCall(const std::string_view target, const int nArgs) {
+        // $$CALL expects nArgs in R13, the target in R14 and the return address in D.
+        const std::string ret = nextReturnLabel();
+        emitInt(nArgs);
+        emit("D=A\n@R13\nM=D\n@");
+        emit(target);
+        emit("\nD=A\n@R14\nM=D\n@");
+        emit(ret);
+        emit("\nD=A\n@$$CALL\n0;JMP\n(");
+        emit(ret);
+        emit(")\n");
+        unit.calls.emplace_back(target);
+    }
+
+    void HackTranslator::translateFunction(const std::string_view name, const int nLocals) {
+        currentFunction = name;
+        returnCounter = 0;
+        unit.functions.emplace_back(name);
+        emit("(");
+        emit(name);
+        emit(")\n");
+
+        if (nLocals <= INLINE_LOCALS_LIMIT) {
+            for (int i = 0; i < nLocals; ++i) emit("@SP\nAM=M+1\nA=A-1\nM=0\n");
+            return;
+        }
+        emitInt(nLocals);
+        emit("D=A\n(");
+        emit(name);
+        emit("$$init)\n@SP\nAM=M+1\nA=A-1\nM=0\nD=D-1\n@");
+        emit(name);
+        emit("$$init\nD;JGT\n");
+    }
+
+    AsmUnit HackTranslator::take() {
+        std::sort(unit.calls.begin(), unit.calls.end());
+        unit.calls.erase(std::unique(unit.calls.begin(), unit.calls.end()), unit.calls.end());
+        AsmUnit result = std::move(unit);
+        unit = AsmUnit{};
+        unit.className = result.className;
+        currentFunction = result.className;
+        returnCounter = 0;
+        return result;
+    }
+
+    std::string HackTranslator::runtime() {
+        return
+            // Bootstrap.
+            "@256\nD=A\n@SP\nM=D\n"
+            "@R13\nM=0\n@Sys.init\nD=A\n@R14\nM=D\n@$$halt\nD=A\n@$$CALL\n0;JMP\n"
+            "($$halt)\n@$$halt\n0;JMP\n"
+
+            // $$CALL: push the return address (D) and the caller's frame, then ARG = SP-5-nArgs, LCL = SP.
+            "($$CALL)\n" "@SP\nAM=M+1\nA=A-1\nM=D\n"
+            "@LCL\nD=M\n@SP\nAM=M+1\nA=A-1\nM=D\n"
+            "@ARG\nD=M\n@SP\nAM=M+1\nA=A-1\nM=D\n"
+            "@THIS\nD=M\n@SP\nAM=M+1\nA=A-1\nM=D\n"
+            "@THAT\nD=M\n@SP\nAM=M+1\nA=A-1\nM=D\n"
+            "@SP\nD=M\n@5\nD=D-A\n@R13\nD=D-M\n@ARG\nM=D\n"
+            "@SP\nD=M\n@LCL\nM=D\n"
+            "@R14\nA=M\n0;JMP\n"
+
+            // $$RETURN: the return address is read before the return value can overwrite it (nArgs = 0).
+            "($$RETURN)\n"
+            "@LCL\nD=M\n@R13\nM=D\n"
+            "@5\nA=D-A\nD=M\n@R14\nM=D\n"
+            "@SP\nAM=M-1\nD=M\n@ARG\nA=M\nM=D\n"
+            "@ARG\nD=M+1\n@SP\nM=D\n"
+            "@R13\nAM=M-1\nD=M\n@THAT\nM=D\n"
+            "@R13\nAM=M-1\nD=M\n@THIS\nM=D\n"
+            "@R13\nAM=M-1\nD=M\n@ARG\nM=D\n"
+            "@R13\nAM=M-1\nD=M\n@LCL\nM=D\n"
+            "@R14\nA=M\n0;JMP\n"
+
+            // Comparisons: the return address arrives in D and waits in R15; the result replaces x.
+            "($$TRUE)\n@SP\nA=M-1\nM=-1\n@R15\nA=M\n0;JMP\n"
+            "($$FALSE)\n@SP\nA=M-1\nM=0\n@R15\nA=M\n0;JMP\n"
+            "($$EQ)\n@R15\nM=D\n" "@SP\nAM=M-1\nD=M\nA=A-1\nD=M-D\n@$$TRUE\nD;JEQ\n@$$FALSE\n0;JMP\n"
+
+            // x > y and x < y. When the signs differ x - y can overflow, but then the sign of x decides.
+            "($$GT)\n@R15\nM=D\n" "@SP\nAM=M-1\nD=M\n@R14\nM=D\n@SP\nA=M-1\nD=M\n"
+            "@$$GT_XNEG\nD;JLT\n@R14\nD=M\n@$$TRUE\nD;JLT\n@$$GT_SAME\n0;JMP\n"
+            "($$GT_XNEG)\n@R14\nD=M\n@$$FALSE\nD;JGE\n"
+            "($$GT_SAME)\n@SP\nA=M-1\nD=M\n@R14\nD=D-M\n@$$TRUE\nD;JGT\n@$$FALSE\n0;JMP\n"
+            "($$LT)\n@R15\nM=D\n" "@SP\nAM=M-1\nD=M\n@R14\nM=D\n@SP\nA=M-1\nD=M\n"
+            "@$$LT_XNEG\nD;JLT\n@R14\nD=M\n@$$FALSE\nD;JLT\n@$$LT_SAME\n0;JMP\n"
+            "($$LT_XNEG)\n@R14\nD=M\n@$$TRUE\nD;JGE\n"
+            "($$LT_SAME)\n@SP\nA=M-1\nD=M\n@R14\nD=D-M\n@$$TRUE\nD;JLT\n@$$FALSE\n0;JMP\n";
+    }
+
+    std::string HackTranslator::link(std::vector<AsmUnit> units) {
+        // Deterministic output whatever order the classes finished in.
+        std::sort(units.begin(), units.end(), [](const AsmUnit& a, const AsmUnit& b) {
+            return a.className < b.className;
+        });
+
+        std::unordered_map<std::string_view, std::string_view> definedIn;
+        for (const AsmUnit& u : units) {
+            for (const std::string& function : u.functions) {
+                const auto [it, inserted] = definedIn.emplace(function, u.className);
+                if (!inserted) {
+                    throw std::runtime_error("Function '" + function + "' is defined by both " +
+                        std::string(it->second) + " and " + u.className);
+                }
+            }
+        }
+
+        const auto requireDefined = [&](const std::string& function, const std::string& caller) {
+            if (definedIn.count(function)) return;
+            throw std::runtime_error("Undefined function '" + function + "' (called from " + caller +
+                "). Add the OS classes (os/*.jack) to the build.");
+        };
+        requireDefined("Sys.init", "the bootstrap code");
+
+        std::size_t size = 0;
+        for (const AsmUnit& u : units) {
+            for (const std::string& function : u.calls) requireDefined(function, u.className);
+            size += u.code.size();
+        }
+
+        std::string program = runtime();
+        program.reserve(program.size() + size);
+        for (const AsmUnit& u : units) program += u.code;
+        return program;
+    }
+}
@@ -0,0 +1,78 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_HACK_TRANSLATOR_H
+#define NAND2TETRIS_HACK_TRANSLATOR_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../VMWriter/VMCode.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief The Hack assembly of one class (or one .vm file), and what the linker needs to know about it.
+     */
+    struct AsmUnit {
+        std::string className;              ///< Scope of its static variables ("Class.i").
+        std::string code;                   ///< Assembly text, one instruction or label per line.
+        std::vector<std::string> functions; ///< Functions defined here.
+        std::vector<std::string> calls;     ///< Functions called from here, without duplicates.
+    };
+
+    /**
+     * @brief Translates VM code to Hack assembly, one class at a time (the VM translator of the course).
+     *
+     * Call/return and the comparisons are not expanded inline: each use jumps to a shared routine
+     * emitted once by runtime(), which keeps programs that use the whole OS well inside the 32K ROM.
+     * Translators for different classes share nothing, so they can run in parallel; link() joins them.
+     */
+    class HackTranslator final : public VMCodeSink {
+        public:
+            explicit HackTranslator(std::string className);
+
+            /**
+             * @brief Translates the class's code (appending, if called more than once).
+             *
+             * @throws std::runtime_error on a command the Hack platform cannot execute (e.g. 'pop constant').
+             */
+            void write(const VMCode& code) override;
+
+            /**
+             * @brief The translated class; the translator is empty afterwards.
+             */
+            AsmUnit take();
+
+            /**
+             * @brief Joins translated classes into one program behind the bootstrap code (SP=256, call Sys.init).
+             *
+             * @throws std::runtime_error if a called function (or Sys.init) is defined nowhere, or twice.
+             */
+            static std::string link(std::vector<AsmUnit> units);
+
+        private:
+            AsmUnit unit;
+            std::string currentFunction; ///< Scope of labels; the class name before the first function.
+            int returnCounter = 0;       ///< Numbers the return addresses within this class.
+
+            void emit(std::string_view lines);
+            void emitInt(int value);
+            std::string label(SymbolId name, int labelId) const;
+            std::string nextReturnLabel();
+
+            void translatePush(Segment segment, int index);
+            void translatePop(Segment segment, int index);
+            void translateArithmetic(Command command);
+            void translateCall(std::string_view target, int nArgs);
+            void translateFunction(std::string_view name, int nLocals);
+
+            /**
+             * @brief Bootstrap code and the shared call/return/comparison routines.
+             */
+            static std::string runtime();
+    };
+}
+
+#endif //NAND2TETRIS_HACK_TRANSLATOR_H
@@ -0,0 +1,108 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "StringInterner.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace nand2tetris::jack {
+
+    namespace {
+        // Most identifiers repeat within a file, so each thread remembers recent ones and
+        // skips the shard lock for them. Entries view interner storage, which is never freed.
+        struct CachedName {
+            std::size_t hash = 0;
+            std::string_view text;
+            SymbolId id = NO_SYMBOL;
+        };
+        constexpr std::size_t LOCAL_CACHE_SIZE = 1024; // Power of two.
+        thread_local std::array<CachedName, LOCAL_CACHE_SIZE> localCache{};
+    }
+
+    StringInterner& StringInterner::global() {
+        static StringInterner instance;
+        return instance;
+    }
+
+    StringInterner::StringInterner() {
+        // The fixed ids in 'sym' (and keywordSymbol()) depend on this order.
+        intern("");
+        for (std::size_t i = 0; i < detail::KEYWORDS.size(); ++i) {
+            intern(keywordToString(static_cast<Keyword>(i)));
+        }
+        intern("Array");
+        intern("String");
+
+        if (size() != sym::PREDEFINED_COUNT || find("this") != sym::THIS || find("String") != sym::STRING) {
+            throw std::logic_error("Internal Compiler Error: Predefined symbol ids are out of sync.");
+        }
+    }
+
+    std::size_t StringInterner::hashOf(const std::string_view text) {
+        return std::hash<std::string_view>{}(text);
+    }
+
+    SymbolId StringInterner::intern(const std::string_view text) {
+        const std::size_t hash = hashOf(text);
+        CachedName& cached = localCache[hash & (LOCAL_CACHE_SIZE - 1)];
+        if (cached.hash == hash && cached.text == text) {
+            return cached.id;
+        }
+
+        Shard& shard = shardFor(hash);
+        SymbolId id;
+        {
+            std::scoped_lock lock(shard.mtx);
+            const auto it = shard.ids.find(text);
+            if (it != shard.ids.end()) {
+                id = it->second;
+            } else {
+                id = append(text);
+                shard.ids.emplace(view(id), id);
+            }
+        }
+
+        cached = {hash, view(id), id};
+        return id;
+    }
+
+    SymbolId StringInterner::find(const std::string_view text) const {
+        const Shard& shard = shardFor(hashOf(text));
+        std::scoped_lock lock(shard.mtx);
+        const auto it = shard.ids.find(text);
+        return it == shard.ids.end() ? NO_SYMBOL : it->second;
+    }
+
+    SymbolId StringInterner::append(const std::string_view text) {
+        std::scoped_lock lock(storageMtx);
+
+        const std::uint32_t id = count.load(std::memory_order_relaxed);
+        if (id >= MAX_CHUNKS * CHUNK_SIZE) {
+            throw std::runtime_error("Too many distinct identifiers (limit " + std::to_string(MAX_CHUNKS * CHUNK_SIZE) + ").");
+        }
+
+        std::string_view* chunk = chunks[id >> CHUNK_BITS].load(std::memory_order_relaxed);
+        if (!chunk) {
+            ownedChunks.push_back(std::make_unique<std::string_view[]>(CHUNK_SIZE));
+            chunk = ownedChunks.back().get();
+            chunks[id >> CHUNK_BITS].store(chunk, std::memory_order_release);
+        }
+
+        if (text.size() > textLeft) {
+            const std::size_t blockSize = std::max(TEXT_BLOCK_SIZE, text.size());
+            textBlocks.push_back(std::make_unique<char[]>(blockSize));
+            textCursor = textBlocks.back().get();
+            textLeft = blockSize;
+        }
+        if (!text.empty()) std::memcpy(textCursor, text.data(), text.size());
+        chunk[id & (CHUNK_SIZE - 1)] = std::string_view(textCursor, text.size());
+        textCursor += text.size();
+        textLeft -= text.size();
+
+        count.store(id + 1, std::memory_order_release);
+        return id;
+    }
+}
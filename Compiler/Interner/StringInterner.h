@@ -0,0 +1,132 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_STRING_INTERNER_H
+#define NAND2TETRIS_STRING_INTERNER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "SymbolId.h"
+#include "../Tokenizer/TokenTypes.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Ids that are the same in every run: the keywords (in Keyword order, see keywordSymbol())
+     * followed by the OS class names the type checker refers to.
+     */
+    namespace sym {
+        inline constexpr SymbolId INT       = keywordSymbol(Keyword::INT);
+        inline constexpr SymbolId CHAR      = keywordSymbol(Keyword::CHAR);
+        inline constexpr SymbolId BOOLEAN   = keywordSymbol(Keyword::BOOLEAN);
+        inline constexpr SymbolId VOID      = keywordSymbol(Keyword::VOID);
+        inline constexpr SymbolId NULL_TYPE = keywordSymbol(Keyword::NULL_); ///< The type of 'null'.
+        inline constexpr SymbolId THIS      = keywordSymbol(Keyword::THIS_);
+        inline constexpr SymbolId ARRAY     = keywordSymbol(Keyword::THIS_) + 1;
+        inline constexpr SymbolId STRING    = keywordSymbol(Keyword::THIS_) + 2;
+        inline constexpr SymbolId PREDEFINED_COUNT = STRING + 1;
+    }
+
+    /**
+     * @brief The process-wide table that maps identifier text to 32-bit SymbolIds.
+     *
+     * Every CompilationUnit interns into the same table, so an id means the same name in every
+     * Tokenizer, AST, SymbolTable and the GlobalRegistry. Names are copied into storage the
+     * interner owns, so their views stay valid for the rest of the process (even after the
+     * source buffer they came from is gone).
+     *
+     * intern() is thread-safe: callers first consult a small per-thread cache, then lock one of
+     * several shards. view() takes no lock at all.
+     */
+    class StringInterner {
+        public:
+            /**
+             * @brief The shared interner.
+             */
+            static StringInterner& global();
+
+            StringInterner(const StringInterner&) = delete;
+            StringInterner& operator=(const StringInterner&) = delete;
+
+            /**
+             * @brief Returns the id of 'text', adding it if it has not been seen before. Thread-safe.
+             *
+             * @throws std::runtime_error If the table is full.
+             */
+            SymbolId intern(std::string_view text);
+
+            /**
+             * @brief Returns the id of 'text' without adding it; NO_SYMBOL if it was never interned.
+             */
+            SymbolId find(std::string_view text) const;
+
+            /**
+             * @brief The text of an id returned by intern(). Lock-free.
+             */
+            std::string_view view(const SymbolId id) const {
+                return chunks[id >> CHUNK_BITS].load(std::memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+            }
+
+            /**
+             * @brief Number of ids handed out so far (every id is below this).
+             */
+            std::size_t size() const { return count.load(std::memory_order_acquire); }
+
+        private:
+            StringInterner();
+
+            static constexpr std::size_t SHARD_COUNT = 16;
+            static constexpr std::size_t CHUNK_BITS = 12;
+            static constexpr std::size_t CHUNK_SIZE = std::size_t{1} << CHUNK_BITS;
+            static constexpr std::size_t MAX_CHUNKS = 4096; ///< 16M distinct names.
+            static constexpr std::size_t TEXT_BLOCK_SIZE = 64 * 1024;
+
+            struct Shard {
+                std::unordered_map<std::string_view, SymbolId> ids; ///< Keys view the interner's own copies.
+                mutable std::mutex mtx;
+            };
+            std::array<Shard, SHARD_COUNT> shards;
+
+            // id -> text, in fixed-size chunks that never move, so readers need no lock.
+            std::array<std::atomic<std::string_view*>, MAX_CHUNKS> chunks{};
+            std::atomic<std::uint32_t> count{0};
+
+            std::mutex storageMtx; ///< Guards everything below, and the publication of new ids.
+            std::vector<std::unique_ptr<std::string_view[]>> ownedChunks;
+            std::vector<std::unique_ptr<char[]>> textBlocks;
+            char* textCursor = nullptr;
+            std::size_t textLeft = 0;
+
+            static std::size_t hashOf(std::string_view text);
+            Shard& shardFor(const std::size_t hash) { return shards[(hash >> 8) & (SHARD_COUNT - 1)]; }
+            const Shard& shardFor(const std::size_t hash) const { return shards[(hash >> 8) & (SHARD_COUNT - 1)]; }
+
+            /**
+             * @brief Copies 'text' into owned storage and assigns it the next id (caller holds its shard's lock).
+             */
+            SymbolId append(std::string_view text);
+    };
+
+    /**
+     * @brief Shorthand for StringInterner::global().view(id).
+     */
+    inline std::string_view nameOf(const SymbolId id) {
+        return StringInterner::global().view(id);
+    }
+
+    /**
+     * @brief Shorthand for StringInterner::global().intern(text).
+     */
+    inline SymbolId intern(const std::string_view text) {
+        return StringInterner::global().intern(text);
+    }
+}
+
+#endif //NAND2TETRIS_STRING_INTERNER_H
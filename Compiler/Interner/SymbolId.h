@@ -0,0 +1,26 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_SYMBOL_ID_H
+#define NAND2TETRIS_SYMBOL_ID_H
+
+#include <cstdint>
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief A 32-bit handle for an interned identifier or type name.
+     *
+     * Two names are equal exactly when their ids are equal. The text is available through
+     * StringInterner::global().view(id).
+     */
+    using SymbolId = std::uint32_t;
+
+    /**
+     * @brief The id of the empty string: "no name" (e.g. an implicit 'this' call, an unknown variable's type).
+     */
+    inline constexpr SymbolId NO_SYMBOL = 0;
+}
+
+#endif //NAND2TETRIS_SYMBOL_ID_H
@@ -0,0 +1,57 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "JackCompiler.h"
+#include <memory>
+#include <utility>
+#include "../Parser/AstArena.h"
+#include "../Parser/Parser.h"
+#include "../SemanticAnalyser/SemanticAnalyser.h"
+#include "../SemanticAnalyser/SymbolTable.h"
+#include "../Tokenizer/Tokenizer.h"
+#include "../VMWriter/VMSink.h"
+
+namespace nand2tetris::jack {
+
+    namespace {
+        // Everything one source needs until its code is generated (the AST views its tokens' bytes).
+        struct Unit {
+            std::unique_ptr<Tokenizer> tokenizer;
+            std::unique_ptr<AstArena> arena;
+            ClassNode* ast = nullptr;
+            SymbolTable symbolTable;
+        };
+    }
+
+    JackCompiler::JackCompiler(const CodeGenOptions &options) : options(options) {}
+
+    std::vector<VMOutput> JackCompiler::compile(std::vector<SourceBuffer> sources) const {
+        GlobalRegistry registry(standardLibrary);
+
+        // Registration needs every class before any of them can be checked, as in the CLI's phases.
+        std::vector<Unit> units(sources.size());
+        for (std::size_t i = 0; i < sources.size(); ++i) {
+            Unit& unit = units[i];
+            unit.tokenizer = std::make_unique<Tokenizer>(std::move(sources[i]));
+            unit.arena = std::make_unique<AstArena>();
+            Parser parser(*unit.tokenizer, registry, *unit.arena);
+            unit.ast = parser.parse();
+        }
+        registry.freeze();
+
+        std::vector<VMOutput> outputs;
+        outputs.reserve(units.size());
+        for (Unit& unit : units) {
+            SemanticAnalyser analyser(registry);
+            analyser.analyseClass(*unit.ast, unit.symbolTable);
+
+            MemorySink sink;
+            CodeGenerator generator(registry, sink, unit.symbolTable, options);
+            generator.compileClass(*unit.ast);
+
+            outputs.push_back({unit.tokenizer->getFilePath(), std::string(nameOf(unit.ast->getClassSymbol())), sink.take()});
+        }
+        return outputs;
+    }
+}
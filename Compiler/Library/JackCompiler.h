@@ -0,0 +1,59 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_JACK_COMPILER_H
+#define NAND2TETRIS_JACK_COMPILER_H
+
+#include <string>
+#include <vector>
+#include "../CodeGenerator/CodeGenerator.h"
+#include "../SemanticAnalyser/GlobalRegistry.h"
+#include "../Tokenizer/SourceBuffer.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief The compiled form of one source.
+     */
+    struct VMOutput {
+        std::string sourceName; ///< SourceBuffer::getName() of the source it came from.
+        std::string className;  ///< The class the source declares (the .vm file would be <className>.vm).
+        std::string code;       ///< The VM code, as it would be written to the .vm file.
+    };
+
+    /**
+     * @brief The compiler as a library: Jack sources in memory in, VM code in memory out.
+     *
+     * Nothing touches the filesystem or the console, so one long-lived instance can serve many
+     * builds (e.g. grading a stream of submissions) without paying for process startup or file I/O.
+     * The built-in OS signatures are registered once, on construction; every compile() starts from
+     * a copy of that pre-warmed registry, so builds never see each other's classes.
+     *
+     * compile() only reads the instance, so several threads may compile through it at once.
+     */
+    class JackCompiler {
+        public:
+            /**
+             * @param options Code generation settings used for every build.
+             */
+            explicit JackCompiler(const CodeGenOptions& options = {});
+
+            /**
+             * @brief Compiles one program: every class it needs except the OS.
+             *
+             * Unlike the command line, no Main class is required, so single classes can be built.
+             *
+             * @param sources The classes' source code (see SourceBuffer::fromString()).
+             * @return One output per source, in the same order.
+             * @throws std::runtime_error on the first syntax or semantic error, naming its source.
+             */
+            std::vector<VMOutput> compile(std::vector<SourceBuffer> sources) const;
+
+        private:
+            GlobalRegistry standardLibrary; ///< Only the built-in OS classes; never registered into.
+            CodeGenOptions options;
+    };
+}
+
+#endif //NAND2TETRIS_JACK_COMPILER_H
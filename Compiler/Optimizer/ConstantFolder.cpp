@@ -0,0 +1,70 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "ConstantFolder.h"
+#include <cstdint>
+
+namespace nand2tetris::jack {
+
+    namespace {
+        constexpr int JACK_TRUE = -1;
+        constexpr int JACK_FALSE = 0;
+        constexpr int MIN_VALUE = -32768;
+    }
+
+    int ConstantFolder::wrap(const long value) {
+        return static_cast<std::int16_t>(static_cast<std::uint16_t>(value & 0xFFFF));
+    }
+
+    int ConstantFolder::applyUnary(const char op, const int value) {
+        return op == '-' ? wrap(-static_cast<long>(value)) : wrap(~value);
+    }
+
+    std::optional<int> ConstantFolder::applyBinary(const char op, const int left, const int right) {
+        switch (op) {
+            case '+': return wrap(static_cast<long>(left) + right);
+            case '-': return wrap(static_cast<long>(left) - right);
+            case '*': return wrap(static_cast<long>(left) * right); // Math.multiply keeps the low 16 bits.
+            case '/':
+                // Division by zero is a run-time error (Sys.error), and MIN/-1 overflows; leave both alone.
+                if (right == 0 || (left == MIN_VALUE && right == -1)) return std::nullopt;
+                return wrap(left / right); // Math.divide truncates toward zero, like C++.
+            case '&': return wrap(left & right);
+            case '|': return wrap(left | right);
+            case '<': return left < right ? JACK_TRUE : JACK_FALSE;
+            case '>': return left > right ? JACK_TRUE : JACK_FALSE;
+            case '=': return left == right ? JACK_TRUE : JACK_FALSE;
+            default: return std::nullopt;
+        }
+    }
+
+    std::optional<int> ConstantFolder::fold(const ExpressionNode &node) {
+        switch (node.getType()) {
+            case ASTNodeType::INTEGER_LITERAL:
+                return static_cast<const IntegerLiteralNode&>(node).value; // NOLINT(*-pro-type-static-cast-downcast)
+            case ASTNodeType::KEYWORD_LITERAL: {
+                const auto& n = static_cast<const KeywordLiteralNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                if (n.value == Keyword::TRUE_) return JACK_TRUE;
+                if (n.value == Keyword::FALSE_ || n.value == Keyword::NULL_) return JACK_FALSE;
+                return std::nullopt; // 'this'
+            }
+            case ASTNodeType::UNARY_OP: {
+                const auto& n = static_cast<const UnaryOpNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                const std::optional<int> value = fold(*n.term);
+                if (!value) return std::nullopt;
+                return applyUnary(n.op, *value);
+            }
+            case ASTNodeType::BINARY_OP: {
+                const auto& n = static_cast<const BinaryOpNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                const std::optional<int> left = fold(*n.left);
+                if (!left) return std::nullopt;
+                const std::optional<int> right = fold(*n.right);
+                if (!right) return std::nullopt;
+                return applyBinary(n.op, *left, *right);
+            }
+            default:
+                return std::nullopt;
+        }
+    }
+}
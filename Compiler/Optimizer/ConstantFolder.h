@@ -0,0 +1,48 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_CONSTANT_FOLDER_H
+#define NAND2TETRIS_CONSTANT_FOLDER_H
+
+#include <optional>
+#include "../Parser/AST.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Evaluates constant Jack expressions at compile time.
+     *
+     * Arithmetic follows the Hack platform: 16-bit two's complement that wraps on overflow,
+     * 'true' is -1, and '*' and '/' behave like the OS's Math.multiply and Math.divide.
+     */
+    class ConstantFolder {
+        public:
+            /**
+             * @brief The value of 'node' if it is built only from literals and operators.
+             *
+             * @return The folded value, or std::nullopt if any part depends on run-time state
+             *         (or would fail at run time, like a division by zero).
+             */
+            static std::optional<int> fold(const ExpressionNode& node);
+
+            /**
+             * @brief Applies a binary operator ('+', '-', '*', '/', '&', '|', '<', '>', '=') to two constants.
+             *
+             * @return The result, or std::nullopt if it cannot be computed at compile time.
+             */
+            static std::optional<int> applyBinary(char op, int left, int right);
+
+            /**
+             * @brief Applies a unary operator ('-', '~') to a constant.
+             */
+            static int applyUnary(char op, int value);
+
+            /**
+             * @brief Truncates to the 16-bit signed range, as the Hack CPU does.
+             */
+            static int wrap(long value);
+    };
+}
+
+#endif //NAND2TETRIS_CONSTANT_FOLDER_H
@@ -0,0 +1,116 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "Inliner.h"
+#include <algorithm>
+
+namespace nand2tetris::jack {
+
+    void Inliner::addClass(const ClassNode &node, const GlobalRegistry &registry) {
+        // Numbered as SymbolTable::define numbers them: per kind, in declaration order.
+        std::unordered_map<SymbolId, InlineBinding> classNames;
+        int fields = 0, statics = 0;
+        for (const ClassVarDecNode* var : node.classVars) {
+            for (const SymbolId name : var->varNames) {
+                if (var->kind == ClassVarKind::STATIC) classNames[name] = {SymbolKind::STATIC, statics++};
+                else classNames[name] = {SymbolKind::FIELD, fields++};
+            }
+        }
+
+        for (const SubroutineDecNode* sub : node.subroutineDecs) {
+            if (sub->subType == SubroutineType::CONSTRUCTOR || !sub->localVars.empty()) continue;
+            const bool isMethod = sub->subType == SubroutineType::METHOD;
+            if (static_cast<int>(sub->parameters.size()) + (isMethod ? 1 : 0) > MAX_SLOTS) continue;
+
+            std::unordered_map<SymbolId, InlineBinding> names = classNames;
+            for (std::size_t i = 0; i < sub->parameters.size(); ++i) {
+                names[sub->parameters[i].name] = {SymbolKind::ARG, static_cast<int>(i)}; // Parameters shadow fields.
+            }
+            Scan scan{names, isMethod};
+            if (!scanBody(*sub, scan) || scan.cost > budget) continue;
+
+            const SymbolId qualifiedName = registry.getSignature(node.className, sub->name).qualifiedName;
+            InlineCandidate& candidate = candidates[qualifiedName];
+            candidate.qualifiedName = qualifiedName;
+            candidate.className = node.className;
+            candidate.subroutine = sub;
+            candidate.isMethod = isMethod;
+            candidate.usesStatics = scan.usesStatics;
+            candidate.usesArrays = scan.usesArrays;
+            candidate.cost = scan.cost;
+            candidate.names = std::move(names);
+        }
+    }
+
+    bool Inliner::scanBody(const SubroutineDecNode &sub, Scan &scan) {
+        const auto& stmts = sub.statements;
+        if (stmts.empty() || stmts[stmts.size() - 1]->getType() != ASTNodeType::RETURN_STATEMENT) return false;
+
+        for (std::size_t i = 0; i < stmts.size(); ++i) {
+            ++scan.cost;
+            if (i + 1 == stmts.size()) {
+                const auto& ret = static_cast<const ReturnStatementNode&>(*stmts[i]); // NOLINT(*-pro-type-static-cast-downcast)
+                return !ret.expression || scanExpression(*ret.expression, scan);
+            }
+            if (stmts[i]->getType() != ASTNodeType::LET_STATEMENT) return false;
+            const auto& let = static_cast<const LetStatementNode&>(*stmts[i]); // NOLINT(*-pro-type-static-cast-downcast)
+            if (!scanName(let.varName, scan)) return false;
+            if (let.indexExpr) {
+                scan.usesArrays = true;
+                if (!scanExpression(*let.indexExpr, scan)) return false;
+            }
+            if (!scanExpression(*let.valueExpr, scan)) return false;
+        }
+        return false;
+    }
+
+    bool Inliner::scanExpression(const ExpressionNode &node, Scan &scan) {
+        ++scan.cost;
+        switch (node.getType()) {
+            case ASTNodeType::INTEGER_LITERAL:
+                return true;
+            case ASTNodeType::KEYWORD_LITERAL:
+                return static_cast<const KeywordLiteralNode&>(node).value != Keyword::THIS_ || scan.isMethod; // NOLINT(*-pro-type-static-cast-downcast)
+            case ASTNodeType::BINARY_OP: {
+                const auto& n = static_cast<const BinaryOpNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                // '*' and '/' are calls to Math, which may use the temp slots the arguments are in.
+                if (n.op == '*' || n.op == '/') return false;
+                return scanExpression(*n.left, scan) && scanExpression(*n.right, scan);
+            }
+            case ASTNodeType::UNARY_OP:
+                return scanExpression(*static_cast<const UnaryOpNode&>(node).term, scan); // NOLINT(*-pro-type-static-cast-downcast)
+            case ASTNodeType::IDENTIFIER: {
+                const auto& n = static_cast<const IdentifierNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                if (n.indexExpr) scan.usesArrays = true;
+                return scanName(n.name, scan) && (!n.indexExpr || scanExpression(*n.indexExpr, scan));
+            }
+            default:
+                return false; // Calls and string literals (String.new) are not leaves.
+        }
+    }
+
+    bool Inliner::scanName(const SymbolId name, Scan &scan) {
+        const auto it = scan.names.find(name);
+        if (it == scan.names.end()) return false;
+        if (it->second.kind == SymbolKind::STATIC) scan.usesStatics = true;
+        return it->second.kind != SymbolKind::FIELD || scan.isMethod;
+    }
+
+    const InlineCandidate* Inliner::find(const SymbolId qualifiedName) const {
+        const auto it = candidates.find(qualifiedName);
+        return it == candidates.end() ? nullptr : &it->second;
+    }
+
+    std::vector<std::pair<SymbolId, std::size_t>> Inliner::report() const {
+        std::vector<std::pair<SymbolId, std::size_t>> inlined;
+        for (const auto& [name, candidate] : candidates) {
+            const std::size_t sites = candidate.sites.load(std::memory_order_relaxed);
+            if (sites > 0) inlined.emplace_back(name, sites);
+        }
+        std::sort(inlined.begin(), inlined.end(), [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second > b.second : nameOf(a.first) < nameOf(b.first);
+        });
+        return inlined;
+    }
+}
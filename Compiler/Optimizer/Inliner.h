@@ -0,0 +1,107 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_INLINER_H
+#define NAND2TETRIS_INLINER_H
+
+#include <atomic>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../Parser/AST.h"
+#include "../SemanticAnalyser/GlobalRegistry.h"
+#include "../SemanticAnalyser/SymbolTable.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Where a name used in an inlinable body lives.
+     *
+     * ARG: the parameter's position (its value sits in a temp slot at the call site).
+     * FIELD / STATIC: the callee's segment index.
+     */
+    struct InlineBinding {
+        SymbolKind kind = SymbolKind::NONE;
+        int index = 0;
+    };
+
+    /**
+     * @brief A subroutine whose body can be expanded in place of a call to it.
+     */
+    struct InlineCandidate {
+        SymbolId qualifiedName = NO_SYMBOL;
+        SymbolId className = NO_SYMBOL;
+        const SubroutineDecNode* subroutine = nullptr; ///< Its statements are the body to expand.
+        bool isMethod = false;
+        bool usesStatics = false; ///< Statics are per class: only inlinable into its own class.
+        bool usesArrays = false;  ///< Indexes an array, which needs THAT (so the receiver cannot stay there).
+        int cost = 0;             ///< AST nodes in the body.
+        std::unordered_map<SymbolId, InlineBinding> names; ///< Every name the body uses.
+        mutable std::atomic<std::size_t> sites{0}; ///< Call sites expanded so far, for the report.
+    };
+
+    /**
+     * @brief Cross-class inlining of small leaf subroutines (--inline).
+     *
+     * A function or method is a candidate if it has no local variables, its body is only 'let'
+     * statements followed by a 'return', it makes no calls (which rules out string literals and
+     * '*' / '/', the Math calls), and the body has at most 'budget' AST nodes. Getters, setters and
+     * one-line helpers qualify. At a call site the CodeGenerator evaluates the arguments as usual,
+     * keeps them in temp 1..7 instead of a new frame, and emits the body right there.
+     */
+    class Inliner {
+        public:
+            static constexpr int DEFAULT_BUDGET = 12;
+            static constexpr int FIRST_SLOT = 1; ///< temp 0 is the CodeGenerator's scratch register.
+            static constexpr int MAX_SLOTS = 7;  ///< temp 1..7: the receiver and the arguments.
+
+            explicit Inliner(int budget = DEFAULT_BUDGET) : budget(budget) {}
+
+            /**
+             * @brief Adds the candidates among one parsed class's subroutines.
+             *
+             * Must not run concurrently with find().
+             */
+            void addClass(const ClassNode& node, const GlobalRegistry& registry);
+
+            /**
+             * @brief The candidate called 'qualifiedName' ("Class.name"), or nullptr.
+             */
+            const InlineCandidate* find(SymbolId qualifiedName) const;
+
+            /**
+             * @brief Number of candidates found.
+             */
+            std::size_t size() const { return candidates.size(); }
+
+            int getBudget() const { return budget; }
+
+            /**
+             * @brief The subroutines that were inlined and at how many call sites each, most first.
+             */
+            std::vector<std::pair<SymbolId, std::size_t>> report() const;
+
+        private:
+            int budget;
+            std::unordered_map<SymbolId, InlineCandidate> candidates;
+
+            /**
+             * @brief What checking one body needs, and what it finds out.
+             */
+            struct Scan {
+                const std::unordered_map<SymbolId, InlineBinding>& names;
+                bool isMethod;
+                bool usesStatics = false;
+                bool usesArrays = false;
+                int cost = 0;
+            };
+
+            static bool scanBody(const SubroutineDecNode& sub, Scan& scan);
+            static bool scanExpression(const ExpressionNode& node, Scan& scan);
+            static bool scanName(SymbolId name, Scan& scan);
+    };
+}
+
+#endif //NAND2TETRIS_INLINER_H
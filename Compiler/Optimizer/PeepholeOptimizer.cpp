@@ -0,0 +1,147 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "PeepholeOptimizer.h"
+#include <unordered_set>
+#include "ConstantFolder.h"
+
+namespace nand2tetris::jack {
+
+    namespace {
+        bool isConstant(const VMInstruction& ins) {
+            return ins.op == VMOp::PUSH && ins.segment == Segment::CONST;
+        }
+
+        // The Jack operator a binary VM command implements, or 0.
+        char binaryOperator(const Command command) {
+            switch (command) {
+                case Command::ADD: return '+';
+                case Command::SUB: return '-';
+                case Command::AND: return '&';
+                case Command::OR:  return '|';
+                case Command::EQ:  return '=';
+                case Command::GT:  return '>';
+                case Command::LT:  return '<';
+                default: return 0;
+            }
+        }
+    }
+
+    std::size_t PeepholeOptimizer::run(VMCode &code, const std::size_t begin) {
+        const std::size_t before = code.size();
+        // Each pass can expose more work for the other (a dropped label makes code dead, and so on).
+        while (simplify(code, begin) | removeUnusedLabels(code, begin)) {}
+        return before - code.size();
+    }
+
+    bool PeepholeOptimizer::simplify(VMCode &code, const std::size_t begin) {
+        VMCode out;
+        out.reserve(code.size() - begin);
+        bool changed = false;
+        bool reachable = true;
+
+        for (std::size_t row = begin; row < code.size(); ++row) {
+            const VMInstruction ins = code[row];
+            if (ins.op == VMOp::LABEL || ins.op == VMOp::FUNCTION) reachable = true;
+            if (!reachable) {
+                changed = true; // Nothing can jump here: the previous goto/return ends the block.
+                continue;
+            }
+
+            if (ins.op == VMOp::LABEL) {
+                // "goto L" followed (possibly via other labels) by "label L" falls through anyway.
+                std::size_t i = out.size();
+                while (i > 0 && out.op(i - 1) == VMOp::LABEL) --i;
+                if (i > 0 && out.op(i - 1) == VMOp::GOTO && out[i - 1].sameLabelAs(ins)) {
+                    out.erase(i - 1);
+                    changed = true;
+                }
+            }
+
+            out.append(ins);
+            while (reduceTail(out)) changed = true;
+
+            if (!out.empty() && (out.op(out.size() - 1) == VMOp::GOTO || out.op(out.size() - 1) == VMOp::RETURN)) {
+                reachable = false;
+            }
+        }
+
+        code.truncate(begin);
+        code.append(out, 0, out.size());
+        return changed;
+    }
+
+    bool PeepholeOptimizer::reduceTail(VMCode &out) {
+        const std::size_t n = out.size();
+        if (n < 2) return false;
+        const VMInstruction last = out[n - 1];
+        const VMInstruction prev = out[n - 2];
+
+        switch (last.op) {
+            case VMOp::ARITHMETIC: {
+                if (last.command == Command::NEG || last.command == Command::NOT) {
+                    if (isConstant(prev)) {
+                        out.setArg(n - 2, ConstantFolder::applyUnary(last.command == Command::NEG ? '-' : '~', prev.arg));
+                        out.truncate(n - 1);
+                        return true;
+                    }
+                    if (prev.op == VMOp::ARITHMETIC && prev.command == last.command) {
+                        out.truncate(n - 2); // not, not / neg, neg
+                        return true;
+                    }
+                    return false;
+                }
+                const char op = binaryOperator(last.command);
+                if (op && n >= 3 && isConstant(out[n - 3]) && isConstant(prev)) {
+                    if (const std::optional<int> value = ConstantFolder::applyBinary(op, out.arg(n - 3), prev.arg)) {
+                        out.setArg(n - 3, *value);
+                        out.truncate(n - 2);
+                        return true;
+                    }
+                }
+                return false;
+            }
+            case VMOp::IF_GOTO: {
+                if (!isConstant(prev)) return false;
+                VMInstruction jump = last;
+                const bool taken = prev.arg != 0;
+                out.truncate(n - 2);
+                if (taken) {
+                    jump.op = VMOp::GOTO;
+                    out.append(jump);
+                }
+                return true;
+            }
+            case VMOp::POP: {
+                // Storing a value straight back where it was loaded from.
+                if (prev.op == VMOp::PUSH && prev.segment == last.segment && prev.arg == last.arg) {
+                    out.truncate(n - 2);
+                    return true;
+                }
+                return false;
+            }
+            default:
+                return false;
+        }
+    }
+
+    bool PeepholeOptimizer::removeUnusedLabels(VMCode &code, const std::size_t begin) {
+        std::unordered_set<int> used;
+        for (std::size_t row = begin; row < code.size(); ++row) {
+            const VMOp op = code.op(row);
+            if ((op == VMOp::GOTO || op == VMOp::IF_GOTO) && code.name(row) == NO_SYMBOL) used.insert(code.arg(row));
+        }
+
+        // Named labels are left alone: only the generated "L<id>" ones are known to be local.
+        std::size_t kept = begin;
+        for (std::size_t row = begin; row < code.size(); ++row) {
+            if (code.op(row) == VMOp::LABEL && code.name(row) == NO_SYMBOL && !used.count(code.arg(row))) continue;
+            if (kept != row) code.set(kept, code[row]);
+            ++kept;
+        }
+        const bool changed = kept != code.size();
+        code.truncate(kept);
+        return changed;
+    }
+}
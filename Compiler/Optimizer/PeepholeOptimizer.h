@@ -0,0 +1,53 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_PEEPHOLE_OPTIMIZER_H
+#define NAND2TETRIS_PEEPHOLE_OPTIMIZER_H
+
+#include <cstddef>
+#include "../VMWriter/VMCode.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Rewrites the VM code of one function into a shorter equivalent.
+     *
+     * Applied until nothing changes:
+     *  - constant arithmetic ('push constant 1, neg' becomes one constant; 'push 2, push 3, add' becomes 5),
+     *  - 'not, not' and 'neg, neg' cancel, as does 'push X, pop X',
+     *  - an 'if-goto' on a constant becomes a 'goto' or disappears,
+     *  - a 'goto' to the label that immediately follows it is dropped,
+     *  - code after 'goto' or 'return' that no label leads to is dropped,
+     *  - labels that nothing jumps to are dropped.
+     *
+     * Label scope is one function, so the rows given must not span several.
+     */
+    class PeepholeOptimizer {
+        public:
+            /**
+             * @brief Optimizes the rows of 'code' from 'begin' to the end (one function) in place.
+             *
+             * @return The number of instructions removed.
+             */
+            static std::size_t run(VMCode& code, std::size_t begin = 0);
+
+        private:
+            /**
+             * @brief One forward pass of the local rewrites and dead-code removal.
+             */
+            static bool simplify(VMCode& code, std::size_t begin);
+
+            /**
+             * @brief Tries to merge the last instruction of 'out' with those before it.
+             */
+            static bool reduceTail(VMCode& out);
+
+            /**
+             * @brief Drops generated labels that no goto/if-goto refers to.
+             */
+            static bool removeUnusedLabels(VMCode& code, std::size_t begin);
+    };
+}
+
+#endif //NAND2TETRIS_PEEPHOLE_OPTIMIZER_H
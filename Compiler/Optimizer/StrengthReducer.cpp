@@ -0,0 +1,178 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "StrengthReducer.h"
+#include <cstdlib>
+#include <vector>
+
+namespace nand2tetris::jack {
+
+    namespace {
+        /**
+         * @brief The non-adjacent form of m > 0: digits in {-1, 0, 1}, least significant first,
+         *        with as few non-zero digits as possible (31 = 32 - 1 instead of 16+8+4+2+1).
+         */
+        std::vector<int> signedDigits(long m) {
+            std::vector<int> digits;
+            while (m > 0) {
+                int digit = 0;
+                if (m % 2 != 0) {
+                    digit = 2 - static_cast<int>(m % 4); // 1 for ...01, -1 for ...11
+                    m -= digit;
+                }
+                digits.push_back(digit);
+                m /= 2;
+            }
+            return digits;
+        }
+
+        /// Doublings plus adds/subs for x*m, m > 0.
+        int multiplySteps(const std::vector<int>& digits) {
+            int steps = static_cast<int>(digits.size()) - 1;
+            for (std::size_t i = 0; i + 1 < digits.size(); ++i) {
+                if (digits[i] != 0) ++steps;
+            }
+            return steps;
+        }
+
+        /// Replaces the value on the stack v by v - ((v+v) & temp 1), which is -v when temp 1 is
+        /// true (-1) and v when it is false (0). Saves the branch of an 'if (x < 0)'.
+        void writeNegateIfSign(VMWriter& writer, const int valueSlot) {
+            writer.writePush(Segment::TEMP, valueSlot);
+            writer.writePush(Segment::TEMP, valueSlot);
+            writer.writeArithmetic(Command::ADD);
+            writer.writePush(Segment::TEMP, 1);
+            writer.writeArithmetic(Command::AND);
+            writer.writeArithmetic(Command::SUB);
+        }
+    }
+
+    bool StrengthReducer::reducesMultiply(const int factor) {
+        if (factor >= -1 && factor <= 1) return true;
+        return multiplySteps(signedDigits(std::labs(factor))) <= MAX_MULTIPLY_STEPS;
+    }
+
+    bool StrengthReducer::reducesDivide(const int divisor) {
+        const long m = std::labs(divisor);
+        return m != 0 && m <= 16384 && (m & (m - 1)) == 0; // x / -32768 is left to Math.divide
+    }
+
+    bool StrengthReducer::isPure(const ExpressionNode &node) {
+        switch (node.getType()) {
+            case ASTNodeType::INTEGER_LITERAL:
+            case ASTNodeType::KEYWORD_LITERAL:
+                return true;
+            case ASTNodeType::IDENTIFIER: {
+                const auto& n = static_cast<const IdentifierNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                return !n.indexExpr || isPure(*n.indexExpr);
+            }
+            case ASTNodeType::UNARY_OP:
+                return isPure(*static_cast<const UnaryOpNode&>(node).term); // NOLINT(*-pro-type-static-cast-downcast)
+            case ASTNodeType::BINARY_OP: {
+                const auto& n = static_cast<const BinaryOpNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                // '/' may end in Sys.error (division by zero); '*' is a call too.
+                return n.op != '*' && n.op != '/' && isPure(*n.left) && isPure(*n.right);
+            }
+            default:
+                return false; // Calls, and string literals (String.new)
+        }
+    }
+
+    void StrengthReducer::writeMultiply(VMWriter &writer, const int factor) {
+        if (factor == 0) {
+            writer.writePop(Segment::TEMP, 0); // Evaluated for its side effects only.
+            writer.writePush(Segment::CONST, 0);
+            return;
+        }
+
+        // Horner's rule from the top digit: acc = x, then acc = 2*acc (+ or - x) per lower digit.
+        const std::vector<int> digits = signedDigits(std::labs(factor));
+        const bool needsX = multiplySteps(digits) > static_cast<int>(digits.size()) - 1;
+        if (needsX) {
+            writer.writePop(Segment::TEMP, 0);
+            writer.writePush(Segment::TEMP, 0);
+        }
+        for (std::size_t i = digits.size() - 1; i-- > 0;) {
+            if (needsX && i == digits.size() - 2) {
+                // acc is still x, which temp 0 has too.
+                writer.writePush(Segment::TEMP, 0);
+            } else {
+                writer.writePop(Segment::TEMP, 1);
+                writer.writePush(Segment::TEMP, 1);
+                writer.writePush(Segment::TEMP, 1);
+            }
+            writer.writeArithmetic(Command::ADD);
+            if (digits[i] != 0) {
+                writer.writePush(Segment::TEMP, 0);
+                writer.writeArithmetic(digits[i] > 0 ? Command::ADD : Command::SUB);
+            }
+        }
+        if (factor < 0) writer.writeArithmetic(Command::NEG); // x*(-c) = -(x*c), also when it wraps.
+    }
+
+    void StrengthReducer::writeDivide(VMWriter &writer, const int divisor, const int firstLabel) {
+        const int m = static_cast<int>(std::labs(divisor));
+        if (m > 1) {
+            const int labelLoop = firstLabel;
+            const int labelSkip = firstLabel + 1;
+            const int labelTest = firstLabel + 2;
+
+            // temp 1 = (x < 0), temp 0 = |x| without the bits below m (-32768 stays 0x8000,
+            // which is its magnitude read as unsigned).
+            writer.writePop(Segment::TEMP, 0);
+            writer.writePush(Segment::TEMP, 0);
+            writer.writePush(Segment::CONST, 0);
+            writer.writeArithmetic(Command::LT);
+            writer.writePop(Segment::TEMP, 1);
+            writer.writePush(Segment::TEMP, 0);
+            writeNegateIfSign(writer, 0);
+            writer.writePush(Segment::CONST, -m);
+            writer.writeArithmetic(Command::AND);
+            writer.writePop(Segment::TEMP, 0);
+
+            // temp 2 = quotient, temp 3 = the bit of |x| tested, temp 4 = what it is worth in the quotient.
+            writer.writePush(Segment::CONST, 0);
+            writer.writePop(Segment::TEMP, 2);
+            writer.writePush(Segment::CONST, m);
+            writer.writePop(Segment::TEMP, 3);
+            writer.writePush(Segment::CONST, 1);
+            writer.writePop(Segment::TEMP, 4);
+            writer.writeGoto(labelTest);
+
+            // Move each set bit from temp 0 into the quotient, until none are left.
+            writer.writeLabel(labelLoop);
+            writer.writePush(Segment::TEMP, 0);
+            writer.writePush(Segment::TEMP, 3);
+            writer.writeArithmetic(Command::AND);
+            writer.writePush(Segment::CONST, 0);
+            writer.writeArithmetic(Command::EQ);
+            writer.writeIf(labelSkip);
+            writer.writePush(Segment::TEMP, 0);
+            writer.writePush(Segment::TEMP, 3);
+            writer.writeArithmetic(Command::SUB);
+            writer.writePop(Segment::TEMP, 0);
+            writer.writePush(Segment::TEMP, 2);
+            writer.writePush(Segment::TEMP, 4);
+            writer.writeArithmetic(Command::ADD);
+            writer.writePop(Segment::TEMP, 2);
+            writer.writeLabel(labelSkip);
+            writer.writePush(Segment::TEMP, 3);
+            writer.writePush(Segment::TEMP, 3);
+            writer.writeArithmetic(Command::ADD);
+            writer.writePop(Segment::TEMP, 3);
+            writer.writePush(Segment::TEMP, 4);
+            writer.writePush(Segment::TEMP, 4);
+            writer.writeArithmetic(Command::ADD);
+            writer.writePop(Segment::TEMP, 4);
+            writer.writeLabel(labelTest);
+            writer.writePush(Segment::TEMP, 0);
+            writer.writeIf(labelLoop);
+
+            // Truncation toward zero: the quotient of |x|, with the sign of x.
+            writer.writePush(Segment::TEMP, 2);
+            writeNegateIfSign(writer, 2);
+        }
+        if (divisor < 0) writer.writeArithmetic(Command::NEG);
+    }
+}
@@ -0,0 +1,63 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_STRENGTH_REDUCER_H
+#define NAND2TETRIS_STRENGTH_REDUCER_H
+
+#include "../Parser/AST.h"
+#include "../VMWriter/VMWriter.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Replaces '*' and '/' by a constant with inline VM code (--strength-reduce).
+     *
+     * Math.multiply loops over all 16 bits and Math.divide recurses once per quotient bit, so a
+     * call costs hundreds to thousands of Hack cycles. Multiplying by a constant is a short chain
+     * of doublings and adds (x*10 = ((x+x)+(x+x)+x)+..., x*31 = x*32 - x); dividing by a power of
+     * two is a loop over the set bits of |x|, which the VM (no shifts) cannot do any faster.
+     * The results are the ones the OS routines give: 16-bit wrap-around for '*', truncation
+     * toward zero for '/'.
+     *
+     * Every sequence starts with the other operand on the stack and leaves the result in its
+     * place. Scratch values live in temp 0..4, which are never live across an expression.
+     */
+    class StrengthReducer {
+        public:
+            /// Doublings plus adds/subs allowed for a multiply (a power of two up to 2^10 fits).
+            static constexpr int MAX_MULTIPLY_STEPS = 10;
+            /// Labels writeDivide needs (see CodeGenerator::getUniqueLabel).
+            static constexpr int DIVIDE_LABELS = 3;
+
+            /**
+             * @brief Whether x*factor is written inline (0, +-1, and factors within MAX_MULTIPLY_STEPS).
+             */
+            static bool reducesMultiply(int factor);
+
+            /**
+             * @brief Whether x/divisor is written inline (+-1 and +-powers of two).
+             */
+            static bool reducesDivide(int divisor);
+
+            /**
+             * @brief Whether evaluating 'node' can be skipped (for x*0): it makes no calls, and
+             *        neither do its '*' and '/'.
+             */
+            static bool isPure(const ExpressionNode& node);
+
+            /**
+             * @brief Replaces x on the stack by x*factor. Requires reducesMultiply(factor).
+             */
+            static void writeMultiply(VMWriter& writer, int factor);
+
+            /**
+             * @brief Replaces x on the stack by x/divisor. Requires reducesDivide(divisor).
+             *
+             * @param firstLabel The first of DIVIDE_LABELS consecutive unused label ids.
+             */
+            static void writeDivide(VMWriter& writer, int divisor, int firstLabel);
+    };
+}
+
+#endif //NAND2TETRIS_STRENGTH_REDUCER_H
@@ -0,0 +1,110 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "StringPool.h"
+
+namespace nand2tetris::jack {
+
+    void StringPool::addClass(const ClassNode &node, const GlobalRegistry &registry,
+                              const std::unordered_set<SymbolId> *reachable) {
+        for (const auto& sub : node.subroutineDecs) {
+            // Same filter as CodeGenerator::compileClass: pooling literals it never emits would only cost ROM.
+            if (reachable && !reachable->count(registry.getSignature(node.className, sub->name).qualifiedName)) continue;
+            addStatements(sub->statements);
+        }
+    }
+
+    void StringPool::addStatements(const ArenaList<StatementNode*> &stmts) {
+        for (const auto& stmt : stmts) {
+            switch (stmt->getType()) {
+                case ASTNodeType::LET_STATEMENT: {
+                    const auto& n = static_cast<const LetStatementNode&>(*stmt); // NOLINT(*-pro-type-static-cast-downcast)
+                    if (n.indexExpr) addExpression(*n.indexExpr);
+                    addExpression(*n.valueExpr);
+                    break;
+                }
+                case ASTNodeType::IF_STATEMENT: {
+                    const auto& n = static_cast<const IfStatementNode&>(*stmt); // NOLINT(*-pro-type-static-cast-downcast)
+                    addExpression(*n.condition);
+                    addStatements(n.ifStatements);
+                    addStatements(n.elseStatements);
+                    break;
+                }
+                case ASTNodeType::WHILE_STATEMENT: {
+                    const auto& n = static_cast<const WhileStatementNode&>(*stmt); // NOLINT(*-pro-type-static-cast-downcast)
+                    addExpression(*n.condition);
+                    addStatements(n.body);
+                    break;
+                }
+                case ASTNodeType::DO_STATEMENT:
+                    addExpression(*static_cast<const DoStatementNode&>(*stmt).callExpression); // NOLINT(*-pro-type-static-cast-downcast)
+                    break;
+                case ASTNodeType::RETURN_STATEMENT: {
+                    const auto& n = static_cast<const ReturnStatementNode&>(*stmt); // NOLINT(*-pro-type-static-cast-downcast)
+                    if (n.expression) addExpression(*n.expression);
+                    break;
+                }
+                default: break;
+            }
+        }
+    }
+
+    void StringPool::addExpression(const ExpressionNode &node) {
+        switch (node.getType()) {
+            case ASTNodeType::STRING_LITERAL:
+                literals.insert(static_cast<const StringLiteralNode&>(node).value); // NOLINT(*-pro-type-static-cast-downcast)
+                ++useCount;
+                break;
+            case ASTNodeType::BINARY_OP: {
+                const auto& n = static_cast<const BinaryOpNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                addExpression(*n.left);
+                addExpression(*n.right);
+                break;
+            }
+            case ASTNodeType::UNARY_OP:
+                addExpression(*static_cast<const UnaryOpNode&>(node).term); // NOLINT(*-pro-type-static-cast-downcast)
+                break;
+            case ASTNodeType::SUBROUTINE_CALL:
+                for (const auto& arg : static_cast<const CallNode&>(node).arguments) addExpression(*arg); // NOLINT(*-pro-type-static-cast-downcast)
+                break;
+            case ASTNodeType::IDENTIFIER: {
+                const auto& n = static_cast<const IdentifierNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                if (n.indexExpr) addExpression(*n.indexExpr);
+                break;
+            }
+            default: break;
+        }
+    }
+
+    void StringPool::finish() {
+        const std::string prefix = std::string(CLASS_NAME) + ".s";
+        int index = 0;
+        for (const std::string_view literal : literals) {
+            accessors.emplace(literal, intern(prefix + std::to_string(index++)));
+        }
+    }
+
+    SymbolId StringPool::accessorOf(const std::string_view literal) const {
+        const auto it = accessors.find(literal);
+        return it == accessors.end() ? NO_SYMBOL : it->second;
+    }
+
+    void StringPool::compile(VMWriter &writer) const {
+        // Labels are local to a function, so every accessor can use the same one.
+        constexpr int READY = 0;
+        int index = 0;
+        for (const std::string_view literal : literals) {
+            writer.writeFunction(accessors.at(literal), 0);
+            writer.writePush(Segment::STATIC, index);
+            writer.writeIf(READY); // Static variables start at 0, and no String lives at address 0.
+            writer.writeStringConstant(literal);
+            writer.writePop(Segment::STATIC, index);
+            writer.writeLabel(READY);
+            writer.writePush(Segment::STATIC, index);
+            writer.writeReturn();
+            ++index;
+        }
+        writer.flush();
+    }
+}
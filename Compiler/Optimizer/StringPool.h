@@ -0,0 +1,83 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_STRING_POOL_H
+#define NAND2TETRIS_STRING_POOL_H
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../Parser/AST.h"
+#include "../SemanticAnalyser/GlobalRegistry.h"
+#include "../VMWriter/VMWriter.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Whole-program string constant pool (--string-pool).
+     *
+     * Every distinct string literal of the program gets one accessor in the generated class
+     * StringPool: 'StringPool.s<k>' builds the string the first time it is called, keeps it in
+     * static k, and returns that same object from then on. A literal then compiles to a single
+     * 'call StringPool.s<k> 0' instead of String.new plus two commands per character, and is
+     * built once per run instead of every time the expression is evaluated.
+     *
+     * All uses of a literal share one String object, so a program that disposes of a literal
+     * or changes it (setCharAt, appendChar...) must not use this mode.
+     */
+    class StringPool {
+        public:
+            static constexpr std::string_view CLASS_NAME = "StringPool";
+
+            /**
+             * @brief Adds the literals of one parsed class.
+             *
+             * @param reachable With --tree-shake, only these subroutines' literals (qualified names); nullptr = all.
+             */
+            void addClass(const ClassNode& node, const GlobalRegistry& registry,
+                          const std::unordered_set<SymbolId>* reachable = nullptr);
+
+            /**
+             * @brief Numbers the literals (in text order, so the output does not depend on the order
+             *        the classes were added in). Must be called once, after the last addClass().
+             */
+            void finish();
+
+            /**
+             * @brief The accessor for 'literal' ("StringPool.s<k>"), or NO_SYMBOL if it was never added.
+             *
+             * Safe to call from several code generators at once.
+             */
+            SymbolId accessorOf(std::string_view literal) const;
+
+            /**
+             * @brief Writes the StringPool class: one lazily initialised accessor per literal.
+             */
+            void compile(VMWriter& writer) const;
+
+            /**
+             * @brief Number of distinct literals.
+             */
+            std::size_t size() const { return literals.size(); }
+
+            /**
+             * @brief Number of literal occurrences added (each now one call).
+             */
+            std::size_t uses() const { return useCount; }
+
+        private:
+            std::set<std::string_view> literals;            ///< Views into the ASTs, which outlive the build.
+            std::unordered_map<std::string_view, SymbolId> accessors; ///< Filled by finish().
+            std::size_t useCount = 0;
+
+            void addStatements(const ArenaList<StatementNode*>& stmts);
+            void addExpression(const ExpressionNode& node);
+    };
+}
+
+#endif //NAND2TETRIS_STRING_POOL_H
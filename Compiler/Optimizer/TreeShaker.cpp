@@ -0,0 +1,142 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "TreeShaker.h"
+#include <algorithm>
+
+namespace nand2tetris::jack {
+
+    std::vector<SubroutineCalls> TreeShaker::collectCalls(const ClassNode &node, SymbolTable &table,
+                                                          const GlobalRegistry &registry) {
+        // The calls the CodeGenerator emits without a CallNode.
+        static const SymbolId MEMORY_ALLOC = intern("Memory.alloc");
+
+        std::vector<SubroutineCalls> result;
+        result.reserve(node.subroutineDecs.size());
+
+        // The analyser visited the subroutines in this same order, so the position is the scope id.
+        int subroutineId = 0;
+        for (const auto& sub : node.subroutineDecs) {
+            table.enterSubroutine(subroutineId++);
+
+            SubroutineCalls calls;
+            calls.function = registry.getSignature(node.className, sub->name).qualifiedName;
+            if (sub->subType == SubroutineType::CONSTRUCTOR) calls.callees.push_back(MEMORY_ALLOC);
+
+            Walk walk{table, registry, node.className, calls.callees};
+            collectStatements(sub->statements, walk);
+
+            std::sort(calls.callees.begin(), calls.callees.end());
+            calls.callees.erase(std::unique(calls.callees.begin(), calls.callees.end()), calls.callees.end());
+            result.push_back(std::move(calls));
+        }
+        return result;
+    }
+
+    void TreeShaker::collectStatements(const ArenaList<StatementNode*> &stmts, Walk &walk) {
+        for (const auto& stmt : stmts) {
+            switch (stmt->getType()) {
+                case ASTNodeType::LET_STATEMENT: {
+                    const auto& n = static_cast<const LetStatementNode&>(*stmt); // NOLINT(*-pro-type-static-cast-downcast)
+                    if (n.indexExpr) collectExpression(*n.indexExpr, walk);
+                    collectExpression(*n.valueExpr, walk);
+                    break;
+                }
+                case ASTNodeType::IF_STATEMENT: {
+                    const auto& n = static_cast<const IfStatementNode&>(*stmt); // NOLINT(*-pro-type-static-cast-downcast)
+                    collectExpression(*n.condition, walk);
+                    collectStatements(n.ifStatements, walk);
+                    collectStatements(n.elseStatements, walk);
+                    break;
+                }
+                case ASTNodeType::WHILE_STATEMENT: {
+                    const auto& n = static_cast<const WhileStatementNode&>(*stmt); // NOLINT(*-pro-type-static-cast-downcast)
+                    collectExpression(*n.condition, walk);
+                    collectStatements(n.body, walk);
+                    break;
+                }
+                case ASTNodeType::DO_STATEMENT:
+                    collectCall(*static_cast<const DoStatementNode&>(*stmt).callExpression, walk); // NOLINT(*-pro-type-static-cast-downcast)
+                    break;
+                case ASTNodeType::RETURN_STATEMENT: {
+                    const auto& n = static_cast<const ReturnStatementNode&>(*stmt); // NOLINT(*-pro-type-static-cast-downcast)
+                    if (n.expression) collectExpression(*n.expression, walk);
+                    break;
+                }
+                default: break;
+            }
+        }
+    }
+
+    void TreeShaker::collectExpression(const ExpressionNode &node, Walk &walk) {
+        static const SymbolId MATH_MULTIPLY = intern("Math.multiply");
+        static const SymbolId MATH_DIVIDE = intern("Math.divide");
+        static const SymbolId STRING_NEW = intern("String.new");
+        static const SymbolId STRING_APPEND_CHAR = intern("String.appendChar");
+
+        switch (node.getType()) {
+            case ASTNodeType::STRING_LITERAL:
+                walk.out.push_back(STRING_NEW);
+                walk.out.push_back(STRING_APPEND_CHAR);
+                break;
+            case ASTNodeType::BINARY_OP: {
+                const auto& n = static_cast<const BinaryOpNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                // Kept even where -O1 folds the operation away: reachability only has to be safe.
+                if (n.op == '*') walk.out.push_back(MATH_MULTIPLY);
+                if (n.op == '/') walk.out.push_back(MATH_DIVIDE);
+                collectExpression(*n.left, walk);
+                collectExpression(*n.right, walk);
+                break;
+            }
+            case ASTNodeType::UNARY_OP:
+                collectExpression(*static_cast<const UnaryOpNode&>(node).term, walk); // NOLINT(*-pro-type-static-cast-downcast)
+                break;
+            case ASTNodeType::SUBROUTINE_CALL:
+                collectCall(static_cast<const CallNode&>(node), walk); // NOLINT(*-pro-type-static-cast-downcast)
+                break;
+            case ASTNodeType::IDENTIFIER: {
+                const auto& n = static_cast<const IdentifierNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
+                if (n.indexExpr) collectExpression(*n.indexExpr, walk);
+                break;
+            }
+            default: break;
+        }
+    }
+
+    void TreeShaker::collectCall(const CallNode &node, Walk &walk) {
+        // Same resolution as CodeGenerator::compileSubroutineCall.
+        SymbolId calleeClass;
+        if (node.classNameOrVar == NO_SYMBOL) {
+            calleeClass = walk.className;
+        } else if (walk.table.kindOf(node.classNameOrVar) != SymbolKind::NONE) {
+            calleeClass = walk.table.typeOf(node.classNameOrVar);
+        } else {
+            calleeClass = node.classNameOrVar;
+        }
+        walk.out.push_back(walk.registry.getSignature(calleeClass, node.functionName).qualifiedName);
+
+        for (const auto& arg : node.arguments) collectExpression(*arg, walk);
+    }
+
+    void TreeShaker::addClass(std::vector<SubroutineCalls> calls) {
+        for (SubroutineCalls& sub : calls) callees[sub.function] = std::move(sub.callees);
+    }
+
+    std::unordered_set<SymbolId> TreeShaker::reachableFrom(const std::vector<SymbolId> &roots) const {
+        std::unordered_set<SymbolId> reached;
+        std::vector<SymbolId> work;
+        for (const SymbolId root : roots) {
+            if (callees.count(root) && reached.insert(root).second) work.push_back(root);
+        }
+        while (!work.empty()) {
+            const SymbolId function = work.back();
+            work.pop_back();
+            for (const SymbolId callee : callees.at(function)) {
+                // Callees outside the program (built-in OS signatures) have no code to keep.
+                if (callees.count(callee) && reached.insert(callee).second) work.push_back(callee);
+            }
+        }
+        return reached;
+    }
+}
@@ -0,0 +1,80 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_TREE_SHAKER_H
+#define NAND2TETRIS_TREE_SHAKER_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../Parser/AST.h"
+#include "../SemanticAnalyser/GlobalRegistry.h"
+#include "../SemanticAnalyser/SymbolTable.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief The subroutines one subroutine may call, by qualified name ("Class.name").
+     */
+    struct SubroutineCalls {
+        SymbolId function = NO_SYMBOL;
+        std::vector<SymbolId> callees;
+    };
+
+    /**
+     * @brief Whole-program dead-subroutine elimination (--tree-shake).
+     *
+     * Calls are resolved exactly as the CodeGenerator resolves them ('obj.f()' through the type of
+     * 'obj' in the symbol table), and include the calls it emits on its own: Memory.alloc in
+     * constructors, Math.multiply / Math.divide for '*' and '/', String.new / String.appendChar
+     * for string literals. Anything not reachable from the roots is never called.
+     */
+    class TreeShaker {
+        public:
+            /**
+             * @brief The call graph edges of one class, whose semantic analysis has completed.
+             *
+             * Independent per class, so the classes can be scanned in parallel.
+             */
+            static std::vector<SubroutineCalls> collectCalls(const ClassNode& node, SymbolTable& table,
+                                                             const GlobalRegistry& registry);
+
+            /**
+             * @brief Adds one class's edges to the whole-program graph.
+             */
+            void addClass(std::vector<SubroutineCalls> calls);
+
+            /**
+             * @brief The subroutines of the added classes reachable from 'roots' (roots included).
+             *
+             * Roots that no added class defines (e.g. Sys.init without os/Sys.jack) are ignored.
+             */
+            std::unordered_set<SymbolId> reachableFrom(const std::vector<SymbolId>& roots) const;
+
+            /**
+             * @brief Number of subroutines in the added classes.
+             */
+            std::size_t size() const { return callees.size(); }
+
+        private:
+            std::unordered_map<SymbolId, std::vector<SymbolId>> callees;
+
+            /**
+             * @brief What a walk over one subroutine body needs, and where it puts the callees.
+             */
+            struct Walk {
+                const SymbolTable& table;
+                const GlobalRegistry& registry;
+                SymbolId className;
+                std::vector<SymbolId>& out;
+            };
+
+            static void collectStatements(const ArenaList<StatementNode*>& stmts, Walk& walk);
+            static void collectExpression(const ExpressionNode& node, Walk& walk);
+            static void collectCall(const CallNode& node, Walk& walk);
+    };
+}
+
+#endif //NAND2TETRIS_TREE_SHAKER_H
@@ -0,0 +1,127 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "OsImage.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace nand2tetris::jack {
+
+    namespace {
+        constexpr std::string_view MAGIC = "JKOS";
+        constexpr std::uint32_t VERSION = 1;
+        constexpr std::size_t HEADER_WORDS = 6;  // magic, version, 3 counts, stringBytes.
+        constexpr std::size_t CLASS_WORDS = 3;
+        constexpr std::size_t METHOD_WORDS = 8;
+
+        void putWord(std::string& out, const std::uint32_t value) {
+            for (int shift = 0; shift < 32; shift += 8) out.push_back(static_cast<char>((value >> shift) & 0xFF));
+        }
+
+        std::uint32_t getWord(const std::string_view image, const std::size_t word) {
+            std::uint32_t value = 0;
+            for (int b = 3; b >= 0; --b) {
+                value = (value << 8) | static_cast<unsigned char>(image[word * 4 + static_cast<std::size_t>(b)]);
+            }
+            return value;
+        }
+
+        [[noreturn]] void throwCorrupt() {
+            throw std::runtime_error("Internal Compiler Error: The built-in OS signature image is corrupt.");
+        }
+    }
+
+    std::string OsImage::build(const GlobalRegistry &registry, const std::vector<SymbolId> &classes) {
+        std::vector<std::uint32_t> classWords, methodWords, paramWords;
+        std::string strings;
+        std::unordered_map<SymbolId, std::uint32_t> offsets; // Each name is stored once.
+        const auto text = [&](const SymbolId id) {
+            const auto [it, added] = offsets.try_emplace(id, static_cast<std::uint32_t>(strings.size()));
+            if (added) strings.append(nameOf(id)).push_back('\0');
+            return it->second;
+        };
+
+        // Sorted by text, so the same OS always gives the same bytes.
+        const auto byText = [](const SymbolId a, const SymbolId b) { return nameOf(a) < nameOf(b); };
+        std::vector<SymbolId> sortedClasses = classes;
+        std::sort(sortedClasses.begin(), sortedClasses.end(), byText);
+
+        std::uint32_t methodCount = 0;
+        for (const SymbolId className : sortedClasses) {
+            std::vector<SymbolId> names = registry.getMethodNames(className);
+            std::sort(names.begin(), names.end(), byText);
+            classWords.insert(classWords.end(), {text(className), methodCount, static_cast<std::uint32_t>(names.size())});
+            for (const SymbolId name : names) {
+                const MethodSignature& sig = registry.getSignature(className, name);
+                methodWords.insert(methodWords.end(), {
+                    text(name), text(sig.qualifiedName), text(sig.returnType),
+                    static_cast<std::uint32_t>(paramWords.size()), static_cast<std::uint32_t>(sig.parameters.size()),
+                    sig.isStatic ? 1u : 0u, static_cast<std::uint32_t>(sig.line), static_cast<std::uint32_t>(sig.column)
+                });
+                for (const SymbolId param : sig.parameters) paramWords.push_back(text(param));
+                ++methodCount;
+            }
+        }
+
+        std::string image(MAGIC);
+        putWord(image, VERSION);
+        putWord(image, static_cast<std::uint32_t>(classes.size()));
+        putWord(image, methodCount);
+        putWord(image, static_cast<std::uint32_t>(paramWords.size()));
+        putWord(image, static_cast<std::uint32_t>(strings.size()));
+        for (const auto* table : {&classWords, &methodWords, &paramWords}) {
+            for (const std::uint32_t word : *table) putWord(image, word);
+        }
+        return image.append(strings);
+    }
+
+    void OsImage::load(const std::string_view image, GlobalRegistry &registry) {
+        if (image.empty()) return; // No built-in OS (the tool that builds the image).
+        if (image.size() < HEADER_WORDS * 4 || image.substr(0, 4) != MAGIC || getWord(image, 1) != VERSION) throwCorrupt();
+
+        const std::size_t classCount = getWord(image, 2);
+        const std::size_t methodCount = getWord(image, 3);
+        const std::size_t paramCount = getWord(image, 4);
+        const std::size_t stringBytes = getWord(image, 5);
+        const std::size_t classBase = HEADER_WORDS;
+        const std::size_t methodBase = classBase + classCount * CLASS_WORDS;
+        const std::size_t paramBase = methodBase + methodCount * METHOD_WORDS;
+        const std::size_t stringBase = (paramBase + paramCount) * 4;
+        if (image.size() != stringBase + stringBytes || (stringBytes > 0 && image.back() != '\0')) throwCorrupt();
+
+        // The last string ends the image, so every in-range offset runs into a terminator.
+        const auto text = [&](const std::uint32_t offset) {
+            if (offset >= stringBytes) throwCorrupt();
+            return intern(std::string_view(image.data() + stringBase + offset));
+        };
+
+        std::vector<SymbolId> params;
+        for (std::size_t c = 0; c < classCount; ++c) {
+            const std::size_t word = classBase + c * CLASS_WORDS;
+            const SymbolId className = text(getWord(image, word));
+            const std::size_t firstMethod = getWord(image, word + 1);
+            const std::size_t classMethods = getWord(image, word + 2);
+            if (firstMethod + classMethods > methodCount) throwCorrupt();
+            registry.registerClass(className);
+
+            for (std::size_t m = firstMethod; m < firstMethod + classMethods; ++m) {
+                const std::size_t at = methodBase + m * METHOD_WORDS;
+                const std::size_t firstParam = getWord(image, at + 3);
+                const std::size_t count = getWord(image, at + 4);
+                if (firstParam + count > paramCount) throwCorrupt();
+                params.clear();
+                for (std::size_t p = firstParam; p < firstParam + count; ++p) params.push_back(text(getWord(image, paramBase + p)));
+
+                registry.registerMethod(className, text(getWord(image, at)), MethodSignature{
+                    text(getWord(image, at + 2)), params, getWord(image, at + 5) != 0,
+                    static_cast<int>(getWord(image, at + 6)), static_cast<int>(getWord(image, at + 7)),
+                    text(getWord(image, at + 1))
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,53 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_OS_IMAGE_H
+#define NAND2TETRIS_OS_IMAGE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../SemanticAnalyser/GlobalRegistry.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief The subroutine signatures of an OS, compiled once into a flat binary image.
+     *
+     * The image is generated at build time from os/*.jack (see OsImageTool.cpp) and compiled into
+     * the binary, so the signatures the compiler knows are exactly those of the OS it ships with.
+     * It holds no pointers, only offsets, and is read in place: it can just as well come from a
+     * memory-mapped file.
+     *
+     * Layout (every field a little-endian u32):
+     *   header  "JKOS", version, classCount, methodCount, paramCount, stringBytes
+     *   classes { name, firstMethod, methodCount }
+     *   methods { name, qualifiedName, returnType, firstParam, paramCount, isStatic, line, column }
+     *   params  { type }
+     *   strings NUL-terminated text; every name above is an offset into it
+     */
+    class OsImage {
+        public:
+            /**
+             * @brief Serializes the signatures of 'classes' as registered in 'registry'.
+             */
+            static std::string build(const GlobalRegistry& registry, const std::vector<SymbolId>& classes);
+
+            /**
+             * @brief Registers every class and signature in an image.
+             *
+             * One pass over the tables: the text is already split and the qualified names built.
+             *
+             * @throws std::runtime_error if the image is malformed.
+             */
+            static void load(std::string_view image, GlobalRegistry& registry);
+    };
+
+    /**
+     * @brief The image of os/*.jack, generated into the build tree.
+     */
+    std::string_view builtinOsImage();
+}
+
+#endif //NAND2TETRIS_OS_IMAGE_H
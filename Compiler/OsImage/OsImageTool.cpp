@@ -0,0 +1,102 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+// jack_osimage: the build step that turns os/*.jack into the compiler's built-in signature image.
+//
+//   jack_osimage <out.cpp | out.img> <os/*.jack...>
+//
+// The OS is parsed and checked with the compiler's own front end. A .cpp output embeds the image
+// as read-only data for builtinOsImage(); anything else gets the raw bytes.
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "OsImage.h"
+#include "../Parser/AstArena.h"
+#include "../Parser/Parser.h"
+#include "../SemanticAnalyser/SemanticAnalyser.h"
+#include "../SemanticAnalyser/SymbolTable.h"
+#include "../Tokenizer/Tokenizer.h"
+
+namespace nand2tetris::jack {
+    // This tool is what produces the image, so it is built without one: its registries start empty
+    // and the OS classes are registered from their sources like any other class.
+    std::string_view builtinOsImage() {
+        return {};
+    }
+}
+
+using namespace nand2tetris::jack;
+
+namespace {
+    std::string toCpp(const std::string_view image) {
+        std::string out =
+            "// Generated by jack_osimage from os/*.jack at build time. Do not edit.\n"
+            "#include \"OsImage/OsImage.h\"\n\n"
+            "namespace nand2tetris::jack {\n"
+            "    namespace {\n"
+            "        alignas(4) const unsigned char IMAGE[] = {";
+        for (std::size_t i = 0; i < image.size(); ++i) {
+            if (i % 16 == 0) out += "\n            ";
+            out += std::to_string(static_cast<unsigned char>(image[i]));
+            out += ',';
+        }
+        out += "\n        };\n"
+               "    }\n\n"
+               "    std::string_view builtinOsImage() {\n"
+               "        return {reinterpret_cast<const char*>(IMAGE), sizeof(IMAGE)};\n"
+               "    }\n"
+               "}\n";
+        return out;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: jack_osimage <out.cpp|out.img> <file.jack>..." << std::endl;
+        return 1;
+    }
+
+    try {
+        struct Unit {
+            std::unique_ptr<Tokenizer> tokenizer;
+            std::unique_ptr<AstArena> arena;
+            ClassNode* ast = nullptr;
+        };
+        GlobalRegistry registry;
+        // Sys.init calls Main.main: the program the OS will run, declared here as every program must declare it.
+        registry.registerClass(intern("Main"));
+        registry.registerMethod(intern("Main"), intern("main"), sym::VOID, {}, true, 0, 0);
+        std::vector<Unit> units;
+        for (int i = 2; i < argc; ++i) {
+            Unit unit{std::make_unique<Tokenizer>(argv[i]), std::make_unique<AstArena>()};
+            Parser parser(*unit.tokenizer, registry, *unit.arena);
+            unit.ast = parser.parse();
+            units.push_back(std::move(unit));
+        }
+        registry.freeze();
+
+        // A broken OS fails the build here, not in every program that uses it.
+        std::vector<SymbolId> classes;
+        for (const Unit& unit : units) {
+            SymbolTable table;
+            SemanticAnalyser(registry).analyseClass(*unit.ast, table);
+            classes.push_back(unit.ast->getClassSymbol());
+        }
+
+        const std::string image = OsImage::build(registry, classes);
+        const std::string outPath = argv[1];
+        const bool cpp = outPath.size() > 4 && outPath.compare(outPath.size() - 4, 4, ".cpp") == 0;
+        std::ofstream out(outPath, std::ios::binary);
+        out << (cpp ? toCpp(image) : image);
+        if (!out) throw std::runtime_error("Could not write " + outPath);
+    } catch (const std::exception& e) {
+        std::cerr << "jack_osimage: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
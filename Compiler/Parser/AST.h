@@ -7,10 +7,11 @@
 
 #include <string>
 #include <utility>
-#include <vector>
-#include <memory>
 #include<iostream>
 #include "../Tokenizer/TokenTypes.h"
+#include "../Interner/StringInterner.h"
+#include "AstArena.h"
+#include "../Stats/Stats.h"
 
 namespace nand2tetris::jack {
 
@@ -46,9 +47,9 @@ namespace nand2tetris::jack {
     /**
      * @brief Base class for all nodes in the Abstract Syntax Tree (AST).
      *
-     * All specific AST nodes inherit from this class. It provides a virtual destructor
-     * to ensure proper cleanup of derived classes. It also stores the location (line, column)
-     * of the node in the source code for error reporting.
+     * All specific AST nodes inherit from this class. Nodes are allocated in, and owned by, the
+     * compilation unit's AstArena; children are referenced by plain pointers and ArenaLists.
+     * It also stores the location (line, column) of the node in the source code for error reporting.
      */
     class Node {
         public:
@@ -59,8 +60,13 @@ namespace nand2tetris::jack {
              * @param l The line number in the source code.
              * @param c The column number in the source code.
              */
-            explicit Node(const ASTNodeType nodeType, const int l, const int c):nodeType(nodeType),line(l),column(c){};
-            virtual ~Node() = default;
+            explicit Node(const ASTNodeType nodeType, const int l, const int c):nodeType(nodeType),line(l),column(c){
+                JACK_STAT_AT(astNodes, nodeType);
+            }
+
+            // Nodes live in an AstArena, which never runs destructors, so every node type must stay
+            // trivially destructible (plain views, ints, SymbolIds, node pointers and ArenaLists only).
+            ~Node() = default;
 
             /**
              * @brief Prints the XML representation of the AST node.
@@ -111,24 +117,25 @@ namespace nand2tetris::jack {
     class ClassVarDecNode final : public Node {
         protected:
             ClassVarKind kind; ///< The kind of variable (static or field).
-            std::string_view type; ///< The data type of the variable(s) (e.g., "int", "boolean", "MyClass").
-            std::vector<std::string_view> varNames; ///< A list of variable names declared in this statement.
+            SymbolId type; ///< The data type of the variable(s) (e.g., "int", "boolean", "MyClass").
+            ArenaList<SymbolId> varNames; ///< A list of variable names declared in this statement.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class Inliner;
         public:
             /**
              * @brief Constructs a ClassVarDecNode.
              *
              * @param k The kind of variable.
              * @param t The type of the variable.
-             * @param names A vector of variable names.
+             * @param names The list of variable names.
              * @param l the line on source code.
              * @param c the column on source code.
              */
-            ClassVarDecNode(const ClassVarKind k, const std::string_view t, std::vector<std::string_view> names, const int
+            ClassVarDecNode(const ClassVarKind k, const SymbolId t, ArenaList<SymbolId> names, const int
                 l, const int c)
-                :Node(ASTNodeType::CLASS_VAR_DEC,l,c),kind(k),type(t), varNames(std::move(names)) {};
-            ~ClassVarDecNode() override = default;
+                :Node(ASTNodeType::CLASS_VAR_DEC,l,c),kind(k),type(t), varNames(names) {};
 
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
@@ -136,15 +143,15 @@ namespace nand2tetris::jack {
 
                 out << sp << "  <keyword> " << (kind == ClassVarKind::STATIC ? "static" : "field") << " </keyword>\n";
 
-                if (type == "int" || type == "char" || type == "boolean") {
-                    out << sp << "  <keyword> " << type << " </keyword>\n";
+                if (type == sym::INT || type == sym::CHAR || type == sym::BOOLEAN) {
+                    out << sp << "  <keyword> " << nameOf(type) << " </keyword>\n";
                 } else {
-                    out << sp << "  <identifier> " << type << " </identifier>\n";
+                    out << sp << "  <identifier> " << nameOf(type) << " </identifier>\n";
                 }
 
 
                 for (size_t i = 0; i < varNames.size(); ++i) {
-                    out << sp << "  <identifier> " << varNames[i] << " </identifier>\n";
+                    out << sp << "  <identifier> " << nameOf(varNames[i]) << " </identifier>\n";
                     if (i < varNames.size() - 1) out << sp << "  <symbol> , </symbol>\n";
                 }
                 out << sp << "  <symbol> ; </symbol>\n";
@@ -159,22 +166,22 @@ namespace nand2tetris::jack {
      */
     class VarDecNode final : public Node {
         protected:
-            std::string_view type; ///< The data type of the variable(s).
-            std::vector<std::string_view> varNames; ///< A list of variable names declared.
+            SymbolId type; ///< The data type of the variable(s).
+            ArenaList<SymbolId> varNames; ///< A list of variable names declared.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
         public:
             /**
              * @brief Constructs a VarDecNode.
              *
              * @param t The type of the variable.
-             * @param names A vector of variable names.
+             * @param names The list of variable names.
              * @param l The line number.
              * @param c The column number.
              */
-            VarDecNode(const std::string_view t, std::vector<std::string_view> names, const int l, const int c)
-                : Node(ASTNodeType::VAR_DEC,l,c),type(t), varNames(std::move(names)) {};
-            ~VarDecNode() override = default;
+            VarDecNode(const SymbolId t, ArenaList<SymbolId> names, const int l, const int c)
+                : Node(ASTNodeType::VAR_DEC,l,c),type(t), varNames(names) {};
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
 
@@ -187,15 +194,15 @@ namespace nand2tetris::jack {
 
                 // The type (int, char, boolean, or className)
                 // We treat the type as a keyword if it's a primitive, or an identifier if it's a class.
-                if (type == "int" || type == "char" || type == "boolean") {
-                    out << sp << "  <keyword> " << type << " </keyword>\n";
+                if (type == sym::INT || type == sym::CHAR || type == sym::BOOLEAN) {
+                    out << sp << "  <keyword> " << nameOf(type) << " </keyword>\n";
                 } else {
-                    out << sp << "  <identifier> " << type << " </identifier>\n";
+                    out << sp << "  <identifier> " << nameOf(type) << " </identifier>\n";
                 }
 
                 // List of variable names separated by commas
                 for (size_t i = 0; i < varNames.size(); ++i) {
-                    out << sp << "  <identifier> " << varNames[i] << " </identifier>\n";
+                    out << sp << "  <identifier> " << nameOf(varNames[i]) << " </identifier>\n";
 
                     // Output a comma symbol if there are more names in the list
                     if (i < varNames.size() - 1) {
@@ -225,8 +232,8 @@ namespace nand2tetris::jack {
      * Example: `int x` in `function void foo(int x)`
      */
     struct Parameter {
-        std::string_view type; ///< The data type of the parameter.
-        std::string_view name; ///< The name of the parameter.
+        SymbolId type; ///< The data type of the parameter.
+        SymbolId name; ///< The name of the parameter.
     };
 
     /**
@@ -240,7 +247,6 @@ namespace nand2tetris::jack {
             friend class CodeGenerator;
         public:
             explicit StatementNode(const ASTNodeType nodeType,const int l, const int c):Node(nodeType,l,c){};
-            ~StatementNode() override = default;
     };
 
     /**
@@ -254,7 +260,6 @@ namespace nand2tetris::jack {
             friend class CodeGenerator;
         public:
             explicit ExpressionNode(const ASTNodeType nodeType,const int l, const int c):Node(nodeType,l,c){};
-            ~ExpressionNode() override = default;
     };
 
     /**
@@ -267,6 +272,8 @@ namespace nand2tetris::jack {
             int value; ///< The integer value.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class ConstantFolder;
         public:
             /**
              * @brief Constructs an IntegerLiteralNode.
@@ -275,7 +282,6 @@ namespace nand2tetris::jack {
              * @param c The column number.
              */
             explicit IntegerLiteralNode(const int val,const int l, const int c) : ExpressionNode(ASTNodeType::INTEGER_LITERAL,l,c),value(val) {}
-            ~IntegerLiteralNode() override = default;
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
                 out << sp << "<term>\n";  // Add Wrapper
@@ -294,6 +300,8 @@ namespace nand2tetris::jack {
             std::string_view value; ///< The string value (without quotes).
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class StringPool;
         public:
             /**
              * @brief Constructs a StringLiteralNode.
@@ -302,7 +310,6 @@ namespace nand2tetris::jack {
              * @param c The column number.
              */
             explicit StringLiteralNode(const std::string_view val,const int l, const int c) : ExpressionNode(ASTNodeType::STRING_LITERAL,l,c),value(val) {}
-            ~StringLiteralNode() override = default;
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
                 out << sp << "<term>\n";  // Add Wrapper
@@ -321,6 +328,9 @@ namespace nand2tetris::jack {
             Keyword value; ///< The keyword value.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class ConstantFolder;
+            friend class Inliner;
         public:
             /**
              * @brief Constructs a KeywordLiteralNode.
@@ -368,11 +378,17 @@ namespace nand2tetris::jack {
      */
     class BinaryOpNode final : public ExpressionNode {
         protected:
-            std::unique_ptr<ExpressionNode> left; ///< The left operand.
+            ExpressionNode* left; ///< The left operand.
             char op; ///< The operator symbol ('+', '-', '*', '/', '&', '|', '<', '>', '=').
-            std::unique_ptr<ExpressionNode> right; ///< The right operand.
+            ExpressionNode* right; ///< The right operand.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class TreeShaker;
+            friend class StringPool;
+            friend class Inliner;
+            friend class ConstantFolder;
+            friend class StrengthReducer;
         public:
             /**
              * @brief Constructs a BinaryOpNode.
@@ -382,10 +398,9 @@ namespace nand2tetris::jack {
              * @param line The line number.
              * @param column The column number.
              */
-            BinaryOpNode(std::unique_ptr<ExpressionNode> l, const char o, std::unique_ptr<ExpressionNode> r,const int
+            BinaryOpNode(ExpressionNode* l, const char o, ExpressionNode* r,const int
                 line, const int column)
-                : ExpressionNode(ASTNodeType::BINARY_OP,line, column),left(std::move(l)), op(o), right(std::move(r)) {}
-            ~BinaryOpNode() override = default;
+                : ExpressionNode(ASTNodeType::BINARY_OP,line, column),left(l), op(o), right(r) {}
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
                 // Left Term
@@ -409,9 +424,15 @@ namespace nand2tetris::jack {
     class UnaryOpNode final : public ExpressionNode {
         protected:
             char op; ///< The operator symbol ('-', '~').
-            std::unique_ptr<ExpressionNode> term; ///< The operand.
+            ExpressionNode* term; ///< The operand.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class TreeShaker;
+            friend class StringPool;
+            friend class Inliner;
+            friend class ConstantFolder;
+            friend class StrengthReducer;
         public:
             /**
              * @brief Constructs a UnaryOpNode.
@@ -420,9 +441,8 @@ namespace nand2tetris::jack {
              * @param line The line number.
              * @param column The column number.
              */
-            UnaryOpNode(const char o, std::unique_ptr<ExpressionNode> t,const int line, const int column)
-                : ExpressionNode(ASTNodeType::UNARY_OP,line, column),op(o), term(std::move(t)) {}
-            ~UnaryOpNode() override = default;
+            UnaryOpNode(const char o, ExpressionNode* t,const int line, const int column)
+                : ExpressionNode(ASTNodeType::UNARY_OP,line, column),op(o), term(t) {}
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
                 out << sp << "<term>\n";
@@ -441,24 +461,27 @@ namespace nand2tetris::jack {
      */
     class CallNode final : public ExpressionNode {
         protected:
-            std::string_view classNameOrVar; ///< The class name or variable name (optional). Empty if implicit `this`.
-            std::string_view functionName;   ///< The name of the subroutine being called.
-            std::vector<std::unique_ptr<ExpressionNode>> arguments; ///< The list of arguments passed to the call.
+            SymbolId classNameOrVar; ///< The class name or variable name (optional). NO_SYMBOL if implicit `this`.
+            SymbolId functionName;   ///< The name of the subroutine being called.
+            ArenaList<ExpressionNode*> arguments; ///< The list of arguments passed to the call.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class TreeShaker;
+            friend class StringPool;
+            friend class Inliner;
         public:
             /**
              * @brief Constructs a CallNode.
-             * @param cv The class or variable name (can be empty).
+             * @param cv The class or variable name (can be NO_SYMBOL).
              * @param fn The function name.
              * @param args The arguments.
              * @param l The line number.
              * @param c The column number.
              */
-            CallNode(const std::string_view cv, const std::string_view fn,
-                std::vector<std::unique_ptr<ExpressionNode>> args,const int l,const int c)
-                : ExpressionNode(ASTNodeType::SUBROUTINE_CALL,l,c),classNameOrVar(cv), functionName(fn), arguments(std::move(args)) {}
-            ~CallNode() override = default;
+            CallNode(const SymbolId cv, const SymbolId fn,
+                ArenaList<ExpressionNode*> args,const int l,const int c)
+                : ExpressionNode(ASTNodeType::SUBROUTINE_CALL,l,c),classNameOrVar(cv), functionName(fn), arguments(args) {}
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
                 out << sp << "<term>\n";
@@ -468,11 +491,11 @@ namespace nand2tetris::jack {
 
             void printRaw(std::ostream& out, const int indent) const {
                 const std::string sp(indent, ' ');
-                if (!classNameOrVar.empty()) {
-                    out << sp << "<identifier> " << classNameOrVar << " </identifier>\n";
+                if (classNameOrVar != NO_SYMBOL) {
+                    out << sp << "<identifier> " << nameOf(classNameOrVar) << " </identifier>\n";
                     out << sp << "<symbol> . </symbol>\n";
                 }
-                out << sp << "<identifier> " << functionName << " </identifier>\n";
+                out << sp << "<identifier> " << nameOf(functionName) << " </identifier>\n";
                 out << sp << "<symbol> ( </symbol>\n";
                 out << sp << "<expressionList>\n";
                 for (size_t i = 0; i < arguments.size(); ++i) {
@@ -495,10 +518,15 @@ namespace nand2tetris::jack {
      */
     class IdentifierNode final : public ExpressionNode {
         protected:
-            std::string_view name; ///< The name of the identifier.
-            std::unique_ptr<ExpressionNode> indexExpr; ///< The index expression if it's an array access, otherwise nullptr.
+            SymbolId name; ///< The name of the identifier.
+            ExpressionNode* indexExpr; ///< The index expression if it's an array access, otherwise nullptr.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class TreeShaker;
+            friend class StringPool;
+            friend class Inliner;
+            friend class StrengthReducer;
         public:
             /**
              * @brief Constructs an IdentifierNode.
@@ -507,14 +535,13 @@ namespace nand2tetris::jack {
              * @param c The column number.
              * @param idx The index expression (optional).
              */
-        explicit IdentifierNode(const std::string_view n,const int l, const int c,std::unique_ptr<ExpressionNode> idx = nullptr)
-                : ExpressionNode(ASTNodeType::IDENTIFIER,l,c) ,name(n), indexExpr(std::move(idx)) {}
-            ~IdentifierNode() override = default;
+        explicit IdentifierNode(const SymbolId n,const int l, const int c,ExpressionNode* idx = nullptr)
+                : ExpressionNode(ASTNodeType::IDENTIFIER,l,c) ,name(n), indexExpr(idx) {}
             void printXml(std::ostream& out, const int indent) const override {
 
                 const std::string sp(indent, ' ');
                 out << sp << "<term>\n";  // Add Wrapper
-                out << sp << "  <identifier> " << name << " </identifier>\n";
+                out << sp << "  <identifier> " << nameOf(name) << " </identifier>\n";
                 if (indexExpr) {
                     out << sp << "  <symbol> [ </symbol>\n";
                     out << sp << "  <expression>\n";
@@ -533,11 +560,15 @@ namespace nand2tetris::jack {
      */
     class LetStatementNode final : public StatementNode {
         protected:
-            std::string_view varName; ///< The name of the variable being assigned to.
-            std::unique_ptr<ExpressionNode> indexExpr; ///< The index expression for array assignment (optional).
-            std::unique_ptr<ExpressionNode> valueExpr; ///< The expression evaluating to the new value.
+            SymbolId varName; ///< The name of the variable being assigned to.
+            ExpressionNode* indexExpr; ///< The index expression for array assignment (optional).
+            ExpressionNode* valueExpr; ///< The expression evaluating to the new value.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class TreeShaker;
+            friend class StringPool;
+            friend class Inliner;
         public:
             /**
              * @brief Constructs a LetStatementNode.
@@ -547,15 +578,14 @@ namespace nand2tetris::jack {
              * @param l The line number.
              * @param c The column number.
              */
-            LetStatementNode(const std::string_view name, std::unique_ptr<ExpressionNode> idx,
-                             std::unique_ptr<ExpressionNode> val,const int l, const int c)
-                : StatementNode(ASTNodeType::LET_STATEMENT,l,c) ,varName(name), indexExpr(std::move(idx)), valueExpr(std::move(val)) {}
-            ~LetStatementNode() override = default;
+            LetStatementNode(const SymbolId name, ExpressionNode* idx,
+                             ExpressionNode* val,const int l, const int c)
+                : StatementNode(ASTNodeType::LET_STATEMENT,l,c) ,varName(name), indexExpr(idx), valueExpr(val) {}
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
                 out << sp << "<letStatement>\n";
                 out << sp << "  <keyword> let </keyword>\n";
-                out << sp << "  <identifier> " << varName << " </identifier>\n";
+                out << sp << "  <identifier> " << nameOf(varName) << " </identifier>\n";
 
                 if (indexExpr) {
                     out << sp << "  <symbol> [ </symbol>\n";
@@ -581,11 +611,15 @@ namespace nand2tetris::jack {
      */
     class IfStatementNode final : public StatementNode {
         protected:
-            std::unique_ptr<ExpressionNode> condition; ///< The condition expression.
-            std::vector<std::unique_ptr<StatementNode>> ifStatements; ///< The statements to execute if true.
-            std::vector<std::unique_ptr<StatementNode>> elseStatements; ///< The statements to execute if false (optional).
+            ExpressionNode* condition; ///< The condition expression.
+            ArenaList<StatementNode*> ifStatements; ///< The statements to execute if true.
+            ArenaList<StatementNode*> elseStatements; ///< The statements to execute if false (optional).
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class TreeShaker;
+            friend class StringPool;
+            friend class Inliner;
         public:
             /**
              * @brief Constructs an IfStatementNode.
@@ -595,11 +629,10 @@ namespace nand2tetris::jack {
              * @param l The line number.
              * @param c The column number.
              */
-            IfStatementNode(std::unique_ptr<ExpressionNode> cond, std::vector<std::unique_ptr<StatementNode>> ifStmts,
-                            std::vector<std::unique_ptr<StatementNode>> elseStmts,const int l, const int c)
-                : StatementNode(ASTNodeType::IF_STATEMENT,l,c) ,condition(std::move(cond)), ifStatements(std::move(ifStmts)),
-                elseStatements(std::move(elseStmts)){};
-            ~IfStatementNode() override = default;
+            IfStatementNode(ExpressionNode* cond, ArenaList<StatementNode*> ifStmts,
+                            ArenaList<StatementNode*> elseStmts,const int l, const int c)
+                : StatementNode(ASTNodeType::IF_STATEMENT,l,c) ,condition(cond), ifStatements(ifStmts),
+                elseStatements(elseStmts){};
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
                 out << sp << "<ifStatement>\n";
@@ -635,10 +668,14 @@ namespace nand2tetris::jack {
      */
     class WhileStatementNode final : public StatementNode {
         protected:
-            std::unique_ptr<ExpressionNode> condition; ///< The loop condition.
-            std::vector<std::unique_ptr<StatementNode>> body; ///< The loop body statements.
+            ExpressionNode* condition; ///< The loop condition.
+            ArenaList<StatementNode*> body; ///< The loop body statements.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class TreeShaker;
+            friend class StringPool;
+            friend class Inliner;
         public:
             /**
              * @brief Constructs a WhileStatementNode.
@@ -647,10 +684,9 @@ namespace nand2tetris::jack {
              * @param l The line number.
              * @param c The column number.
              */
-            WhileStatementNode(std::unique_ptr<ExpressionNode> cond, std::vector<std::unique_ptr<StatementNode>> b,
+            WhileStatementNode(ExpressionNode* cond, ArenaList<StatementNode*> b,
                 const int l,const int c)
-                : StatementNode(ASTNodeType::WHILE_STATEMENT,l,c),condition(std::move(cond)), body(std::move(b)) {}
-            ~WhileStatementNode() override = default;
+                : StatementNode(ASTNodeType::WHILE_STATEMENT,l,c),condition(cond), body(b) {}
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
                 out << sp << "<whileStatement>\n";
@@ -678,9 +714,13 @@ namespace nand2tetris::jack {
      */
     class DoStatementNode final : public StatementNode {
         protected:
-            std::unique_ptr<CallNode> callExpression; ///< The subroutine call expression.
+            CallNode* callExpression; ///< The subroutine call expression.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class TreeShaker;
+            friend class StringPool;
+            friend class Inliner;
         public:
             /**
              * @brief Constructs a DoStatementNode.
@@ -688,9 +728,8 @@ namespace nand2tetris::jack {
              * @param l The line number.
              * @param c The column number.
              */
-            explicit DoStatementNode(std::unique_ptr<CallNode> call,const int l, const int c) : StatementNode(ASTNodeType::DO_STATEMENT,l,c),
-                callExpression(std::move(call)){};
-            ~DoStatementNode() override = default;
+            explicit DoStatementNode(CallNode* call,const int l, const int c) : StatementNode(ASTNodeType::DO_STATEMENT,l,c),
+                callExpression(call){};
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
                 out << sp << "<doStatement>\n";
@@ -711,9 +750,13 @@ namespace nand2tetris::jack {
      */
     class ReturnStatementNode final : public StatementNode {
         protected:
-            std::unique_ptr<ExpressionNode> expression; ///< The return value expression (optional).
+            ExpressionNode* expression; ///< The return value expression (optional).
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class TreeShaker;
+            friend class StringPool;
+            friend class Inliner;
 
         public:
             /**
@@ -722,9 +765,8 @@ namespace nand2tetris::jack {
              * @param l The line number.
              * @param c The column number.
              */
-            explicit ReturnStatementNode(std::unique_ptr<ExpressionNode> expr,const int l,const int c) : StatementNode
-                (ASTNodeType::RETURN_STATEMENT,l,c), expression(std::move(expr)) {}
-            ~ReturnStatementNode() override = default;
+            explicit ReturnStatementNode(ExpressionNode* expr,const int l,const int c) : StatementNode
+                (ASTNodeType::RETURN_STATEMENT,l,c), expression(expr) {}
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
                 out << sp << "<returnStatement>\n";
@@ -747,14 +789,18 @@ namespace nand2tetris::jack {
     class SubroutineDecNode final : public Node {
         protected:
             SubroutineType subType; ///< The type of subroutine (constructor, function, method).
-            std::string_view returnType; ///< The return type (e.g., "void", "int", "MyClass").
-            std::string_view name; ///< The name of the subroutine.
-            std::vector<Parameter> parameters; ///< The list of parameters.
+            SymbolId returnType; ///< The return type (e.g., "void", "int", "MyClass").
+            SymbolId name; ///< The name of the subroutine.
+            ArenaList<Parameter> parameters; ///< The list of parameters.
 
-            std::vector<std::unique_ptr<VarDecNode>> localVars; ///< The local variable declarations.
-            std::vector<std::unique_ptr<StatementNode>> statements; ///< The body statements.
+            ArenaList<VarDecNode*> localVars; ///< The local variable declarations.
+            ArenaList<StatementNode*> statements; ///< The body statements.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class TreeShaker;
+            friend class StringPool;
+            friend class Inliner;
 
         public:
             /**
@@ -768,14 +814,11 @@ namespace nand2tetris::jack {
              * @param l The line number.
              * @param c The column number.
              */
-            SubroutineDecNode(const SubroutineType st, const std::string_view ret, const std::string_view n,
-                std::vector<Parameter> parameters, std::vector<std::unique_ptr<VarDecNode>> vars,
-                std::vector<std::unique_ptr<StatementNode>> stmts,const int l, const int c)
-                : Node(ASTNodeType::SUBROUTINE_DEC,l,c),subType(st), returnType(ret), name(n),parameters(std::move
-                    (parameters)),localVars(std::move
-                    (vars)),statements(std::move(stmts)) {};
+            SubroutineDecNode(const SubroutineType st, const SymbolId ret, const SymbolId n,
+                ArenaList<Parameter> parameters, ArenaList<VarDecNode*> vars,
+                ArenaList<StatementNode*> stmts,const int l, const int c)
+                : Node(ASTNodeType::SUBROUTINE_DEC,l,c),subType(st), returnType(ret), name(n),parameters(parameters),localVars(vars),statements(stmts) {};
 
-            ~SubroutineDecNode() override = default;
 
             void printXml(std::ostream& out, const int indent) const override {
                 const std::string sp(indent, ' ');
@@ -783,22 +826,22 @@ namespace nand2tetris::jack {
                 const std::string typeStr = (subType == SubroutineType::CONSTRUCTOR ? "constructor" :
                                       (subType == SubroutineType::FUNCTION ? "function" : "method"));
                 out << sp << "  <keyword> " << typeStr << " </keyword>\n";
-                if (returnType == "int" || returnType == "void" || returnType == "boolean" || returnType == "char") {
-                    out << sp << "  <keyword> " << returnType << " </keyword>\n";
+                if (returnType == sym::INT || returnType == sym::VOID || returnType == sym::BOOLEAN || returnType == sym::CHAR) {
+                    out << sp << "  <keyword> " << nameOf(returnType) << " </keyword>\n";
                 } else {
-                    out << sp << "  <identifier> " << returnType << " </identifier>\n";
+                    out << sp << "  <identifier> " << nameOf(returnType) << " </identifier>\n";
                 }
 
-                out << sp << "  <identifier> " << name << " </identifier>\n";
+                out << sp << "  <identifier> " << nameOf(name) << " </identifier>\n";
                 out << sp << "  <symbol> ( </symbol>\n";
                 out << sp << "  <parameterList>\n";
                 for (size_t i = 0; i < parameters.size(); ++i) {
-                    if (parameters[i].type=="int"||parameters[i].type=="boolean"||parameters[i].type=="char") {
-                        out<< sp << "  <keyword>"<<parameters[i].type<<" </keyword>\n";
+                    if (parameters[i].type==sym::INT||parameters[i].type==sym::BOOLEAN||parameters[i].type==sym::CHAR) {
+                        out<< sp << "  <keyword>"<<nameOf(parameters[i].type)<<" </keyword>\n";
                     }else {
-                        out << sp << "  <identifier> " << parameters[i].type << " </identifier>\n";
+                        out << sp << "  <identifier> " << nameOf(parameters[i].type) << " </identifier>\n";
                     }
-                    out << sp << "    <identifier> " << parameters[i].name << " </identifier>\n";
+                    out << sp << "    <identifier> " << nameOf(parameters[i].name) << " </identifier>\n";
                     if (i < parameters.size() - 1) out << sp << "    <symbol> , </symbol>\n";
                 }
                 out << sp << "  </parameterList>\n";
@@ -822,11 +865,15 @@ namespace nand2tetris::jack {
      */
     class ClassNode final : public Node {
         protected:
-            std::string_view className; ///< The name of the class.
-            std::vector<std::unique_ptr<ClassVarDecNode>> classVars; ///< The class-level variable declarations.
-            std::vector<std::unique_ptr<SubroutineDecNode>> subroutineDecs; ///< The subroutine declarations.
+            SymbolId className; ///< The name of the class.
+            ArenaList<ClassVarDecNode*> classVars; ///< The class-level variable declarations.
+            ArenaList<SubroutineDecNode*> subroutineDecs; ///< The subroutine declarations.
             friend class SemanticAnalyser;
             friend class CodeGenerator;
+            friend class AstExport;
+            friend class TreeShaker;
+            friend class StringPool;
+            friend class Inliner;
         public:
             /**
              * @brief Constructs a ClassNode.
@@ -836,22 +883,22 @@ namespace nand2tetris::jack {
              * @param l The line number.
              * @param c The column number.
              */
-            explicit ClassNode(const std::string_view className,std::vector<std::unique_ptr<ClassVarDecNode>>
-                classVars,std::vector<std::unique_ptr<SubroutineDecNode>> subroutineDecs,const int l, const int c) :
+            explicit ClassNode(const SymbolId className,ArenaList<ClassVarDecNode*>
+                classVars,ArenaList<SubroutineDecNode*> subroutineDecs,const int l, const int c) :
                 Node(ASTNodeType::CLASS,l,c),className(className),
-                classVars(std::move(classVars)), subroutineDecs(std::move(subroutineDecs)) {};
-            ~ClassNode() override = default;
+                classVars(classVars), subroutineDecs(subroutineDecs) {};
             void printXml(std::ostream& out, int indent)const override {
                 out << "<class>\n";
                 out << "  <keyword> class </keyword>\n";
-                out << "  <identifier> " << className << " </identifier>\n";
+                out << "  <identifier> " << nameOf(className) << " </identifier>\n";
                 out << "  <symbol> { </symbol>\n";
                 for (const auto& var : classVars) var->printXml(out, 2);
                 for (const auto& sub : subroutineDecs) sub->printXml(out, 2);
                 out << "  <symbol> } </symbol>\n";
                 out << "</class>\n";
             }
-            std::string_view getClassName()const { return className; }
+            std::string_view getClassName()const { return nameOf(className); }
+            SymbolId getClassSymbol()const { return className; }
             std::size_t get_Number_of_Subroutines()const {return subroutineDecs.size();}
             std::size_t get_Number_of_classVars() const {return classVars.size();}
 
@@ -0,0 +1,34 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "AstArena.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace nand2tetris::jack {
+
+    void* AstArena::allocate(const std::size_t size, const std::size_t align) {
+        // Fast path: bump the cursor inside the current block.
+        auto current = reinterpret_cast<std::uintptr_t>(cursor);
+        std::uintptr_t aligned = (current + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+        if (cursor && aligned + size <= reinterpret_cast<std::uintptr_t>(limit)) {
+            cursor = reinterpret_cast<std::byte*>(aligned + size);
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        // Slow path: open a new block. Oversized requests get a block of their own.
+        const std::size_t blockSize = std::max(nextBlockSize, size + align);
+        blocks.emplace_back(new std::byte[blockSize]); // Deliberately uninitialised.
+        bytesReserved += blockSize;
+        nextBlockSize = std::min(nextBlockSize * 2, MAX_BLOCK_SIZE);
+
+        cursor = blocks.back().get();
+        limit = cursor + blockSize;
+
+        current = reinterpret_cast<std::uintptr_t>(cursor);
+        aligned = (current + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+        cursor = reinterpret_cast<std::byte*>(aligned + size);
+        return reinterpret_cast<void*>(aligned);
+    }
+}
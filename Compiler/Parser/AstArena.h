@@ -0,0 +1,115 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_AST_ARENA_H
+#define NAND2TETRIS_AST_ARENA_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief A read-only, arena-backed array (pointer + length).
+     *
+     * Used for every child list in the AST (statements, arguments, variable names, ...).
+     * It is trivially destructible, so nodes that hold one never need their destructor run.
+     *
+     * @tparam T The element type.
+     */
+    template <typename T>
+    class ArenaList {
+        public:
+            ArenaList() = default;
+            ArenaList(T* data, const std::size_t count) : items(data), count(count) {}
+
+            const T* begin() const { return items; }
+            const T* end() const { return items + count; }
+            std::size_t size() const { return count; }
+            bool empty() const { return count == 0; }
+            const T& operator[](const std::size_t i) const { return items[i]; }
+
+        private:
+            T* items = nullptr;    ///< First element (nullptr when empty).
+            std::size_t count = 0; ///< Number of elements.
+    };
+
+    /**
+     * @brief A bump allocator that owns every node of one compilation unit's AST.
+     *
+     * Nodes are placement-constructed into large contiguous blocks, in the order the Parser creates
+     * them, so SemanticAnalyser and CodeGenerator traversals walk mostly-sequential memory.
+     * Nothing is ever freed individually: destroying the arena releases a handful of blocks, with
+     * no per-node destructor calls. To make that safe, only trivially destructible types may be
+     * allocated (enforced at compile time); child lists are copied in as ArenaList.
+     */
+    class AstArena {
+        public:
+            AstArena() = default;
+            AstArena(const AstArena&) = delete;
+            AstArena& operator=(const AstArena&) = delete;
+
+            /**
+             * @brief Constructs a T inside the arena.
+             *
+             * @return A pointer that stays valid for the arena's lifetime.
+             */
+            template <typename T, typename... Args>
+            T* make(Args&&... args) {
+                static_assert(std::is_trivially_destructible_v<T>,
+                              "AstArena never runs destructors; arena types must be trivially destructible");
+                void* mem = allocate(sizeof(T), alignof(T));
+                ++objectCount;
+                return ::new (mem) T(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Copies a temporary vector into arena storage.
+             *
+             * @param items The elements to copy (usually a Parser scratch vector).
+             * @return An ArenaList viewing the copied elements.
+             */
+            template <typename T>
+            ArenaList<T> copyList(const std::vector<T>& items) {
+                static_assert(std::is_trivially_copyable_v<T>, "ArenaList elements must be trivially copyable");
+                if (items.empty()) return {};
+                void* mem = allocate(sizeof(T) * items.size(), alignof(T));
+                std::memcpy(mem, items.data(), sizeof(T) * items.size());
+                return {static_cast<T*>(mem), items.size()};
+            }
+
+            /**
+             * @brief Number of objects constructed with make().
+             */
+            std::size_t getObjectCount() const { return objectCount; }
+
+            /**
+             * @brief Total bytes reserved from the system across all blocks.
+             */
+            std::size_t getBytesReserved() const { return bytesReserved; }
+
+        private:
+            static constexpr std::size_t FIRST_BLOCK_SIZE = 16 * 1024; ///< Enough for a small class.
+            static constexpr std::size_t MAX_BLOCK_SIZE = 1024 * 1024; ///< Growth stops doubling here.
+
+            std::vector<std::unique_ptr<std::byte[]>> blocks; ///< Every block handed out so far.
+            std::byte* cursor = nullptr;    ///< Next free byte in the current block.
+            std::byte* limit = nullptr;     ///< One past the end of the current block.
+            std::size_t nextBlockSize = FIRST_BLOCK_SIZE;
+            std::size_t bytesReserved = 0;
+            std::size_t objectCount = 0;
+
+            /**
+             * @brief Returns 'size' bytes aligned to 'align', opening a new block if needed.
+             */
+            void* allocate(std::size_t size, std::size_t align);
+    };
+}
+
+#endif //NAND2TETRIS_AST_ARENA_H
@@ -6,28 +6,61 @@
 #include "AST.h"
 #include "../Tokenizer/Tokenizer.h"
 #include "../SemanticAnalyser/GlobalRegistry.h"
+#include "../Trace/Trace.h"
 #include <filesystem>
 namespace fs = std::filesystem;
 
 namespace nand2tetris::jack {
-    Parser::Parser(Tokenizer &tokenizer, GlobalRegistry& registry):tokenizer(tokenizer),globalRegistry(registry) {
+    Parser::Parser(Tokenizer &tokenizer, GlobalRegistry& registry, AstArena& arena, DiagnosticSink* diagnostics):tokenizer(tokenizer),
+    globalRegistry(registry),arena(arena),diagnostics(diagnostics) {
         // Initialize the parser by pointing to the first token available in the tokenizer.
         // The tokenizer is assumed to be already initialized and pointing to the first token.
         currentToken=&tokenizer.current();
     }
 
-    std::unique_ptr<ClassNode> Parser::parse() {
-        // The entry point for parsing a Jack file. Every Jack file must contain exactly one class.
-        auto classNode = parseClass();
+    ClassNode* Parser::parse() {
+        try {
+            // The entry point for parsing a Jack file. Every Jack file must contain exactly one class.
+            auto classNode = parseClass();
 
-        // Constraint: Single Class Check
-        // After parseClass() finishes, it consumes the final '}'.
-        // The currentToken should now be EOF. If it's anything else, it's an error.
-        if (currentToken->getType() != TokenType::END_OF_FILE) {
-            tokenizer.errorHere("Syntax Error: A Jack file must contain exactly one class. Found extra tokens after class body.");
+            // Constraint: Single Class Check
+            // After parseClass() finishes, it consumes the final '}'.
+            // The currentToken should now be EOF. If it's anything else, it's an error.
+            if (currentToken->getType() != TokenType::END_OF_FILE) {
+                tokenizer.errorHere("Syntax Error: A Jack file must contain exactly one class. Found extra tokens after class body.");
+            }
+
+            return classNode;
+        } catch (const CompilationError& e) {
+            // Outside of any class member (the class header, or past its end): nowhere to resume.
+            if (!diagnostics) throw;
+            diagnostics->report(e.getDiagnostic());
+            throw CompilationStopped{};
         }
+    }
 
-        return classNode;
+    void Parser::recover(const CompilationError &error, const bool memberLevel) {
+        diagnostics->report(error.getDiagnostic());
+
+        int depth = 0;
+        while (!check(TokenType::END_OF_FILE)) {
+            if (depth == 0) {
+                if (check("}")) return;
+                if (memberLevel) {
+                    if (check("static") || check("field") || check("constructor") || check("function") || check("method")) return;
+                } else {
+                    if (check("let") || check("if") || check("while") || check("do") || check("return")) return;
+                    if (check(";")) {
+                        advance();
+                        return;
+                    }
+                }
+            }
+            if (check("{")) ++depth;
+            else if (check("}")) --depth;
+            advance();
+        }
+        throw CompilationStopped{};
     }
 
 
@@ -67,7 +100,7 @@ namespace nand2tetris::jack {
         }
     }
 
-    std::unique_ptr<ClassNode> Parser::parseClass() {
+    ClassNode* Parser::parseClass() {
         // Grammar: 'class' className '{' classVarDec* subroutineDec* '}'
         int line = currentToken->getLine();
         int col = currentToken->getColumn();
@@ -76,30 +109,34 @@ namespace nand2tetris::jack {
         consume("class", "Expected 'class' keyword");
 
         // 2. Expect class name (identifier)
-        std::string_view className = currentToken->getValue();
+        const SymbolId className = currentToken->getSymbol();
         consume(TokenType::IDENTIFIER, "Expected class name");
 
         const fs::path filePath(tokenizer.getFilePath());
         const std::string expectedName = filePath.stem().string();
 
-        if (className != expectedName) {
+        if (nameOf(className) != expectedName) {
             tokenizer.errorHere("Class name mismatch. The class defined in '" +
                                 filePath.filename().string() + "' must be named '" + expectedName +
-                                "', but found '" + std::string(className) + "'.");
+                                "', but found '" + std::string(nameOf(className)) + "'.");
         }
 
         currentClassName=className;
-        if (globalRegistry.classExists(className)) {
-            tokenizer.errorHere("Duplicate class definition: Class '" + std::string(className) + "' is already "
+        bool registered;
+        {
+            TraceScope trace("register", nameOf(className));
+            registered = globalRegistry.registerClass(className);
+        }
+        if (!registered) {
+            tokenizer.errorHere("Duplicate class definition: Class '" + std::string(nameOf(className)) + "' is already "
                                                                                                  "defined.");
         }
-        globalRegistry.registerClass(className);
 
         // 3. Expect opening brace '{'
         consume("{", "Expected '{'");
 
-        std::vector<std::unique_ptr<ClassVarDecNode>> classVars;
-        std::vector<std::unique_ptr<SubroutineDecNode>> subroutineDecs;
+        std::vector<ClassVarDecNode*> classVars;
+        std::vector<SubroutineDecNode*> subroutineDecs;
 
         // 4. Parse class body: variable declarations followed by subroutine declarations.
         // We loop until we hit the closing brace '}'.
@@ -107,23 +144,28 @@ namespace nand2tetris::jack {
             const std::string_view val=currentToken->getValue();
 
             // Distinguish between class variables (static/field) and subroutines (constructor/method/function).
-            if (val=="static"||val=="field") {
-                classVars.push_back(parseClassVarDec());
-            }else if (val=="constructor"||val=="method"||val=="function") {
-                subroutineDecs.push_back(parseSubroutine());
-            }else {
-                // If we encounter anything else, it's a syntax error.
-                tokenizer.errorAt(currentToken->getLine(),currentToken->getColumn(), "Expected class variable or subroutine declaration");
+            try {
+                if (val=="static"||val=="field") {
+                    classVars.push_back(parseClassVarDec());
+                }else if (val=="constructor"||val=="method"||val=="function") {
+                    subroutineDecs.push_back(parseSubroutine());
+                }else {
+                    // If we encounter anything else, it's a syntax error.
+                    tokenizer.errorAt(currentToken->getLine(),currentToken->getColumn(), "Expected class variable or subroutine declaration");
+                }
+            } catch (const CompilationError& e) {
+                if (!diagnostics) throw;
+                recover(e, true); // The member is left out of the tree.
             }
         }
 
         // 5. Expect closing brace '}'
         consume("}", "Expected '}' to close class body");
 
-        return std::make_unique<ClassNode>(className, std::move(classVars), std::move(subroutineDecs), line, col);
+        return arena.make<ClassNode>(className, arena.copyList(classVars), arena.copyList(subroutineDecs), line, col);
     }
 
-    std::unique_ptr<ClassVarDecNode> Parser::parseClassVarDec() {
+    ClassVarDecNode* Parser::parseClassVarDec() {
         // Grammar: ('static' | 'field') type varName (',' varName)* ';'
         int line = currentToken->getLine();
         int col = currentToken->getColumn();
@@ -140,7 +182,7 @@ namespace nand2tetris::jack {
         advance(); // Consume 'static' or 'field'
 
         // 2. Parse the type (int, char, boolean, or a class name).
-        std::string_view type = currentToken->getValue();
+        const SymbolId type = currentToken->getSymbol();
         if (check("int")||check("boolean")||check("char")||check(TokenType::IDENTIFIER)) {
             advance();
         }else {
@@ -148,10 +190,10 @@ namespace nand2tetris::jack {
         }
 
         // 3. Parse the list of variable names.
-        std::vector<std::string_view> names;
+        std::vector<SymbolId> names;
 
         // The first variable name is mandatory.
-        names.push_back(currentToken->getValue());
+        names.push_back(currentToken->getSymbol());
         consume(TokenType::IDENTIFIER, "Expected variable name");
 
         // Handle multiple variables declared in the same line (e.g., static int x, y, z;)
@@ -169,17 +211,17 @@ namespace nand2tetris::jack {
             }
 
             // Consume the next variable name
-            names.push_back(currentToken->getValue());
+            names.push_back(currentToken->getSymbol());
             consume(TokenType::IDENTIFIER, "Expected variable name");
         }
 
         // 4. Expect the closing semicolon.
         consume(";", "Expected ';' at the end of variable declaration");
 
-        return std::make_unique<ClassVarDecNode>(kind, type, std::move(names), line, col);
+        return arena.make<ClassVarDecNode>(kind, type, arena.copyList(names), line, col);
     }
 
-    std::unique_ptr<SubroutineDecNode> Parser::parseSubroutine() {
+    SubroutineDecNode* Parser::parseSubroutine() {
         // Grammar: ('constructor' | 'function' | 'method') ('void' | type) subroutineName '(' parameterList ')'
         // subroutineBody: '{' varDec* statements '}'
         int line = currentToken->getLine();
@@ -198,19 +240,19 @@ namespace nand2tetris::jack {
 
         // 2. Parse the return type.
         // Can be 'void', a primitive type (int, boolean, char), or a class name (identifier).
-        std::string_view returnType;
+        SymbolId returnType = NO_SYMBOL;
         if (currentToken->getValue()=="void") {
-            returnType="void";
+            returnType=sym::VOID;
             advance();
         }else if (check("int")||check("boolean")||check("char")||check(TokenType::IDENTIFIER)) {
-            returnType=currentToken->getValue();
+            returnType=currentToken->getSymbol();
             advance();
         }else {
             tokenizer.errorAt(currentToken->getLine(), currentToken->getColumn(), "Expected return type void, int, char, boolean, or class name");
         }
 
         // 3. Parse the subroutine name.
-        std::string_view subroutineName=currentToken->getValue();
+        const SymbolId subroutineName=currentToken->getSymbol();
         consume(TokenType::IDENTIFIER, "Expected subroutine name");
 
         // 4. Parse the parameter list enclosed in parentheses.
@@ -222,7 +264,7 @@ namespace nand2tetris::jack {
             // Loop to parse parameters separated by commas.
             while (true) {
                 // Parse parameter type
-                const std::string_view pType = currentToken->getValue();
+                const SymbolId pType = currentToken->getSymbol();
                 if (check("int")||check("boolean")||check("char")||check(TokenType::IDENTIFIER)) {
                     advance();
                 }else {
@@ -230,7 +272,7 @@ namespace nand2tetris::jack {
                 }
 
                 // Parse parameter name
-                const std::string_view pName = currentToken->getValue();
+                const SymbolId pName = currentToken->getSymbol();
                 consume(TokenType::IDENTIFIER, "Expected parameter name");
 
                 parameters.push_back({pType, pName});
@@ -255,43 +297,51 @@ namespace nand2tetris::jack {
 
         consume(")", "Expected ')' to close parameter list");
 
-        //Convert AST Parameters to String Vector for Registry
-        std::vector<std::string_view> paramTypes;
+        //Convert AST Parameters to a type list for the Registry
+        std::vector<SymbolId> paramTypes;
         paramTypes.reserve(parameters.size());
         for (const auto& p : parameters) {
             paramTypes.push_back(p.type);
         }
 
         const bool isStatic = (type == SubroutineType::FUNCTION || type == SubroutineType::CONSTRUCTOR);
-        globalRegistry.registerMethod(
-        currentClassName,      // We saved this in parseClass
-        subroutineName,        // Parsed earlier in this function
-        returnType,            // Parsed earlier in this function
-        paramTypes,            // Created just now
-        isStatic,
-        line,                  // From start of subroutine
-        col
-    );
+        {
+            TraceScope trace("register", nameOf(currentClassName));
+            globalRegistry.registerMethod(
+            currentClassName,      // We saved this in parseClass
+            subroutineName,        // Parsed earlier in this function
+            returnType,            // Parsed earlier in this function
+            paramTypes,            // Created just now
+            isStatic,
+            line,                  // From start of subroutine
+            col
+        );
+        }
 
         // 5. Parse the subroutine body.
         consume("{","Expected '{' to open subroutine body");
 
-        std::vector<std::unique_ptr<VarDecNode>> localVars;
+        std::vector<VarDecNode*> localVars;
 
         // Parse local variable declarations (must come before statements).
         while (check("var")) {
-            localVars.push_back(parseVarDec());
+            try {
+                localVars.push_back(parseVarDec());
+            } catch (const CompilationError& e) {
+                if (!diagnostics) throw;
+                recover(e, false);
+            }
         }
 
         // Parse statements until the closing brace.
-        std::vector<std::unique_ptr<StatementNode> > statements = parseStatements();
+        ArenaList<StatementNode*> statements = parseStatements();
 
         consume("}","Expected '}' to close subroutine body");
 
-        return std::make_unique<SubroutineDecNode>(type,returnType,subroutineName,parameters,std::move(localVars),std::move(statements), line, col);
+        return arena.make<SubroutineDecNode>(type,returnType,subroutineName,arena.copyList(parameters),arena.copyList(localVars),statements, line, col);
     }
 
-    std::unique_ptr<VarDecNode> Parser::parseVarDec() {
+    VarDecNode* Parser::parseVarDec() {
         // Grammar: 'var' type varName (',' varName)* ';'
         int line = currentToken->getLine();
         int col = currentToken->getColumn();
@@ -300,7 +350,7 @@ namespace nand2tetris::jack {
         consume("var", "Expected 'var' keyword");
 
         // 2. Parse the type (int, char, boolean, or a class name).
-        std::string_view type = currentToken->getValue();
+        const SymbolId type = currentToken->getSymbol();
         if (check("int")||check("boolean")||check("char")||check(TokenType::IDENTIFIER)) {
             advance();
         }else {
@@ -308,10 +358,10 @@ namespace nand2tetris::jack {
         }
 
         // 3. Parse the list of variable names.
-        std::vector<std::string_view> names;
+        std::vector<SymbolId> names;
 
         // First variable name is mandatory.
-        names.push_back(currentToken->getValue());
+        names.push_back(currentToken->getSymbol());
         consume(TokenType::IDENTIFIER, "Expected variable name");
 
         // Handle multiple variables declared in the same line (e.g., var int x, y, z;)
@@ -326,25 +376,30 @@ namespace nand2tetris::jack {
             }
 
             // Consume the next variable name
-            names.push_back(currentToken->getValue());
+            names.push_back(currentToken->getSymbol());
             consume(TokenType::IDENTIFIER, "Expected variable name");
         }
 
         // 4. Expect the closing semicolon.
         consume(";", "Expected ';' at the end of variable declaration");
 
-        return std::make_unique<VarDecNode>(type,std::move(names), line, col);
+        return arena.make<VarDecNode>(type,arena.copyList(names), line, col);
     }
 
-    std::vector<std::unique_ptr<StatementNode>> Parser::parseStatements() {
-        std::vector<std::unique_ptr<StatementNode>> list;
+    ArenaList<StatementNode*> Parser::parseStatements() {
+        std::vector<StatementNode*> list;
         while (!check("}")) {
-            list.push_back(parseStatement());
+            try {
+                list.push_back(parseStatement());
+            } catch (const CompilationError& e) {
+                if (!diagnostics) throw;
+                recover(e, false); // The statement is left out of the tree.
+            }
         }
-        return list;
+        return arena.copyList(list);
     }
 
-    std::unique_ptr<StatementNode> Parser::parseStatement() {
+    StatementNode* Parser::parseStatement() {
         if (check("let")) {
             return parseLetStatement();
         }
@@ -365,7 +420,7 @@ namespace nand2tetris::jack {
         tokenizer.errorAt(currentToken->getLine(),currentToken->getColumn(), "Unknown statement or unexpected text");
     }
 
-    std::unique_ptr<LetStatementNode> Parser::parseLetStatement() {
+    LetStatementNode* Parser::parseLetStatement() {
         // Grammar: 'let' varName ('[' expression ']')? '=' expression ';'
         int line = currentToken->getLine();
         int col = currentToken->getColumn();
@@ -374,10 +429,10 @@ namespace nand2tetris::jack {
         consume("let","Expected a 'let' keyword");
 
         //get the variable name
-        std::string_view varName=currentToken->getValue();
+        const SymbolId varName=currentToken->getSymbol();
         consume(TokenType::IDENTIFIER,"Expected variable name");
 
-        std::unique_ptr<ExpressionNode> indexExpr=nullptr; ///< The index expression for array assignment (optional).
+        ExpressionNode* indexExpr=nullptr; ///< The index expression for array assignment (optional).
         if (check("[")) {
             advance();
             indexExpr=parseExpression();
@@ -397,14 +452,14 @@ namespace nand2tetris::jack {
 
         consume("=","Expected an `=`");
 
-        std::unique_ptr<ExpressionNode> exp=parseExpression();
+        ExpressionNode* exp=parseExpression();
 
         consume(";", "Expected ';' at end of let statement");
 
-        return std::make_unique<LetStatementNode>(varName, std::move(indexExpr), std::move(exp), line, col);
+        return arena.make<LetStatementNode>(varName, indexExpr, exp, line, col);
     }
 
-    std::unique_ptr<IfStatementNode> Parser::parseIfStatement() {
+    IfStatementNode* Parser::parseIfStatement() {
         // Grammar: 'if' '(' expression ')' '{' statements '}' ('else' '{' statements '}')?
         int line = currentToken->getLine();
         int col = currentToken->getColumn();
@@ -413,7 +468,7 @@ namespace nand2tetris::jack {
 
         // 1. Condition Header '('
         consume("(", "Expected '(' after 'if'");
-        std::unique_ptr<ExpressionNode> condition=parseExpression();
+        ExpressionNode* condition=parseExpression();
         // 2. Condition Closer ')'
         // If it's missing, we check if they accidentally started the block '{' early.
         if (check("{")) {
@@ -426,10 +481,10 @@ namespace nand2tetris::jack {
 
         // 3. If-Body '{ statements }'
         consume("{", "Expected '{' to start if-block");
-        std::vector<std::unique_ptr<StatementNode>> ifStatements=parseStatements();
+        ArenaList<StatementNode*> ifStatements=parseStatements();
         consume("}", "Expected '}' to close if-block");
 
-        std::vector<std::unique_ptr<StatementNode>> elseStatements;
+        ArenaList<StatementNode*> elseStatements;
         if (check("else")) {
             advance(); // consume 'else'
             consume("{", "Expected '{' to start else-block");
@@ -437,11 +492,11 @@ namespace nand2tetris::jack {
             consume("}", "Expected '}' to close else-block");
         }
 
-        return std::make_unique<IfStatementNode>(std::move(condition), std::move(ifStatements), std::move(elseStatements), line, col);
+        return arena.make<IfStatementNode>(condition, ifStatements, elseStatements, line, col);
     }
 
 
-    std::unique_ptr<WhileStatementNode> Parser::parseWhileStatement() {
+    WhileStatementNode* Parser::parseWhileStatement() {
         // Grammar: 'while' '(' expression ')' '{' statements '}'
         int line = currentToken->getLine();
         int col = currentToken->getColumn();
@@ -450,7 +505,7 @@ namespace nand2tetris::jack {
 
         // 1. Condition
         consume("(", "Expected '(' after 'while'");
-        std::unique_ptr<ExpressionNode> condition = parseExpression();
+        ExpressionNode* condition = parseExpression();
         if (check("{")) {
             tokenizer.errorAt(currentToken->getLine(), currentToken->getColumn(),"Missing ')' before opening brace '{'");
         }
@@ -458,20 +513,20 @@ namespace nand2tetris::jack {
 
         // 2. Body
         consume("{", "Expected '{' to start while-loop body");
-        std::vector<std::unique_ptr<StatementNode>> body = parseStatements();
+        ArenaList<StatementNode*> body = parseStatements();
         consume("}", "Expected '}' to close while-loop body");
 
-        return std::make_unique<WhileStatementNode>(std::move(condition), std::move(body), line, col);
+        return arena.make<WhileStatementNode>(condition, body, line, col);
     }
 
-    std::unique_ptr<ReturnStatementNode> Parser::parseReturnStatement() {
+    ReturnStatementNode* Parser::parseReturnStatement() {
         // Grammar: 'return' expression? ';'
         int line = currentToken->getLine();
         int col = currentToken->getColumn();
 
         consume("return", "Expected 'return' keyword");
 
-        std::unique_ptr<ExpressionNode> value = nullptr;
+        ExpressionNode* value = nullptr;
 
         // 1. Check if there is an expression to return.
         // In Jack, if the next token is not ';', it MUST be an expression.
@@ -489,40 +544,40 @@ namespace nand2tetris::jack {
         // 2. Final check for the semicolon
         consume(";", "Expected ';' after return statement");
 
-        return std::make_unique<ReturnStatementNode>(std::move(value), line, col);
+        return arena.make<ReturnStatementNode>(value, line, col);
     }
 
 
-    std::unique_ptr<DoStatementNode> Parser::parseDoStatement() {
+    DoStatementNode* Parser::parseDoStatement() {
         //Grammar: `do' subroutineName '('expressionList')'|(className|varName)`.` subroutineName
         int line = currentToken->getLine();
         int col = currentToken->getColumn();
 
         consume("do","Expected 'do' keyword");
-        std::unique_ptr<CallNode> call = parseSubroutineCall();
+        CallNode* call = parseSubroutineCall();
         consume(";", "Expected ';' after do subroutine call");
-        return std::make_unique<DoStatementNode>(std::move(call), line, col);
+        return arena.make<DoStatementNode>(call, line, col);
 
     }
 
-    std::unique_ptr<ExpressionNode> Parser::parseExpression() {
+    ExpressionNode* Parser::parseExpression() {
         // Grammar: term (op term)*
         // op: + - * / & | < > =
         int line = currentToken->getLine();
         int col = currentToken->getColumn();
 
         // 1. Compile the first term
-        std::unique_ptr<ExpressionNode> left_term=parseTerm();
+        ExpressionNode* left_term=parseTerm();
 
         // 2. Look for binary operators: +, -, *, /, &, |, <, >, =
         while (isBinaryOp()) {
             char op = currentToken->getValue()[0];
             advance(); // consume the operator
-            std::unique_ptr<ExpressionNode> right_term = parseTerm();
+            ExpressionNode* right_term = parseTerm();
 
             // Wrap the existing 'left' and the new 'right' into a new BinaryOpNode
             // This handles left-associativity (e.g., 1 + 2 + 3)
-            left_term = std::make_unique<BinaryOpNode>(std::move(left_term), op, std::move(right_term), line, col);
+            left_term = arena.make<BinaryOpNode>(left_term, op, right_term, line, col);
         }
 
         return left_term;
@@ -541,7 +596,7 @@ namespace nand2tetris::jack {
     }
 
 
-    std::unique_ptr<ExpressionNode> Parser::parseTerm() {
+    ExpressionNode* Parser::parseTerm() {
         // Grammar: integerConstant | stringConstant | keywordConstant | varName |
         //          varName '[' expression ']' | subroutineCall | '(' expression ')' | unaryOp term
         int line = currentToken->getLine();
@@ -549,17 +604,16 @@ namespace nand2tetris::jack {
 
         // 1. Integer Constant
         if (check(TokenType::INT_CONST)) {
-            const auto* intToken = static_cast<const IntToken*>(currentToken);// NOLINT(*-pro-type-static-cast-downcast)
-            int val = intToken->getInt();
+            int val = currentToken->getInt();
             advance();
-            return std::make_unique<IntegerLiteralNode>(val, line, col);
+            return arena.make<IntegerLiteralNode>(val, line, col);
         }
 
         // 2. String Constant
         if (check(TokenType::STRING_CONST)) {
             std::string_view val = currentToken->getValue();
             advance();
-            return std::make_unique<StringLiteralNode>(val, line, col);
+            return arena.make<StringLiteralNode>(val, line, col);
         }
 
         // 3. Keyword Constant (true, false, null, this)
@@ -568,16 +622,16 @@ namespace nand2tetris::jack {
 
             if (val == "true") {
                 advance();
-                return std::make_unique<KeywordLiteralNode>(Keyword::TRUE_, line, col);
+                return arena.make<KeywordLiteralNode>(Keyword::TRUE_, line, col);
             } else if (val == "false") {
                 advance();
-                return std::make_unique<KeywordLiteralNode>(Keyword::FALSE_, line, col);
+                return arena.make<KeywordLiteralNode>(Keyword::FALSE_, line, col);
             } else if (val == "null") {
                 advance();
-                return std::make_unique<KeywordLiteralNode>(Keyword::NULL_, line, col);
+                return arena.make<KeywordLiteralNode>(Keyword::NULL_, line, col);
             } else if (val == "this") {
                 advance();
-                return std::make_unique<KeywordLiteralNode>(Keyword::THIS_, line, col);
+                return arena.make<KeywordLiteralNode>(Keyword::THIS_, line, col);
             }else {
                 tokenizer.errorAt(currentToken->getLine(),currentToken->getColumn(),"Inappropriate keyword used in expression.");
             }
@@ -586,7 +640,7 @@ namespace nand2tetris::jack {
 
         // 4. Identifier (Variable, Array Access, or Subroutine Call)
         if (check(TokenType::IDENTIFIER)) {
-            std::string_view name = currentToken->getValue();
+            const SymbolId name = currentToken->getSymbol();
 
             // Use PEEK to distinguish between x, x[i], and x.method()
             const Token& next = tokenizer.peek();
@@ -594,23 +648,23 @@ namespace nand2tetris::jack {
                 // Array Access: varName '[' expression ']'
                 advance(); //consume name
                 advance(); // consume '['
-                std::unique_ptr<ExpressionNode> exp=parseExpression();
+                ExpressionNode* exp=parseExpression();
                 consume("]", "Expected ']' after array index");
-                return std::make_unique<IdentifierNode>(name, line, col, std::move(exp));
+                return arena.make<IdentifierNode>(name, line, col, exp);
             }else if (next.getValue()=="("||next.getValue()==".") {
                 // Subroutine Call
                 return parseSubroutineCall();
             }else {
                 // Simple Variable
                 advance();
-                return std::make_unique<IdentifierNode>(name, line, col);
+                return arena.make<IdentifierNode>(name, line, col);
             }
         }
 
         // 5. Parenthesized Expression: '(' expression ')'
         if (check("(")) {
             advance();
-            std::unique_ptr<ExpressionNode> expr = parseExpression();
+            ExpressionNode* expr = parseExpression();
             consume(")", "Expected ')' to close expression");
             return expr;
         }
@@ -619,8 +673,8 @@ namespace nand2tetris::jack {
         if (check("-") || check("~")) {
             char op = currentToken->getValue()[0];
             advance();
-            std::unique_ptr<ExpressionNode> term = parseTerm();
-            return std::make_unique<UnaryOpNode>(op, std::move(term), line, col);
+            ExpressionNode* term = parseTerm();
+            return arena.make<UnaryOpNode>(op, term, line, col);
         }
 
         const std::string err = "Expected an expression term, but found '" + std::string(currentToken->getValue()) + "'";
@@ -628,12 +682,12 @@ namespace nand2tetris::jack {
     }
 
 
-    std::vector<std::unique_ptr<ExpressionNode>> Parser::parseExpressionList() {
-        std::vector<std::unique_ptr<ExpressionNode>> list;
+    ArenaList<ExpressionNode*> Parser::parseExpressionList() {
+        std::vector<ExpressionNode*> list;
 
         // 1. Handle the empty list case: do method()
         if (check(")")) {
-            return list;
+            return {};
         }
 
         // 2. Parse the first mandatory expression (must exist if not followed immediately by ')'
@@ -657,25 +711,25 @@ namespace nand2tetris::jack {
             }
         }
 
-        return list;
+        return arena.copyList(list);
     }
 
-    std::unique_ptr<CallNode> Parser::parseSubroutineCall() {
+    CallNode* Parser::parseSubroutineCall() {
         int line = currentToken->getLine();
         int col = currentToken->getColumn();
 
         // Save the first identifier to determine context later
-        const std::string_view firstPart = currentToken->getValue();
+        const SymbolId firstPart = currentToken->getSymbol();
         consume(TokenType::IDENTIFIER, "Expected subroutine, class, or variable name");
 
-        std::string_view classNameOrVar;
-        std::string_view subroutineName;
+        SymbolId classNameOrVar = NO_SYMBOL;
+        SymbolId subroutineName;
 
         // 1. Check for the dot '.' symbol (indicates a call on an object or a static class method)
         if (check(".")) {
             advance(); // Move past '.'
             classNameOrVar = firstPart; // The first part was the class/variable name
-            subroutineName = currentToken->getValue();
+            subroutineName = currentToken->getSymbol();
             consume(TokenType::IDENTIFIER, "Expected subroutine name after '.'");
         } else {
             // 2. Direct call (e.g., draw()): The first part was the actual subroutine name
@@ -686,13 +740,13 @@ namespace nand2tetris::jack {
         consume("(", "Expected '(' for argument list");
 
         // Call our helper to parse zero or more expressions
-        std::vector<std::unique_ptr<ExpressionNode>> agrs = parseExpressionList();
+        ArenaList<ExpressionNode*> agrs = parseExpressionList();
 
         // Ensure the argument list is properly closed
         consume(")", "Expected ')' to close argument list");
 
         // Return the AST node with all captured information
-        return std::make_unique<CallNode>(classNameOrVar, subroutineName, std::move(agrs), line, col);
+        return arena.make<CallNode>(classNameOrVar, subroutineName, agrs, line, col);
     }
     
 }
@@ -9,6 +9,7 @@
 #include "../Tokenizer/TokenTypes.h"
 #include "AST.h"
 #include "../SemanticAnalyser/GlobalRegistry.h"
+#include "../Diagnostics/Diagnostics.h"
 
 
 namespace nand2tetris::jack {
@@ -23,7 +24,9 @@ namespace nand2tetris::jack {
     class Parser {
         Tokenizer& tokenizer;           ///< Reference to the tokenizer providing the token stream.
         GlobalRegistry& globalRegistry;
+        AstArena& arena;                ///< Allocator that owns every node this parser creates.
         const Token* currentToken = nullptr; ///< Pointer to the current token being processed.
+        DiagnosticSink* diagnostics;    ///< Where syntax errors are collected; nullptr = the first one is thrown.
 
         // --- Helper Methods ---
 
@@ -68,6 +71,18 @@ namespace nand2tetris::jack {
          */
         void consume(std::string_view text, std::string_view errorMessage);
 
+        /**
+         * @brief Reports 'error' to the sink and skips ahead to where parsing can resume.
+         *
+         * Tokens inside skipped '{ ... }' blocks are skipped with them, so a broken 'if' or
+         * 'while' header does not resume inside its own body.
+         *
+         * @param memberLevel Resume at the next class member (or the class's '}') instead of at
+         *                    the next statement (after a ';', or before a '}' or a statement keyword).
+         * @throws CompilationStopped at the end of the file, or when the build's error limit is reached.
+         */
+        void recover(const CompilationError& error, bool memberLevel);
+
         // --- Grammar Rules (Recursive Descent) ---
 
         /**
@@ -75,117 +90,117 @@ namespace nand2tetris::jack {
          *
          * Grammar: 'class' className '{' classVarDec* subroutineDec* '}'
          *
-         * @return A unique_ptr to the resulting ClassNode.
+         * @return A pointer (owned by the arena) to the resulting ClassNode.
          */
-        std::unique_ptr<ClassNode> parseClass();
+        ClassNode* parseClass();
 
         /**
          * @brief Parses a static or field variable declaration.
          *
          * Grammar: ('static' | 'field') type varName (',' varName)* ';'
          *
-         * @return A unique_ptr to the resulting ClassVarDecNode.
+         * @return A pointer (owned by the arena) to the resulting ClassVarDecNode.
          */
-        std::unique_ptr<ClassVarDecNode> parseClassVarDec();
+        ClassVarDecNode* parseClassVarDec();
 
         /**
          * @brief Parses a subroutine (constructor, function, or method).
          *
          * Grammar: ('constructor' | 'function' | 'method') ('void' | type) subroutineName '(' parameterList ')' subroutineBody
          *
-         * @return A unique_ptr to the resulting SubroutineDecNode.
+         * @return A pointer (owned by the arena) to the resulting SubroutineDecNode.
          */
-        std::unique_ptr<SubroutineDecNode> parseSubroutine();
+        SubroutineDecNode* parseSubroutine();
 
         /**
          * @brief Parses a local variable declaration.
          *
          * Grammar: 'var' type varName (',' varName)* ';'
          *
-         * @return A unique_ptr to the resulting VarDecNode.
+         * @return A pointer (owned by the arena) to the resulting VarDecNode.
          */
-        std::unique_ptr<VarDecNode> parseVarDec();
+        VarDecNode* parseVarDec();
 
         /**
          * @brief Parses a sequence of statements.
          *
          * Grammar: statement*
          *
-         * @return A vector of unique_ptrs to StatementNodes.
+         * @return An arena list of StatementNodes.
          */
-        std::vector<std::unique_ptr<StatementNode>> parseStatements();
+        ArenaList<StatementNode*> parseStatements();
 
         /**
          * @brief Parses a single statement.
          *
          * Dispatches to specific statement parsers (let, if, while, do, return) based on the keyword.
          *
-         * @return A unique_ptr to the resulting StatementNode.
+         * @return A pointer (owned by the arena) to the resulting StatementNode.
          */
-        std::unique_ptr<StatementNode> parseStatement();
+        StatementNode* parseStatement();
 
         /**
          * @brief Parses a 'let' statement.
          *
          * Grammar: 'let' varName ('[' expression ']')? '=' expression ';'
          *
-         * @return A unique_ptr to the resulting LetStatementNode.
+         * @return A pointer (owned by the arena) to the resulting LetStatementNode.
          */
-        std::unique_ptr<LetStatementNode> parseLetStatement();
+        LetStatementNode* parseLetStatement();
 
         /**
          * @brief Parses an 'if' statement.
          *
          * Grammar: 'if' '(' expression ')' '{' statements '}' ('else' '{' statements '}')?
          *
-         * @return A unique_ptr to the resulting IfStatementNode.
+         * @return A pointer (owned by the arena) to the resulting IfStatementNode.
          */
-        std::unique_ptr<IfStatementNode> parseIfStatement();
+        IfStatementNode* parseIfStatement();
 
         /**
          * @brief Parses a 'while' statement.
          *
          * Grammar: 'while' '(' expression ')' '{' statements '}'
          *
-         * @return A unique_ptr to the resulting WhileStatementNode.
+         * @return A pointer (owned by the arena) to the resulting WhileStatementNode.
          */
-        std::unique_ptr<WhileStatementNode> parseWhileStatement();
+        WhileStatementNode* parseWhileStatement();
 
         /**
          * @brief Parses a 'do' statement.
          *
          * Grammar: 'do' subroutineCall ';'
          *
-         * @return A unique_ptr to the resulting DoStatementNode.
+         * @return A pointer (owned by the arena) to the resulting DoStatementNode.
          */
-        std::unique_ptr<DoStatementNode> parseDoStatement();
+        DoStatementNode* parseDoStatement();
 
         /**
          * @brief Parses a 'return' statement.
          *
          * Grammar: 'return' expression? ';'
          *
-         * @return A unique_ptr to the resulting ReturnStatementNode.
+         * @return A pointer (owned by the arena) to the resulting ReturnStatementNode.
          */
-        std::unique_ptr<ReturnStatementNode> parseReturnStatement();
+        ReturnStatementNode* parseReturnStatement();
 
         /**
          * @brief Parses an expression.
          *
          * Grammar: term (op term)*
          *
-         * @return A unique_ptr to the resulting ExpressionNode.
+         * @return A pointer (owned by the arena) to the resulting ExpressionNode.
          */
-        std::unique_ptr<ExpressionNode> parseExpression();
+        ExpressionNode* parseExpression();
 
         /**
          * @brief Parses a term within an expression.
          *
          * Grammar: integerConstant | stringConstant | keywordConstant | varName | varName '[' expression ']' | subroutineCall | '(' expression ')' | unaryOp term
          *
-         * @return A unique_ptr to the resulting ExpressionNode (which is a specific type of term).
+         * @return A pointer (owned by the arena) to the resulting ExpressionNode (which is a specific type of term).
          */
-        std::unique_ptr<ExpressionNode> parseTerm();
+        ExpressionNode* parseTerm();
 
         /**
          * @brief Parses a comma-separated list of expressions.
@@ -193,18 +208,18 @@ namespace nand2tetris::jack {
          * Used in subroutine calls.
          * Grammar: (expression (',' expression)*)?
          *
-         * @return A vector of expression nodes.
+         * @return An arena list of expression nodes.
          */
-        std::vector<std::unique_ptr<ExpressionNode>> parseExpressionList();
+        ArenaList<ExpressionNode*> parseExpressionList();
 
         /**
          * @brief Parses a subroutine call.
          *
          * Grammar: subroutineName '(' expressionList ')' | (className | varName) '.' subroutineName '(' expressionList ')'
          *
-         * @return A unique_ptr to the resulting CallNode.
+         * @return A pointer (owned by the arena) to the resulting CallNode.
          */
-        std::unique_ptr<CallNode> parseSubroutineCall();
+        CallNode* parseSubroutineCall();
 
         /**
          * @brief Checks if the current token is a binary operator.
@@ -215,25 +230,30 @@ namespace nand2tetris::jack {
          */
         bool isBinaryOp() const;
 
-        std::string_view currentClassName;
+        SymbolId currentClassName = NO_SYMBOL;
 
         public:
             /**
              * @brief Constructs a Parser with a given Tokenizer.
              *
              * @param tokenizer The tokenizer instance to use.
-             * @param registry
+             * @param registry The global registry that classes and subroutines are registered into.
+             * @param arena The arena that will own the AST. It must outlive every use of the tree.
+             * @param diagnostics If set, syntax errors are collected there and parsing resumes after
+             *                    each one (sync on ';' and '}'); the tree is then incomplete.
              */
-            explicit Parser(Tokenizer& tokenizer, GlobalRegistry &registry);
+            Parser(Tokenizer& tokenizer, GlobalRegistry &registry, AstArena& arena, DiagnosticSink* diagnostics = nullptr);
 
             /**
              * @brief Parses the entire token stream into an Abstract Syntax Tree.
              *
              * Starts parsing from the 'class' rule.
              *
-             * @return A unique_ptr to the root ClassNode of the AST.
+             * @return A pointer to the root ClassNode of the AST, owned by the arena.
+             * @throws CompilationError on the first syntax error, without a DiagnosticSink.
+             * @throws CompilationStopped with a DiagnosticSink, if the class cannot be parsed to its end.
              */
-            std::unique_ptr<ClassNode> parse();
+            ClassNode* parse();
     };
 };
 
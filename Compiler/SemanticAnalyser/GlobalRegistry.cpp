@@ -3,42 +3,166 @@
 //
 
 #include "GlobalRegistry.h"
+#include "../OsImage/OsImage.h"
+#include "../Diagnostics/Diagnostics.h"
+#include "../Stats/Stats.h"
+#include <algorithm>
+#include <utility>
 
 namespace nand2tetris::jack {
-    void GlobalRegistry::registerClass(const std::string_view className) {
-        std::scoped_lock lock(mtx);
+    namespace {
+        [[noreturn]] void throwFrozen(const SymbolId className) {
+            throw std::runtime_error("Internal Compiler Error: Registration of '" + std::string(nameOf(className)) +
+                                     "' after the registry was frozen.");
+        }
+    }
+
+    bool GlobalRegistry::registerClass(const SymbolId className) {
+        if (isFrozen()) throwFrozen(className);
+        Shard& shard = shardFor(className);
+        CountedLock lock(shard.mtx);
         // Insert the class name into the set of known classes.
-        classes.insert(className);
+        if (shard.classes.insert(className).second) {
+            return true;
+        }
+        // The OS's own source replaces its built-in signatures (only once).
+        if (shard.builtin.erase(className)) {
+            shard.methods.erase(className);
+            return true;
+        }
+        return false;
     }
 
     GlobalRegistry::GlobalRegistry() {
         loadStandardLibrary();
     }
 
-    void GlobalRegistry::registerMethod(const std::string_view className, const std::string_view methodName,
-                                        const std::string_view returnType, const std::vector<std::string_view> &params, const bool isStatic,const int
+    GlobalRegistry::GlobalRegistry(const GlobalRegistry &other)
+        : frozenClasses(other.frozenClasses), frozenMethods(other.frozenMethods),
+          classIndexById(other.classIndexById), declaredClassCount(other.declaredClassCount),
+          frozen(other.isFrozen()) {
+        for (std::size_t i = 0; i < SHARD_COUNT; ++i) {
+            const Shard& from = other.shards[i];
+            CountedLock lock(from.mtx);
+            shards[i].methods = from.methods;
+            shards[i].classes = from.classes;
+            shards[i].builtin = from.builtin;
+        }
+    }
+
+    void GlobalRegistry::registerMethod(const SymbolId className, const SymbolId methodName,
+                                        const SymbolId returnType, const std::vector<SymbolId> &params, const bool isStatic,const int
                                         line, const int column) {
-        std::scoped_lock lock(mtx);
+        if (isFrozen()) throwFrozen(className);
+        // Built before taking the shard lock: interning may take locks of its own.
+        const SymbolId qualifiedName = intern(std::string(nameOf(className)) + "." + std::string(nameOf(methodName)));
+        registerMethod(className, methodName, MethodSignature{returnType, params, isStatic, line, column, qualifiedName});
+    }
+
+    void GlobalRegistry::registerMethod(const SymbolId className, const SymbolId methodName, MethodSignature signature) {
+        if (isFrozen()) throwFrozen(className);
+        Shard& shard = shardFor(className);
+        CountedLock lock(shard.mtx);
 
         // Check for duplicate method definition within the same class.
-        if (methods[className].count(methodName)) {
-            const auto& existing = methods[className][methodName];
+        auto& classMethods = shard.methods[className];
+        if (const auto it = classMethods.find(methodName); it != classMethods.end()) {
+            const auto& existing = it->second;
             const std::string msg =
-                "Semantic Error [" + std::to_string(line) + ":" + std::to_string(column) + "]: " +
-                "Subroutine '" + std::string(methodName) + "' is already defined in class '" +
-                std::string(className) + "' (Previous declaration at line " +
+                "Subroutine '" + std::string(nameOf(methodName)) + "' is already defined in class '" +
+                std::string(nameOf(className)) + "' (Previous declaration at line " +
                 std::to_string(existing.line)+" "+std::to_string(existing.column) + ").";
 
-            throw std::runtime_error(msg);
+            throw CompilationError({"", signature.line, signature.column, DiagnosticPhase::SEMANTIC, msg},
+                                   "Semantic Error [" + std::to_string(signature.line) + ":" +
+                                   std::to_string(signature.column) + "]: " + msg);
         }
 
         // Store the method signature.
-        methods[className][methodName] = {returnType, params, isStatic, line,column};
+        classMethods.emplace(methodName, std::move(signature));
+    }
+
+    void GlobalRegistry::freeze() {
+        if (isFrozen()) return;
+
+        // Gather every class that has either been declared or been given methods.
+        for (Shard& shard : shards) {
+            CountedLock lock(shard.mtx);
+            for (const SymbolId name : shard.classes) {
+                frozenClasses.push_back({name, 0, 0, true});
+            }
+            for (const auto& [name, classMethods] : shard.methods) {
+                if (!shard.classes.count(name)) frozenClasses.push_back({name, 0, 0, false});
+            }
+        }
+        // Sorted by text, so iteration (dumpToNdjson) does not depend on hash order or id assignment.
+        std::sort(frozenClasses.begin(), frozenClasses.end(),
+                  [](const FrozenClass& a, const FrozenClass& b) { return nameOf(a.name) < nameOf(b.name); });
+
+        SymbolId maxId = 0;
+        for (FrozenClass& cls : frozenClasses) {
+            maxId = std::max(maxId, cls.name);
+            if (cls.declared) ++declaredClassCount;
+            Shard& shard = shardFor(cls.name);
+            const auto it = shard.methods.find(cls.name);
+            if (it == shard.methods.end()) continue;
+
+            cls.firstMethod = static_cast<std::uint32_t>(frozenMethods.size());
+            cls.methodCount = static_cast<std::uint32_t>(it->second.size());
+            for (auto& [name, sig] : it->second) frozenMethods.push_back({name, std::move(sig)});
+            std::sort(frozenMethods.begin() + cls.firstMethod, frozenMethods.end(),
+                      [](const FrozenMethod& a, const FrozenMethod& b) { return a.name < b.name; });
+        }
+
+        // Direct-indexed by class id. Ids interned later are simply out of range (unknown classes).
+        classIndexById.assign(frozenClasses.empty() ? 0 : maxId + 1, 0);
+        for (std::uint32_t i = 0; i < frozenClasses.size(); ++i) {
+            classIndexById[frozenClasses[i].name] = i + 1;
+        }
+
+        // The shards are never read again; release them.
+        for (Shard& shard : shards) {
+            shard.methods = {};
+            shard.classes = {};
+            shard.builtin = {};
+        }
+        // Publishes the tables to every thread that observes frozen == true.
+        frozen.store(true, std::memory_order_release);
+    }
+
+    const GlobalRegistry::FrozenClass* GlobalRegistry::findFrozenClass(const SymbolId className) const {
+        if (className >= classIndexById.size() || classIndexById[className] == 0) return nullptr;
+        return &frozenClasses[classIndexById[className] - 1];
     }
 
-    bool GlobalRegistry::classExists(const std::string_view className) const {
+    const MethodSignature* GlobalRegistry::findSignature(const SymbolId className, const SymbolId methodName) const {
+        if (isFrozen()) {
+            const FrozenClass* cls = findFrozenClass(className);
+            if (!cls) return nullptr;
+            const auto first = frozenMethods.begin() + cls->firstMethod;
+            const auto last = first + cls->methodCount;
+            const auto it = std::lower_bound(first, last, methodName,
+                                             [](const FrozenMethod& m, const SymbolId name) { return m.name < name; });
+            return it != last && it->name == methodName ? &it->signature : nullptr;
+        }
+
+        // Registration phase (e.g. a Parser probing for a duplicate). Map nodes never move, so the
+        // pointer stays valid until freeze().
+        const Shard& shard = shardFor(className);
+        CountedLock lock(shard.mtx);
+        // First, check if the class exists in our method map.
+        const auto it = shard.methods.find(className);
+        if (it == shard.methods.end()) {
+            return nullptr;
+        }
+        // Then, check if the method exists within that class.
+        const auto sit = it->second.find(methodName);
+        return sit != it->second.end() ? &sit->second : nullptr;
+    }
+
+    bool GlobalRegistry::classExists(const SymbolId className) const {
         // Built-in primitive types are always considered "existing classes" for type checking purposes.
-        if (className=="int"||className=="boolean"||className=="char") {
+        if (className==sym::INT||className==sym::BOOLEAN||className==sym::CHAR) {
             return true;
         }
 
@@ -50,156 +174,96 @@ namespace nand2tetris::jack {
             true;*/
 
         // Check against the set of user-defined classes registered so far.
-        return classes.count(className);
+        if (isFrozen()) {
+            const FrozenClass* cls = findFrozenClass(className);
+            return cls && cls->declared;
+        }
+        const Shard& shard = shardFor(className);
+        CountedLock lock(shard.mtx);
+        return shard.classes.count(className);
     }
 
-    bool GlobalRegistry::methodExists(const std::string_view className, const std::string_view methodName)const {
-        // First, check if the class exists in our method map.
-        const auto it = methods.find(className);
-        if (it == methods.end()) {
-            return false;
+    bool GlobalRegistry::methodExists(const SymbolId className, const SymbolId methodName)const {
+        return findSignature(className, methodName) != nullptr;
+    }
+
+    const MethodSignature& GlobalRegistry::getSignature(const SymbolId className, const SymbolId methodName) const {
+        if (const MethodSignature* sig = findSignature(className, methodName)) {
+            return *sig;
         }
-        // Then, check if the method exists within that class.
-        return it->second.count(methodName);
-    }
-
-    MethodSignature GlobalRegistry::getSignature(const std::string_view className,
-                                                 const std::string_view methodName) const {
-        // Look up the class.
-        const auto it=methods.find(className);
-        if (it!=methods.end()) {
-            // Look up the method within the class.
-            const auto sit=it->second.find(methodName);
-            if (sit!=it->second.end()) {
-                return sit->second;
+        // If not found, this indicates a logic error in the compiler (caller should have checked existence).
+        throw std::runtime_error("Internal Compiler Error: Signature lookup failed for " + std::string(nameOf(className)) +
+                                 "." + std::string(nameOf(methodName)));
+    }
+
+    std::vector<SymbolId> GlobalRegistry::getMethodNames(const SymbolId className) const {
+        std::vector<SymbolId> names;
+        if (isFrozen()) {
+            if (const FrozenClass* cls = findFrozenClass(className)) {
+                names.reserve(cls->methodCount);
+                for (std::uint32_t i = 0; i < cls->methodCount; ++i) names.push_back(frozenMethods[cls->firstMethod + i].name);
             }
+            return names;
         }
-        // If not found, this indicates a logic error in the compiler (caller should have checked existence).
-        throw std::runtime_error("Internal Compiler Error: Signature lookup failed for " + std::string(className) + "." + std::string(methodName));
+        const Shard& shard = shardFor(className);
+        CountedLock lock(shard.mtx);
+        const auto it = shard.methods.find(className);
+        if (it != shard.methods.end()) {
+            names.reserve(it->second.size());
+            for (const auto& [name, sig] : it->second) names.push_back(name);
+        }
+        return names;
     }
 
     int GlobalRegistry::getClassCount() const {
-        return static_cast<int>(classes.size());
+        if (isFrozen()) return declaredClassCount;
+        int count = 0;
+        for (const Shard& shard : shards) {
+            CountedLock lock(shard.mtx);
+            count += static_cast<int>(shard.classes.size());
+        }
+        return count;
     }
 
     void GlobalRegistry::loadStandardLibrary() {
-        // --- MATH CLASS ---
-        registerClass("Math");
-        registerMethod("Math", "init",      "void", {},             true,  0, 0);
-        registerMethod("Math", "abs",       "int",  {"int"},        true,  0, 0);
-        registerMethod("Math", "multiply",  "int",  {"int", "int"}, true,  0, 0);
-        registerMethod("Math", "divide",    "int",  {"int", "int"}, true,  0, 0);
-        registerMethod("Math", "min",       "int",  {"int", "int"}, true,  0, 0);
-        registerMethod("Math", "max",       "int",  {"int", "int"}, true,  0, 0);
-        registerMethod("Math", "sqrt",      "int",  {"int"},        true,  0, 0);
-        registerMethod("Math","bit","boolean",{"int","int"},true,0,0);
-
-        // --- STRING CLASS ---
-        // Note: Constructors ('new') are usually treated as 'static' in the OS API logic
-        // because you call them on the class (String.new), not an object.
-        registerClass("String");
-        registerMethod("String", "new",           "String", {"int"},           true,  0, 0);
-        registerMethod("String", "dispose",       "void",   {},                false, 0, 0);
-        registerMethod("String", "length",        "int",    {},                false, 0, 0);
-        registerMethod("String", "charAt",        "char",   {"int"},           false, 0, 0);
-        registerMethod("String", "setCharAt",     "void",   {"int", "char"},   false, 0, 0);
-        registerMethod("String", "appendChar",    "String", {"char"},          false, 0, 0);
-        registerMethod("String", "eraseLastChar", "void",   {},                false, 0, 0);
-        registerMethod("String", "intValue",      "int",    {},                false, 0, 0);
-        registerMethod("String", "setInt",        "void",   {"int"},           false, 0, 0);
-        registerMethod("String", "backSpace",     "char",   {},                false, 0, 0);
-        registerMethod("String", "doubleQuote",   "char",   {},                false, 0, 0);
-        registerMethod("String", "newLine",       "char",   {},                false, 0, 0);
-        registerMethod("String","int2String","void",{},false,0,0);
-
-        // --- ARRAY CLASS ---
-        registerClass("Array");
-        registerMethod("Array", "new",     "Array", {"int"}, true,  0, 0);
-        registerMethod("Array", "dispose", "void",  {},      false, 0, 0);
-
-        // --- OUTPUT CLASS ---
-        registerClass("Output");
-        registerMethod("Output", "init", "void", {}, true, 0, 0);
-        registerMethod("Output", "moveCursor", "void", {"int", "int"}, true, 0, 0);
-        registerMethod("Output", "printChar", "void", {"char"}, true, 0, 0);
-        registerMethod("Output", "printString", "void", {"String"}, true, 0, 0);
-        registerMethod("Output", "printInt", "void", {"int"}, true, 0, 0);
-        registerMethod("Output", "println", "void", {}, true, 0, 0);
-        registerMethod("Output", "backSpace", "void", {}, true, 0, 0);
-        registerMethod("Output", "initMap", "void", {}, true, 0, 0);
-        registerMethod("Output", "create", "void", {"int","int","int","int","int","int","int","int","int","int","int","int"}, true, 0, 0);
-        registerMethod("Output", "getMap", "Array", {"char"}, true, 0, 0);
-        registerMethod("Output", "incrementCursor", "void", {}, true, 0, 0);
-        registerMethod("Output", "decrementCursor", "void", {}, true, 0, 0);
-
-        // --- SCREEN CLASS ---
-        registerClass("Screen");
-        registerMethod("Screen", "init",          "void", {},                              true, 0, 0);
-        registerMethod("Screen", "clearScreen",   "void", {},                              true, 0, 0);
-        registerMethod("Screen", "setColor",      "void", {"boolean"},                     true, 0, 0);
-        registerMethod("Screen", "drawPixel",     "void", {"int", "int"},                  true, 0, 0);
-        registerMethod("Screen", "drawLine",      "void", {"int", "int", "int", "int"},    true, 0, 0);
-        registerMethod("Screen", "drawRectangle", "void", {"int", "int", "int", "int"},    true, 0, 0);
-        registerMethod("Screen", "drawCircle",    "void", {"int", "int", "int"},           true, 0, 0);
-
-        // --- KEYBOARD CLASS ---
-        registerClass("Keyboard");
-        registerMethod("Keyboard", "init",       "void",   {},         true, 0, 0);
-        registerMethod("Keyboard", "keyPressed", "char",   {},         true, 0, 0);
-        registerMethod("Keyboard", "readChar",   "char",   {},         true, 0, 0);
-        registerMethod("Keyboard", "readLine",   "String", {"String"}, true, 0, 0);
-        registerMethod("Keyboard", "readInt",    "int",    {"String"}, true, 0, 0);
-
-        // --- MEMORY CLASS ---
-        registerClass("Memory");
-        registerMethod("Memory", "init",    "void", {},             true, 0, 0);
-        registerMethod("Memory", "peek",    "int",  {"int"},        true, 0, 0);
-        registerMethod("Memory", "poke",    "void", {"int", "int"}, true, 0, 0);
-        registerMethod("Memory", "alloc",   "int",  {"int"},        true, 0, 0);
-        registerMethod("Memory", "deAlloc", "void", {"Array"},        true, 0, 0);
-
-        // --- SYS CLASS ---
-        registerClass("Sys");
-        registerMethod("Sys", "init",  "void", {},      true, 0, 0);
-        registerMethod("Sys", "halt",  "void", {},      true, 0, 0);
-        registerMethod("Sys", "error", "void", {"int"}, true, 0, 0);
-        registerMethod("Sys", "wait",  "void", {"int"}, true, 0, 0);
-    }
-
-    void GlobalRegistry::dumpToJSON(const std::string &filename) const {
-        std::ofstream out(filename);
-        out << "{\n";
-        out << "  \"registry\": [\n";
-
-        bool firstMethod = true;
-
-        // Iterate over all classes
-        for (const auto& [className, methodMap] : methods) {
-
-            // Iterate over all methods in this class
-            for (const auto& [methodName, sig] : methodMap) {
-                if (!firstMethod) out << ",\n";
-                firstMethod = false;
-
-                out << "    {\n";
-                out << "      \"class\": \"" << className << "\",\n";
-                out << "      \"method\": \"" << methodName << "\",\n";
-                out << "      \"type\": \"" << (sig.isStatic ? "function" : "method") << "\",\n";
-                out << "      \"return\": \"" << sig.returnType << "\",\n";
-
-                // Format parameters: "int, char"
-                out << "      \"params\": \"";
-                for (size_t i = 0; i < sig.parameters.size(); ++i) {
-                    out << sig.parameters[i];
-                    if (i < sig.parameters.size() - 1) out << ", ";
+        // Generated from os/*.jack at build time, so these are the signatures of the OS we ship.
+        OsImage::load(builtinOsImage(), *this);
+
+        for (Shard& shard : shards) {
+            CountedLock lock(shard.mtx);
+            shard.builtin = shard.classes;
+        }
+    }
+
+    void GlobalRegistry::dumpToNdjson(std::ostream &out) const {
+        const auto writeMethod = [&](const SymbolId className, const SymbolId methodName,
+                                     const MethodSignature& sig) {
+            out << "{\"class\":\"" << nameOf(className) << "\",\"method\":\"" << nameOf(methodName)
+                << "\",\"type\":\"" << (sig.isStatic ? "function" : "method") << "\",\"return\":\""
+                << nameOf(sig.returnType) << "\",\"params\":\"";
+            // Format parameters: "int, char"
+            for (size_t i = 0; i < sig.parameters.size(); ++i) {
+                out << nameOf(sig.parameters[i]);
+                if (i < sig.parameters.size() - 1) out << ", ";
+            }
+            out << "\"}\n";
+        };
+
+        if (isFrozen()) {
+            // Iterate over all classes, then all methods in each class
+            for (const FrozenClass& cls : frozenClasses) {
+                for (std::uint32_t i = 0; i < cls.methodCount; ++i) {
+                    const FrozenMethod& m = frozenMethods[cls.firstMethod + i];
+                    writeMethod(cls.name, m.name, m.signature);
+                }
+            }
+        } else {
+            for (const Shard& shard : shards) {
+                CountedLock lock(shard.mtx);
+                for (const auto& [className, methodMap] : shard.methods) {
+                    for (const auto& [methodName, sig] : methodMap) writeMethod(className, methodName, sig);
                 }
-                out << "\"\n";
-                out << "    }";
             }
         }
-
-        out << "\n  ]\n";
-        out << "}\n";
-        out.close();
     }
 }
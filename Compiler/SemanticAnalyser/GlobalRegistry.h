@@ -4,12 +4,16 @@
 
 #ifndef NAND2TETRIS_GLOBAL_REGISTRY_H
 #define NAND2TETRIS_GLOBAL_REGISTRY_H
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <mutex>
 #include <fstream>
 #include <sstream>
+#include "../Interner/StringInterner.h"
 
 namespace nand2tetris::jack {
 
@@ -17,11 +21,23 @@ namespace nand2tetris::jack {
      * @brief Represents the signature of a Jack subroutine (method, function, or constructor).
      */
     struct MethodSignature {
-        std::string_view returnType;        ///< The return type of the subroutine (e.g., "int", "void").
-        std::vector<std::string_view> parameters; ///< List of parameter types.
+        SymbolId returnType;                ///< The return type of the subroutine (e.g., "int", "void").
+        std::vector<SymbolId> parameters;   ///< List of parameter types.
         bool isStatic;                      ///< True if this is a static function.
         int line;                           ///< Line number of the declaration.
         int column;                         ///< Column number of the declaration.
+        SymbolId qualifiedName;             ///< "Class.method", interned once at registration for the VM code.
+    };
+
+    /**
+     * @brief A registry lookup made while analysing a class.
+     *
+     * Recorded so the incremental build cache can tell which signatures a class's output depends on.
+     * A methodName of NO_SYMBOL stands for a classExists() check.
+     */
+    struct RegistryDependency {
+        SymbolId className;
+        SymbolId methodName;
     };
 
     /**
@@ -30,18 +46,46 @@ namespace nand2tetris::jack {
      * This class is used to perform semantic analysis, such as checking if a called method exists
      * and if the arguments match the expected parameters. It acts as a global symbol table for
      * class and subroutine definitions.
+     *
+     * Classes, methods and types are identified by interned SymbolIds, so every lookup compares
+     * integers rather than strings.
+     *
+     * It is used in two phases. While parsing, classes are registered into shards selected by
+     * class id, so parallel Parsers only contend when they land on the same shard. freeze() then
+     * moves everything into flat, immutable tables indexed by class id, which the analysis and
+     * code generation threads read without any locking or copying.
      */
     class GlobalRegistry {
         public:
             GlobalRegistry();
             ~GlobalRegistry()=default;
 
+            /**
+             * @brief Copies another registry, in whichever phase it is.
+             *
+             * Copying a registry that holds only the built-in OS classes is much cheaper than
+             * building one, so a long-lived compiler keeps such a registry pre-warmed and starts
+             * every build from a copy. 'other' may be read (or copied) by other threads meanwhile,
+             * but must not be registered into.
+             */
+            GlobalRegistry(const GlobalRegistry& other);
+            GlobalRegistry& operator=(const GlobalRegistry&) = delete;
+
             /**
              * @brief Registers a new class in the registry.
              *
+             * The existence check and the insert are one atomic step, so two Parsers racing on the
+             * same name cannot both succeed.
+             *
+             * A built-in OS class (see loadStandardLibrary()) may be registered once more, by its
+             * source file (e.g. os/Math.jack); its built-in signatures are then dropped in favour of
+             * the ones that file declares.
+             *
              * @param className The name of the class to register.
+             * @return False if the class was already registered.
+             * @throws std::runtime_error If the registry has been frozen.
              */
-            void registerClass(std::string_view className);
+            bool registerClass(SymbolId className);
 
             /**
              * @brief Registers a new method (or function/constructor) for a specific class.
@@ -53,10 +97,30 @@ namespace nand2tetris::jack {
              * @param isStatic True if the method is static (function).
              * @param line The line number of the declaration.
              * @param column The column number of the declaration.
-             * @throws std::runtime_error If the method is already defined in the class.
+             * @throws std::runtime_error If the method is already defined in the class, or the registry has been frozen.
+             */
+            void registerMethod(SymbolId className, SymbolId methodName, SymbolId returnType,
+                                const std::vector<SymbolId> &params, bool isStatic, int line, int column);
+
+            /**
+             * @brief Registers a signature taken from another registry (its qualifiedName already set).
+             *
+             * @throws std::runtime_error If the method is already defined in the class, or the registry has been frozen.
              */
-            void registerMethod(std::string_view className, std::string_view methodName, std::string_view returnType,
-                                const std::vector<std::string_view> &params, bool isStatic, int line, int column);
+            void registerMethod(SymbolId className, SymbolId methodName, MethodSignature signature);
+
+            /**
+             * @brief Ends the registration phase and builds the read-only lookup tables.
+             *
+             * Must be called once every registration has finished (i.e. after the parse barrier)
+             * and before the lookups are used from several threads. Calling it again is a no-op.
+             */
+            void freeze();
+
+            /**
+             * @brief True once freeze() has run.
+             */
+            bool isFrozen() const { return frozen.load(std::memory_order_acquire); }
 
             /**
              * @brief Checks if a class exists in the registry.
@@ -66,7 +130,7 @@ namespace nand2tetris::jack {
              * @param className The name of the class to check.
              * @return True if the class exists or is a built-in type, false otherwise.
              */
-            bool classExists(std::string_view className) const;
+            bool classExists(SymbolId className) const;
 
             /**
              * @brief Checks if a method exists within a specific class.
@@ -75,17 +139,25 @@ namespace nand2tetris::jack {
              * @param methodName The name of the method.
              * @return True if the method exists, false otherwise.
              */
-            bool methodExists(std::string_view className,std::string_view methodName)const;
+            bool methodExists(SymbolId className,SymbolId methodName)const;
 
             /**
              * @brief Retrieves the signature of a specific method.
              *
              * @param className The name of the class.
              * @param methodName The name of the method.
-             * @return The MethodSignature struct containing details about the method.
+             * @return The MethodSignature struct containing details about the method; valid as long as the registry.
              * @throws std::runtime_error If the method is not found.
              */
-            MethodSignature getSignature(std::string_view className,std::string_view methodName) const;
+            const MethodSignature& getSignature(SymbolId className,SymbolId methodName) const;
+
+            /**
+             * @brief Lists the subroutines registered for a class.
+             *
+             * @param className The name of the class.
+             * @return The method names (in no particular order); empty if the class is unknown.
+             */
+            std::vector<SymbolId> getMethodNames(SymbolId className) const;
 
             /**
              * @brief Returns the number of registered classes.
@@ -94,16 +166,61 @@ namespace nand2tetris::jack {
             int getClassCount()const;
 
             /**
-             * @brief Exports the entire registry to a JSON file for debugging.
-             * @param filename The output path (e.g., "registry_dump.json").
+             * @brief Exports the entire registry as newline-delimited JSON, one method per line.
+             *
+             * Read by tools/global_registry_viz.py.
+             *
+             * @param out Where to write it.
              */
-            void dumpToJSON(const std::string& filename) const;
+            void dumpToNdjson(std::ostream& out) const;
         private:
-            // Map: ClassName -> (MethodName -> Signature)
-            std::unordered_map<std::string_view,std::unordered_map<std::string_view,MethodSignature>> methods;
-            // Set: ClassNames
-            std::unordered_set<std::string_view> classes;
-            mutable std::mutex mtx; // Thread safety
+            static constexpr std::size_t SHARD_COUNT = 16; ///< Power of two; plenty for one Parser per core.
+
+            // Registration phase: one lock per shard.
+            struct Shard {
+                // Map: ClassName -> (MethodName -> Signature)
+                std::unordered_map<SymbolId,std::unordered_map<SymbolId,MethodSignature>> methods;
+                // Set: ClassNames
+                std::unordered_set<SymbolId> classes;
+                // Built-in OS classes that no source file has replaced yet.
+                std::unordered_set<SymbolId> builtin;
+                mutable std::mutex mtx;
+            };
+            std::array<Shard, SHARD_COUNT> shards;
+
+            // Frozen phase: every class's methods sit contiguously in 'frozenMethods', sorted by id.
+            struct FrozenMethod {
+                SymbolId name;
+                MethodSignature signature;
+            };
+            struct FrozenClass {
+                SymbolId name;
+                std::uint32_t firstMethod;
+                std::uint32_t methodCount;
+                bool declared; ///< Registered with registerClass() (not just given methods).
+            };
+            std::vector<FrozenClass> frozenClasses;       ///< Sorted by class name, for stable dumps.
+            std::vector<FrozenMethod> frozenMethods;
+            std::vector<std::uint32_t> classIndexById;    ///< SymbolId -> index into frozenClasses (+1; 0 = unknown).
+            int declaredClassCount = 0;
+            std::atomic<bool> frozen{false};
+
+            Shard& shardFor(const SymbolId className) { return shards[className & (SHARD_COUNT - 1)]; }
+            const Shard& shardFor(const SymbolId className) const { return shards[className & (SHARD_COUNT - 1)]; }
+
+            /**
+             * @brief The frozen entry for a class, or nullptr.
+             */
+            const FrozenClass* findFrozenClass(SymbolId className) const;
+
+            /**
+             * @brief Looks a method up in either phase; nullptr if it does not exist.
+             */
+            const MethodSignature* findSignature(SymbolId className, SymbolId methodName) const;
+
+            /**
+             * @brief Registers the built-in OS classes from builtinOsImage().
+             */
             void loadStandardLibrary();
     };
 }
@@ -6,61 +6,104 @@
 #include <stdexcept>
 
 namespace nand2tetris::jack {
-    SemanticAnalyser::SemanticAnalyser(const GlobalRegistry &registry):registry(registry){};
+    SemanticAnalyser::SemanticAnalyser(const GlobalRegistry &registry, std::vector<RegistryDependency>* dependencies,
+                                       DiagnosticSink* diagnostics)
+        :registry(registry),dependencies(dependencies),diagnostics(diagnostics){};
+
+    void SemanticAnalyser::recordLookup(const SymbolId className, const SymbolId methodName) const {
+        // methodExists() is almost always followed by getSignature() on the same name; keep one.
+        if (!dependencies->empty() && dependencies->back().className == className &&
+            dependencies->back().methodName == methodName) {
+            return;
+        }
+        dependencies->push_back({className, methodName});
+    }
+
+    bool SemanticAnalyser::classExists(const SymbolId className) const {
+        if (dependencies) recordLookup(className, NO_SYMBOL);
+        return registry.classExists(className);
+    }
+
+    bool SemanticAnalyser::methodExists(const SymbolId className, const SymbolId methodName) const {
+        if (dependencies) recordLookup(className, methodName);
+        return registry.methodExists(className, methodName);
+    }
+
+    const MethodSignature& SemanticAnalyser::getSignature(const SymbolId className, const SymbolId methodName) const {
+        if (dependencies) recordLookup(className, methodName);
+        return registry.getSignature(className, methodName);
+    }
 
     void SemanticAnalyser::error(const std::string_view message, const Node &node) const {
         // Format error message with file, line, and column information.
-        throw std::runtime_error("Semantic Error [" + std::string(currentClassName) + ".jack:" +
+        throw CompilationError({"", node.getLine(), node.getCol(), DiagnosticPhase::SEMANTIC, std::string(message)},
+            "Semantic Error [" + std::string(nameOf(currentClassName)) + ".jack:" +
             std::to_string(node.getLine()) + ":" + std::to_string(node.getCol()) + "]: " +
             std::string(message));
     }
 
-    void SemanticAnalyser::checkTypeMatch(const std::string_view expected, const std::string_view actual, const Node &locationNode) const {
+    void SemanticAnalyser::reportError(const std::string_view message, const Node &node) const {
+        if (!diagnostics) error(message, node);
+        diagnostics->report({"", node.getLine(), node.getCol(), DiagnosticPhase::SEMANTIC, std::string(message)});
+    }
+
+    void SemanticAnalyser::recover(const CompilationError &e) const {
+        if (!diagnostics) throw e;
+        diagnostics->report(e.getDiagnostic());
+    }
+
+    bool SemanticAnalyser::isAssignable(const SymbolId expected, const SymbolId actual) {
         // 1. Exact Match
-        if (expected == actual) return;
+        if (expected == actual) return true;
 
         // 2. Handle 'null' (assignable to any object)
-        if (actual == "null") return;
+        if (actual == sym::NULL_TYPE) return true;
 
         // Helper booleans
         // Note: void is not a primitive or an object variable type
-        const bool expectedIsPrimitive = (expected == "int" || expected == "char" || expected == "boolean");
-        const bool actualIsPrimitive   = (actual == "int" || actual == "char" || actual == "boolean");
+        const bool expectedIsPrimitive = (expected == sym::INT || expected == sym::CHAR || expected == sym::BOOLEAN);
+        const bool actualIsPrimitive   = (actual == sym::INT || actual == sym::CHAR || actual == sym::BOOLEAN);
 
-        const bool expectedIsObject = !expectedIsPrimitive && expected != "void";
-        const bool actualIsObject   = !actualIsPrimitive   && actual != "void";
+        const bool expectedIsObject = !expectedIsPrimitive && expected != sym::VOID;
+        const bool actualIsObject   = !actualIsPrimitive   && actual != sym::VOID;
 
         // 3. Primitives are fluid (int <-> char <-> boolean)
         // Jack allows mixing these freely (e.g. math with chars, bools as ints)
         if (expectedIsPrimitive && actualIsPrimitive) {
-            return;
+            return true;
         }
 
         // 4. Int as Universal Pointer (The "Void*" of Jack)
 
         // Case A: Object -> int
         // (e.g. if (student == 0), or let address = student)
-        if (expected == "int" && actualIsObject) {
-            return;
+        if (expected == sym::INT && actualIsObject) {
+            return true;
         }
 
         // Case B: int -> Object (Your previous error)
         // (e.g. let student = array[i]; // array access returns int)
-        if (expectedIsObject && actual == "int") {
-            return;
+        if (expectedIsObject && actual == sym::INT) {
+            return true;
         }
 
         // 5. Array as Generic Object (The "Memory" fix)
 
         // Case C: Object -> Array
         // (e.g. do Memory.deAlloc(student); )
-        if (expected == "Array" && actualIsObject) {
-            return;
+        if (expected == sym::ARRAY && actualIsObject) {
+            return true;
         }
 
+        return false;
+    }
+
+    void SemanticAnalyser::checkTypeMatch(const SymbolId expected, const SymbolId actual, const Node &locationNode) const {
+        if (isAssignable(expected, actual)) return;
+
         // If none of the above pass, it is a genuine error.
         // e.g. Assigning 'Student' to 'School' (where neither is Array/int)
-        error("Type Mismatch. Expected '" + std::string(expected) + "', Got '" + std::string(actual) + "'", locationNode);
+        error("Type Mismatch. Expected '" + std::string(nameOf(expected)) + "', Got '" + std::string(nameOf(actual)) + "'", locationNode);
     }
 
     void SemanticAnalyser::analyseClass(const ClassNode& class_node,SymbolTable& table) {
@@ -68,23 +111,31 @@ namespace nand2tetris::jack {
 
 
         // 1. Process Class Variables (Static/Field)
-        for (const std::unique_ptr<ClassVarDecNode>& var:class_node.classVars) {
+        for (const ClassVarDecNode* var:class_node.classVars) {
             const SymbolKind kind = (var->kind == ClassVarKind::STATIC) ? SymbolKind::STATIC : SymbolKind::FIELD;
 
             // Verify the type exists (if it's a class type)
-            if (!registry.classExists(var->type)) {
-                error("Unknown type '" + std::string(var->type) + "'", *var);
+            if (!classExists(var->type)) {
+                reportError("Unknown type '" + std::string(nameOf(var->type)) + "'", *var);
             }
 
             // Add variables to the class-level symbol table
-            for (const std::string_view& name : var->varNames) {
-                table.define(name, var->type, kind,var->getLine(),var->getCol());
+            for (const SymbolId name : var->varNames) {
+                try {
+                    table.define(name, var->type, kind,var->getLine(),var->getCol());
+                } catch (const CompilationError& e) {
+                    recover(e);
+                }
             }
         }
 
         // 2. Process Subroutines
-        for (const std::unique_ptr<SubroutineDecNode>& sub : class_node.subroutineDecs) {
-            analyseSubroutine(*sub, table);
+        for (const SubroutineDecNode* sub : class_node.subroutineDecs) {
+            try {
+                analyseSubroutine(*sub, table);
+            } catch (const CompilationError& e) {
+                recover(e); // A broken declaration: its statements are not checked.
+            }
         }
     }
 
@@ -97,9 +148,9 @@ namespace nand2tetris::jack {
 
         if (currentSubroutineKind == "constructor") {
             if (sub.returnType != currentClassName) {
-                error("Constructor '" + std::string(sub.name) +
-                  "' must return type '" + std::string(currentClassName) +
-                  "', but found '" + std::string(sub.name) + "'.",
+                error("Constructor '" + std::string(nameOf(sub.name)) +
+                  "' must return type '" + std::string(nameOf(currentClassName)) +
+                  "', but found '" + std::string(nameOf(sub.name)) + "'.",
                   sub);
             }
         }
@@ -110,23 +161,23 @@ namespace nand2tetris::jack {
         // 2. Define 'this' for methods
         //  operate on the current instance, so 'this' is the first implicit argument.
         if (sub.subType == SubroutineType::METHOD) {
-            table.define("this", currentClassName, SymbolKind::ARG, sub.getLine(), 0);
+            table.define(sym::THIS, currentClassName, SymbolKind::ARG, sub.getLine(), 0);
         }
 
         // 3. Define Arguments
         for (const auto&[type, name] : sub.parameters) {
-            if (!registry.classExists(type)) {
-                error("Unknown type '" + std::string(type) + "' for argument '" + std::string(name) + "'", sub);
+            if (!classExists(type)) {
+                reportError("Unknown type '" + std::string(nameOf(type)) + "' for argument '" + std::string(nameOf(name)) + "'", sub);
             }
             table.define(name, type, SymbolKind::ARG, sub.getLine(), 0);
         }
 
         // 4. Define Local Variables
-        for (const std::unique_ptr<VarDecNode>& varDecl : sub.localVars) {
-            if (!registry.classExists(varDecl->type)) {
-                error("Unknown type '" + std::string(varDecl->type) + "'", *varDecl);
+        for (const VarDecNode* varDecl : sub.localVars) {
+            if (!classExists(varDecl->type)) {
+                reportError("Unknown type '" + std::string(nameOf(varDecl->type)) + "'", *varDecl);
             }
-            for (const std::string_view& name : varDecl->varNames) {
+            for (const SymbolId name : varDecl->varNames) {
                 table.define(name, varDecl->type, SymbolKind::LCL, varDecl->getLine(), varDecl->getCol());
             }
         }
@@ -136,26 +187,30 @@ namespace nand2tetris::jack {
     }
 
 
-    void SemanticAnalyser::analyseStatements(const std::vector<std::unique_ptr<StatementNode> > &stmts, SymbolTable &table) const {
-        for (const std::unique_ptr<StatementNode>& stmt : stmts) {
-            switch (stmt->getType()) {
-                case ASTNodeType::LET_STATEMENT:
-                    analyseLet(static_cast<const LetStatementNode&>(*stmt), table); // NOLINT(*-pro-type-static-cast-downcast)
-                    break;
-                case ASTNodeType::DO_STATEMENT:
-                    analyseDo(static_cast<const DoStatementNode&>(*stmt), table); // NOLINT(*-pro-type-static-cast-downcast)
-                    break;
-                case ASTNodeType::IF_STATEMENT:
-                    analyseIf(static_cast<const IfStatementNode&>(*stmt), table); // NOLINT(*-pro-type-static-cast-downcast)
-                    break;
-                case ASTNodeType::WHILE_STATEMENT:
-                    analyseWhile(static_cast<const WhileStatementNode&>(*stmt), table); // NOLINT(*-pro-type-static-cast-downcast)
-                    break;
-                case ASTNodeType::RETURN_STATEMENT:
-                    analyseReturn(static_cast<const ReturnStatementNode&>(*stmt), table); // NOLINT(*-pro-type-static-cast-downcast)
-                    break;
-                default:
-                    error("Unknown statement type found in AST", *stmt);
+    void SemanticAnalyser::analyseStatements(const ArenaList<StatementNode*> &stmts, SymbolTable &table) const {
+        for (const StatementNode* stmt : stmts) {
+            try {
+                switch (stmt->getType()) {
+                    case ASTNodeType::LET_STATEMENT:
+                        analyseLet(static_cast<const LetStatementNode&>(*stmt), table); // NOLINT(*-pro-type-static-cast-downcast)
+                        break;
+                    case ASTNodeType::DO_STATEMENT:
+                        analyseDo(static_cast<const DoStatementNode&>(*stmt), table); // NOLINT(*-pro-type-static-cast-downcast)
+                        break;
+                    case ASTNodeType::IF_STATEMENT:
+                        analyseIf(static_cast<const IfStatementNode&>(*stmt), table); // NOLINT(*-pro-type-static-cast-downcast)
+                        break;
+                    case ASTNodeType::WHILE_STATEMENT:
+                        analyseWhile(static_cast<const WhileStatementNode&>(*stmt), table); // NOLINT(*-pro-type-static-cast-downcast)
+                        break;
+                    case ASTNodeType::RETURN_STATEMENT:
+                        analyseReturn(static_cast<const ReturnStatementNode&>(*stmt), table); // NOLINT(*-pro-type-static-cast-downcast)
+                        break;
+                    default:
+                        error("Unknown statement type found in AST", *stmt);
+                }
+            } catch (const CompilationError& e) {
+                recover(e); // Go on with the next statement.
             }
         }
     }
@@ -163,23 +218,23 @@ namespace nand2tetris::jack {
     void SemanticAnalyser::analyseLet(const LetStatementNode &node, SymbolTable &table)const{
         // 1. Check Variable Existence
         if (table.kindOf(node.varName) == SymbolKind::NONE) {
-            error("Undefined variable '" + std::string(node.varName) + "'", node);
+            error("Undefined variable '" + std::string(nameOf(node.varName)) + "'", node);
         }
-        const std::string_view varType = table.typeOf(node.varName);
+        const SymbolId varType = table.typeOf(node.varName);
 
         // 2. Array Indexing Check
         if (node.indexExpr) {
-            if (varType != "Array") {
-                error("Cannot index non-array variable '" + std::string(node.varName) + "'", node);
+            if (varType != sym::ARRAY) {
+                error("Cannot index non-array variable '" + std::string(nameOf(node.varName)) + "'", node);
             }
-            const std::string_view idxType = analyseExpression(*node.indexExpr, table);
-            if (idxType != "int") {
+            const SymbolId idxType = analyseExpression(*node.indexExpr, table);
+            if (idxType != sym::INT && idxType != sym::CHAR) { // A char is a character code (e.g. a lookup table)
                 error("Array index must be an integer.", *node.indexExpr);
             }
         }
 
         // 3. Value Check
-        const std::string_view exprType = analyseExpression(*node.valueExpr, table);
+        const SymbolId exprType = analyseExpression(*node.valueExpr, table);
 
         // If it's a standard assignment (not array index), types must match.
         // Note: Array element assignment (arr[i] = x) is not strictly type-checked in standard Jack
@@ -191,8 +246,8 @@ namespace nand2tetris::jack {
     }
 
     void SemanticAnalyser::analyseIf(const IfStatementNode &node, SymbolTable &table)const {
-        const std::string_view condType = analyseExpression(*node.condition, table);
-        if (condType != "boolean") {
+        const SymbolId condType = analyseExpression(*node.condition, table);
+        if (condType != sym::BOOLEAN) {
             error("If condition must be boolean.", *node.condition);
         }
         analyseStatements(node.ifStatements, table);
@@ -208,16 +263,16 @@ namespace nand2tetris::jack {
     }
 
     void SemanticAnalyser::analyseWhile(const WhileStatementNode &node, SymbolTable &table)const {
-        const std::string_view condType = analyseExpression(*node.condition, table);
-        if (condType != "boolean") {
+        const SymbolId condType = analyseExpression(*node.condition, table);
+        if (condType != sym::BOOLEAN) {
             error("While condition must be boolean.", *node.condition);
         }
         analyseStatements(node.body, table);
     }
 
     void SemanticAnalyser::analyseReturn(const ReturnStatementNode &node, SymbolTable &table) const {
-        const MethodSignature sig = registry.getSignature(currentClassName, currentSubroutineName);
-        const std::string_view requiredType = sig.returnType;
+        const MethodSignature& sig = getSignature(currentClassName, currentSubroutineName);
+        const SymbolId requiredType = sig.returnType;
 
         // 1. Constructor Rules
         if (currentSubroutineKind == "constructor") {
@@ -233,7 +288,7 @@ namespace nand2tetris::jack {
         }
 
         // 2. Void Function Rules
-        if (requiredType == "void") {
+        if (requiredType == sym::VOID) {
             if (node.expression) {
                 error("Void function cannot return a value.", *node.expression);
             }
@@ -241,139 +296,141 @@ namespace nand2tetris::jack {
         // 3. Value Function Rules
         else {
             if (!node.expression) {
-                error("Function must return a value of type '" + std::string(requiredType) + "'.", node);
+                error("Function must return a value of type '" + std::string(nameOf(requiredType)) + "'.", node);
             }
-            const std::string_view actualType = analyseExpression(*node.expression, table);
+            const SymbolId actualType = analyseExpression(*node.expression, table);
             checkTypeMatch(requiredType, actualType, *node.expression);
         }
     }
 
 
-    std::string_view SemanticAnalyser::analyseExpression(const ExpressionNode &node, SymbolTable &table) const {
+    SymbolId SemanticAnalyser::analyseExpression(const ExpressionNode &node, SymbolTable &table) const {
         switch (node.getType()) {
             case ASTNodeType::INTEGER_LITERAL:
-                return "int";
+                return sym::INT;
             case ASTNodeType::STRING_LITERAL:
-                return "String";
+                return sym::STRING;
             case ASTNodeType::KEYWORD_LITERAL: {
                 const auto& n = static_cast<const KeywordLiteralNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
                 switch(n.value) {
                     case Keyword::TRUE_:
-                    case Keyword::FALSE_: return "boolean";
+                    case Keyword::FALSE_: return sym::BOOLEAN;
                     case Keyword::THIS_:
                         if (currentSubroutineKind == "function") {
                             error("'this' cannot be used in a static function.", node);
                         }
                         return currentClassName;
-                    case Keyword::NULL_:  return "null";
-                    default: return "void";
+                    case Keyword::NULL_:  return sym::NULL_TYPE;
+                    default: return sym::VOID;
                 }
             }
 
             case ASTNodeType::IDENTIFIER: {
                 auto& n = static_cast<const IdentifierNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
-                const std::string_view type = table.typeOf(n.name);
-                if (type.empty()) {
-                    error("Undefined variable '" + std::string(n.name) + "'", node);
+                const SymbolId type = table.typeOf(n.name);
+                if (type == NO_SYMBOL) {
+                    error("Undefined variable '" + std::string(nameOf(n.name)) + "'", node);
                 }
                 if (n.indexExpr) {
-                    if (type != "Array") error("Cannot index non-array variable.", node);
-                    if (analyseExpression(*n.indexExpr, table) != "int") {
+                    if (type != sym::ARRAY) error("Cannot index non-array variable.", node);
+                    const SymbolId idxType = analyseExpression(*n.indexExpr, table);
+                    if (idxType != sym::INT && idxType != sym::CHAR) {
                         error("Array index must be an integer.", *n.indexExpr);
                     }
-                    return "int"; // Array access is always int
+                    return sym::INT; // Array access is always int
                 }
                 // Return the type directly from the table to avoid local variable reference issues.
                 return table.typeOf(n.name);
             }
             case ASTNodeType::BINARY_OP: {
                 auto& n = static_cast<const BinaryOpNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
-                const std::string_view left = analyseExpression(*n.left, table);
-                const std::string_view right = analyseExpression(*n.right, table);
+                const SymbolId left = analyseExpression(*n.left, table);
+                const SymbolId right = analyseExpression(*n.right, table);
 
                 // Math (+ - * /) -> Returns INT
                 if (std::string("+-*/").find(n.op) != std::string::npos) {
-                    checkTypeMatch("int", left, *n.left);
-                    checkTypeMatch("int", right, *n.right);
-                    return "int";
+                    checkTypeMatch(sym::INT, left, *n.left);
+                    checkTypeMatch(sym::INT, right, *n.right);
+                    return sym::INT;
                 }
 
                 // Inequality (< >) -> Returns BOOLEAN
                 if (n.op == '<' || n.op == '>') {
-                    checkTypeMatch("int", left, *n.left);
-                    checkTypeMatch("int", right, *n.right);
-                    return "boolean";
+                    checkTypeMatch(sym::INT, left, *n.left);
+                    checkTypeMatch(sym::INT, right, *n.right);
+                    return sym::BOOLEAN;
                 }
 
                 // Equality (=) -> Returns BOOLEAN
                 if (n.op == '=') {
-                    // Allow (Alien == Alien) or (Alien == null) or (int == int)
-                    if (left != right && left != "null" && right != "null") {
-                        error("Comparison type mismatch: " + std::string(left) + " vs " + std::string(right), node);
+                    // Allow (Alien == Alien), (Alien == null), (int == int) and, as for assignment,
+                    // an object compared with an address (heap = 0).
+                    if (!isAssignable(left, right) && !isAssignable(right, left)) {
+                        error("Comparison type mismatch: " + std::string(nameOf(left)) + " vs " + std::string(nameOf(right)), node);
                     }
-                    return "boolean";
+                    return sym::BOOLEAN;
                 }
 
                 // Logic (& |) -> Returns BOOLEAN
                 if (n.op == '&' || n.op == '|') {
-                    checkTypeMatch("boolean", left, *n.left);
-                    checkTypeMatch("boolean", right, *n.right);
-                    return "boolean";
+                    checkTypeMatch(sym::BOOLEAN, left, *n.left);
+                    checkTypeMatch(sym::BOOLEAN, right, *n.right);
+                    return sym::BOOLEAN;
                 }
-                return "void";
+                return sym::VOID;
             }
 
             case ASTNodeType::UNARY_OP: {
                 auto& n = static_cast<const UnaryOpNode&>(node); // NOLINT(*-pro-type-static-cast-downcast)
-                const std::string_view inner = analyseExpression(*n.term, table);
+                const SymbolId inner = analyseExpression(*n.term, table);
 
                 if (n.op == '-') {
-                    checkTypeMatch("int", inner, *n.term);
-                    return "int";
+                    checkTypeMatch(sym::INT, inner, *n.term);
+                    return sym::INT;
                 }
                 if (n.op == '~') {
-                    checkTypeMatch("boolean", inner, *n.term);
-                    return "boolean";
+                    checkTypeMatch(sym::BOOLEAN, inner, *n.term);
+                    return sym::BOOLEAN;
                 }
-                return "void";
+                return sym::VOID;
             }
             case ASTNodeType::SUBROUTINE_CALL: {
                 auto& n = static_cast<const CallNode&>(node);  // NOLINT(*-pro-type-static-cast-downcast)
                 return analyseSubroutineCall(n.classNameOrVar, n.functionName, n.arguments, table, node);
 			}
 			default:
-				return "void";
+				return sym::VOID;
 		}
 
 	}
 
 
-	std::string_view SemanticAnalyser::analyseSubroutineCall(const std::string_view classNameOrVar, const std::string_view functionName,
-		const std::vector<std::unique_ptr<ExpressionNode> > &args, SymbolTable &table, const Node &locationNode) const {
-		std::string_view targetClass;
-        const std::string_view targetMethod = functionName;
+	SymbolId SemanticAnalyser::analyseSubroutineCall(const SymbolId classNameOrVar, const SymbolId functionName,
+		const ArenaList<ExpressionNode*> &args, SymbolTable &table, const Node &locationNode) const {
+		SymbolId targetClass;
+        const SymbolId targetMethod = functionName;
         bool isMethodCall = false;
 
         // 1. Determine Target Class and Call Type
-        if (classNameOrVar.empty()) { // Implicit 'this' call: foo()
+        if (classNameOrVar == NO_SYMBOL) { // Implicit 'this' call: foo()
             targetClass = currentClassName;
-        	if (!registry.methodExists(targetClass,targetMethod)) {
-        		error("Method '" + std::string(targetMethod) + "' not found in class '" + std::string(targetClass) +
+        	if (!methodExists(targetClass,targetMethod)) {
+        		error("Method '" + std::string(nameOf(targetMethod)) + "' not found in class '" + std::string(nameOf(targetClass)) +
         			"'", locationNode);
         	}
-            const auto sig = registry.getSignature(targetClass, targetMethod);
+            const auto& sig = getSignature(targetClass, targetMethod);
             if (currentSubroutineKind == "function" && !sig.isStatic) {
-                 error("Cannot call method '" + std::string(functionName) + "' from static function without object.", locationNode);
+                 error("Cannot call method '" + std::string(nameOf(functionName)) + "' from static function without object.", locationNode);
             }
             isMethodCall = !sig.isStatic;
         } else {
-            const std::string_view type = table.typeOf(classNameOrVar);
-            if (!type.empty()) { // It's a Variable: a.foo()
+            const SymbolId type = table.typeOf(classNameOrVar);
+            if (type != NO_SYMBOL) { // It's a Variable: a.foo()
                 targetClass = type;
                 isMethodCall = true;
             } else { // It's a Class: Math.abs()
-                if (!registry.classExists(classNameOrVar)) {
-                    error("Undefined class '" + std::string(classNameOrVar) + "'", locationNode);
+                if (!classExists(classNameOrVar)) {
+                    error("Undefined class '" + std::string(nameOf(classNameOrVar)) + "'", locationNode);
                 }
                 targetClass = classNameOrVar;
                 isMethodCall = false;
@@ -381,18 +438,18 @@ namespace nand2tetris::jack {
         }
 
         // 2. Verify Method Existence
-        if (!registry.methodExists(targetClass, targetMethod)) {
-            error("Method '" + std::string(targetMethod) + "' not found in class '" + std::string(targetClass) + "'", locationNode);
+        if (!methodExists(targetClass, targetMethod)) {
+            error("Method '" + std::string(nameOf(targetMethod)) + "' not found in class '" + std::string(nameOf(targetClass)) + "'", locationNode);
         }
 
-        const auto sig = registry.getSignature(targetClass, targetMethod);
+        const auto& sig = getSignature(targetClass, targetMethod);
 
         // 3. Static/Method Mismatch Checks
         if (isMethodCall && sig.isStatic) {
-            error("Cannot call static function '" + std::string(targetMethod) + "' on an object instance.", locationNode);
+            error("Cannot call static function '" + std::string(nameOf(targetMethod)) + "' on an object instance.", locationNode);
         }
         if (!isMethodCall && !sig.isStatic) {
-            error("Cannot call method '" + std::string(targetMethod) + "' as a static function.", locationNode);
+            error("Cannot call method '" + std::string(nameOf(targetMethod)) + "' as a static function.", locationNode);
         }
 
         // 4. Argument Count Check
@@ -403,7 +460,7 @@ namespace nand2tetris::jack {
 
         // 5. Argument Type Check
         for (size_t i = 0; i < args.size(); ++i) {
-            const std::string_view argType = analyseExpression(*args[i], table);
+            const SymbolId argType = analyseExpression(*args[i], table);
             checkTypeMatch(sig.parameters[i], argType, *args[i]);
         }
 
@@ -9,6 +9,7 @@
 #include "GlobalRegistry.h"
 #include "SymbolTable.h"
 #include "../Parser/AST.h"
+#include "../Diagnostics/Diagnostics.h"
 
 namespace nand2tetris::jack{
 
@@ -25,33 +26,59 @@ namespace nand2tetris::jack{
              * @brief Constructs a SemanticAnalyser.
              *
              * @param registry The global registry containing class and method signatures.
+             * @param dependencies If set, every registry lookup is appended here (for the build cache).
+             * @param diagnostics If set, errors are collected there and the analysis goes on with the
+             *                    next statement (or declaration) instead of stopping at the first.
              */
-            explicit SemanticAnalyser(const GlobalRegistry& registry);
+            explicit SemanticAnalyser(const GlobalRegistry& registry, std::vector<RegistryDependency>* dependencies = nullptr,
+                                      DiagnosticSink* diagnostics = nullptr);
 
             /**
              * @brief Analyzes a class node and its contents.
              *
              * @param class_node The root node of the class AST.
              * @param table The symbol table to use for analysis.
-             * @throws std::runtime_error if any semantic error is found.
+             * @throws CompilationError on the first semantic error, without a DiagnosticSink.
+             * @throws CompilationStopped with one, once the build's error limit is reached.
              */
             void analyseClass(const ClassNode& class_node,SymbolTable& table);
         private:
             const GlobalRegistry& registry; ///< Reference to the global registry.
+            std::vector<RegistryDependency>* dependencies; ///< Lookup log, or nullptr when not recording.
+            DiagnosticSink* diagnostics;                   ///< Collected errors, or nullptr to throw the first.
 
             // State
-            std::string_view currentClassName;      ///< Name of the class currently being analyzed.
-            std::string_view currentSubroutineName; ///< Name of the subroutine currently being analyzed.
+            SymbolId currentClassName = NO_SYMBOL;      ///< Name of the class currently being analyzed.
+            SymbolId currentSubroutineName = NO_SYMBOL; ///< Name of the subroutine currently being analyzed.
             std::string_view currentSubroutineKind; ///< Kind of the current subroutine ("function", "method", "constructor").
 
             /**
-             * @brief Reports a semantic error and throws an exception.
+             * @brief Registry lookups, recorded in 'dependencies' when it is set.
+             */
+            bool classExists(SymbolId className) const;
+            bool methodExists(SymbolId className, SymbolId methodName) const;
+            const MethodSignature& getSignature(SymbolId className, SymbolId methodName) const;
+            void recordLookup(SymbolId className, SymbolId methodName) const;
+
+            /**
+             * @brief Reports a semantic error and throws a CompilationError.
              *
              * @param message The error message.
              * @param node The AST node where the error occurred (for location info).
              */
             [[noreturn]] void error(std::string_view message, const Node& node) const;
 
+            /**
+             * @brief Reports an error after which the declaration can still be used as written
+             *        (an unknown type): collected if there is a sink, else thrown like error().
+             */
+            void reportError(std::string_view message, const Node& node) const;
+
+            /**
+             * @brief Collects an error caught at a recovery point, or rethrows it without a sink.
+             */
+            void recover(const CompilationError& e) const;
+
             /**
              * @brief Checks if two types match according to Jack's type rules.
              *
@@ -61,7 +88,14 @@ namespace nand2tetris::jack{
              * @param actual The actual type found.
              * @param locationNode The AST node for error reporting.
              */
-            void checkTypeMatch(std::string_view expected, std::string_view actual,const Node& locationNode) const;
+            void checkTypeMatch(SymbolId expected, SymbolId actual,const Node& locationNode) const;
+
+            /**
+             * @brief The rules of checkTypeMatch(), without reporting.
+             *
+             * @return True if a value of type 'actual' may be used where 'expected' is required.
+             */
+            static bool isAssignable(SymbolId expected, SymbolId actual);
 
 
             /**
@@ -77,10 +111,10 @@ namespace nand2tetris::jack{
             /**
              * @brief Analyzes a list of statements.
              *
-             * @param stmts The vector of statement nodes.
+             * @param stmts The list of statement nodes.
              * @param table The current symbol table.
              */
-            void analyseStatements(const std::vector<std::unique_ptr<StatementNode>>& stmts, SymbolTable& table) const;
+            void analyseStatements(const ArenaList<StatementNode*>& stmts, SymbolTable& table) const;
 
             /**
              * @brief Analyzes a 'let' statement.
@@ -140,23 +174,23 @@ namespace nand2tetris::jack{
              * @param table The current symbol table.
              * @return The type of the expression (e.g., "int", "boolean", "MyClass").
              */
-            std::string_view analyseExpression(const ExpressionNode& node, SymbolTable& table)const;
+            SymbolId analyseExpression(const ExpressionNode& node, SymbolTable& table)const;
 
             /**
              * @brief Analyzes a subroutine call.
              *
              * Resolves the target class/object, checks method existence, verifies argument count and types.
              *
-             * @param classNameOrVar The class name or variable name (or empty for implicit 'this').
+             * @param classNameOrVar The class name or variable name (or NO_SYMBOL for implicit 'this').
              * @param functionName The name of the function/method.
              * @param args The list of argument expressions.
              * @param table The current symbol table.
              * @param locationNode The AST node for error reporting.
              * @return The return type of the called subroutine.
              */
-            std::string_view analyseSubroutineCall(std::string_view classNameOrVar,
-                                               std::string_view functionName,
-                                               const std::vector<std::unique_ptr<ExpressionNode>>& args,
+            SymbolId analyseSubroutineCall(SymbolId classNameOrVar,
+                                               SymbolId functionName,
+                                               const ArenaList<ExpressionNode*>& args,
                                                SymbolTable& table,
                                                const Node& locationNode)const;
     };
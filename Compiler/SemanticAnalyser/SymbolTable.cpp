@@ -3,9 +3,11 @@
 //
 
 #include "SymbolTable.h"
+#include "../Diagnostics/Diagnostics.h"
+#include "../Stats/Stats.h"
 #include <stdexcept>
 #include <string>
-#include <fstream>
+#include <ostream>
 
 namespace nand2tetris::jack {
 
@@ -20,89 +22,84 @@ namespace nand2tetris::jack {
         }
     }
 
-    SymbolTable::SymbolTable() {
-        // Initialize all running indices to 0.
-        indices[SymbolKind::STATIC] = 0;
-        indices[SymbolKind::FIELD] = 0;
-        indices[SymbolKind::ARG] = 0;
-        indices[SymbolKind::LCL] = 0;
+    namespace {
+        std::size_t slot(const SymbolKind kind) {
+            return static_cast<std::size_t>(kind);
+        }
     }
 
-    void SymbolTable::startSubroutine(const std::string_view name) {
-        // If there was a previous subroutine, save its state to history.
-        if (!currentSubroutineName.empty()) {
-            SubroutineSnapshot snap;
-            snap.name = currentSubroutineName;
-            snap.symbols = subRoutineScope;
-            snap.indices = indices;
-            history.push_back(snap);
-        }
+    SymbolTable::SymbolTable() {
+        // All running indices start at 0 (see 'indices').
+    }
 
-        // Clear the subroutine-level scope for the new subroutine.
-        subRoutineScope.clear();
+    int SymbolTable::startSubroutine(const SymbolId name) {
+        // Open a new, empty slice at the end of the shared storage. Earlier subroutines keep theirs.
+        SubroutineScope scope;
+        scope.name = name;
+        scope.first = static_cast<std::uint32_t>(subroutineSymbols.size());
+        subroutines.push_back(scope);
 
         // Reset indices for subroutine-level variables.
-        indices[SymbolKind::ARG] = 0;
-        indices[SymbolKind::LCL] = 0;
+        indices[slot(SymbolKind::ARG)] = 0;
+        indices[slot(SymbolKind::LCL)] = 0;
 
-        currentSubroutineName = name;
+        current = static_cast<int>(subroutines.size()) - 1;
+        return current;
     }
 
-    void SymbolTable::startSubroutineFromHistory(const std::string_view name) {
-        subRoutineScope.clear();
-        bool found = false;
-
-        // Find the snapshot by name in the history.
-        for (const auto& snap : history) {
-            if (snap.name == name) {
-                // Restore the symbol table and indices from the snapshot.
-                subRoutineScope = snap.symbols;
-                indices = snap.indices;
-                currentSubroutineName = name;
-                found = true;
-                break;
-            }
+    void SymbolTable::enterSubroutine(const int id) {
+        if (id < 0 || id >= static_cast<int>(subroutines.size())) {
+            throw std::runtime_error("Internal Compiler Error: No symbol scope for subroutine #" + std::to_string(id));
         }
+        // Restore the running indices the subroutine ended with.
+        const SubroutineScope& scope = subroutines[id];
+        indices[slot(SymbolKind::ARG)] = scope.argCount;
+        indices[slot(SymbolKind::LCL)] = scope.localCount;
+        current = id;
+    }
 
-        // If not found (shouldn't happen in valid flow), reset as a new subroutine.
-        if (!found) {
-            indices[SymbolKind::ARG] = 0;
-            indices[SymbolKind::LCL] = 0;
-            currentSubroutineName = name;
+    const ScopedSymbol* SymbolTable::find(const ScopedSymbol* first, const ScopedSymbol* last, const SymbolId name) {
+        for (; first != last; ++first) {
+            if (first->name == name) return first;
         }
+        return nullptr;
     }
 
-    const Symbol *SymbolTable::lookup(const std::string_view name) const {
+    const Symbol *SymbolTable::lookup(const SymbolId name) const {
+        JACK_STAT(symbolLookups);
         // 1. Check the subroutine scope (local variables and arguments) first.
         // This allows local variables to shadow class variables.
-        const auto subIt = subRoutineScope.find(name);
-        if (subIt != subRoutineScope.end()) {
-            return &(subIt->second);
+        if (current >= 0) {
+            const SubroutineScope& scope = subroutines[current];
+            const ScopedSymbol* first = subroutineSymbols.data() + scope.first;
+            if (const ScopedSymbol* s = find(first, first + scope.count, name)) {
+                return &s->symbol;
+            }
         }
 
         // 2. If not found, check the class scope (static and field variables).
-        const auto classIt = classScope.find(name);
-        if (classIt != classScope.end()) {
-            return &(classIt->second);
+        if (const ScopedSymbol* s = find(classScope.data(), classScope.data() + classScope.size(), name)) {
+            return &s->symbol;
         }
 
         // 3. Not found in either scope.
+        JACK_STAT(symbolMisses);
         return nullptr;
     }
 
-    SymbolKind SymbolTable::kindOf(const std::string_view name) const {
+    SymbolKind SymbolTable::kindOf(const SymbolId name) const {
         const Symbol* s=lookup(name);
         // Return the kind of variable if found, otherwise return NONE.
         return (s) ? s->kind:SymbolKind::NONE;
     }
 
-    std::string_view SymbolTable::typeOf(const std::string_view name) const {
+    SymbolId SymbolTable::typeOf(const SymbolId name) const {
         const Symbol* s=lookup(name);
-        // Return the type if found, otherwise return empty string.
-        return (s) ? s->type:"";
+        // Return the type if found, otherwise return NO_SYMBOL.
+        return (s) ? s->type:NO_SYMBOL;
     }
 
-    int SymbolTable::indexOf(const std::string_view name) const {
+    int SymbolTable::indexOf(const SymbolId name) const {
         const Symbol* s=lookup(name);
         // Return the index if found, otherwise return -1.
         return (s) ? s->index:-1;
@@ -110,16 +107,11 @@ namespace nand2tetris::jack {
 
     int SymbolTable::varCount(const SymbolKind kind) const {
         // Return the current count (next index) for the given kind.
-        const auto it=indices.find(kind);
-        if (it != indices.end()) {
-            return it->second;
-        }
-
-        return 0;
+        return kind == SymbolKind::NONE ? 0 : indices[slot(kind)];
     }
 
 
-    void SymbolTable::define(const std::string_view name, const std::string_view type, const SymbolKind kind, const int line, const int col) {
+    void SymbolTable::define(const SymbolId name, const SymbolId type, const SymbolKind kind, const int line, const int col) {
         // Check if the variable is already defined in the *current* scope to prevent redefinition.
         // Note: lookup() checks both scopes, but for redefinition checks, we strictly care about
         // the scope we are about to insert into. However, checking lookup() is a safe conservative check
@@ -160,67 +152,53 @@ namespace nand2tetris::jack {
 
         if (collision) {
             const std::string msg =
-                "Semantic Error [" + std::to_string(line) + ":" + std::to_string(col) + "]: " +
-                "Variable '" + std::string(name) + "' is already defined as a " +
+                "Variable '" + std::string(nameOf(name)) + "' is already defined as a " +
                 kindToString(existing->kind) + " at [" +
                 std::to_string(existing->declLine) + ":" + std::to_string(existing->declCol) + "].";
-            throw std::runtime_error(msg);
+            throw CompilationError({"", line, col, DiagnosticPhase::SEMANTIC, msg},
+                                   "Semantic Error [" + std::to_string(line) + ":" + std::to_string(col) + "]: " + msg);
+        }
+
+        if (kind == SymbolKind::NONE) {
+            throw std::runtime_error("Internal Compiler Error: Cannot define '" + std::string(nameOf(name)) + "' with no kind.");
         }
 
         // Create the new symbol, assigning it the current index for its kind.
-        const Symbol symbol = {type, kind,indices[kind]++,line,col};
+        const Symbol symbol = {type, kind,indices[slot(kind)]++,line,col};
 
-        // Insert into the appropriate scope map.
+        // Insert into the appropriate scope.
         if (kind == SymbolKind::STATIC || kind == SymbolKind::FIELD) {
-            classScope[name] = symbol;
-        } else {
-            subRoutineScope[name] = symbol;
+            classScope.push_back({name, symbol});
+            return;
         }
-    }
 
-    void SymbolTable::dumpToJSON(std::string_view className, const std::string& path) const {
-        // Create a temporary full history that includes the current active subroutine
-        std::vector<SubroutineSnapshot> fullHistory = history;
-        if (!currentSubroutineName.empty()) {
-            SubroutineSnapshot snap;
-            snap.name = currentSubroutineName;
-            snap.symbols = subRoutineScope;
-            fullHistory.push_back(snap);
+        // Subroutine symbols are only ever added to the newest subroutine, whose slice ends the storage.
+        if (current < 0 || current != static_cast<int>(subroutines.size()) - 1) {
+            throw std::runtime_error("Internal Compiler Error: '" + std::string(nameOf(name)) + "' defined outside the open subroutine.");
         }
+        SubroutineScope& scope = subroutines[current];
+        subroutineSymbols.push_back({name, symbol});
+        ++scope.count;
+        scope.argCount = indices[slot(SymbolKind::ARG)];
+        scope.localCount = indices[slot(SymbolKind::LCL)];
+    }
 
-        std::ofstream json(path);
-        if (!json.is_open()) return;
-
-        json << "{\n  \"className\": \"" << className << "\",\n";
-        json << "  \"classSymbols\": [\n";
-
-        bool first = true;
-        for (const auto& pair : classScope) {
-            if (!first) json << ",\n";
-            json << "    {\"name\": \"" << pair.first << "\", \"type\": \"" << pair.second.type
-                 << "\", \"kind\": \"" << kindToString(pair.second.kind)
-                 << "\", \"index\": " << pair.second.index << "}";
-            first = false;
-        }
-        json << "\n  ],\n";
-
-        json << "  \"subroutines\": [\n";
-        bool firstSub = true;
-        for (const auto& snap : fullHistory) {
-            if (!firstSub) json << ",\n";
-            json << "    {\n      \"name\": \"" << snap.name << "\",\n      \"symbols\": [\n";
-            bool firstSym = true;
-            for (const auto& pair : snap.symbols) {
-                if (!firstSym) json << ",\n";
-                json << "        {\"name\": \"" << pair.first << "\", \"type\": \"" << pair.second.type
-                     << "\", \"kind\": \"" << kindToString(pair.second.kind)
-                     << "\", \"index\": " << pair.second.index << "}";
-                firstSym = false;
+    void SymbolTable::dumpToNdjson(std::string_view className, std::ostream& out) const {
+        // Identifiers and type names never need escaping.
+        const auto writeSymbol = [&out](const std::string_view scope, const SymbolId name, const Symbol& symbol) {
+            out << "{\"scope\":\"" << scope << "\",\"name\":\"" << nameOf(name) << "\",\"type\":\""
+                << nameOf(symbol.type) << "\",\"kind\":\"" << kindToString(symbol.kind) << "\",\"index\":"
+                << symbol.index << "}\n";
+        };
+
+        out << "{\"className\":\"" << className << "\"}\n";
+        for (const auto& [name, symbol] : classScope) writeSymbol("class", name, symbol);
+        for (const SubroutineScope& scope : subroutines) {
+            out << "{\"subroutine\":\"" << nameOf(scope.name) << "\"}\n";
+            for (std::uint32_t i = 0; i < scope.count; ++i) {
+                const auto& [name, symbol] = subroutineSymbols[scope.first + i];
+                writeSymbol(nameOf(scope.name), name, symbol);
             }
-            json << "\n      ]\n    }";
-            firstSub = false;
         }
-        json << "\n  ]\n}\n";
-        json.close();
     }
 }
@@ -5,7 +5,10 @@
 #ifndef NAND2TETRIS_SYMBOL_TABLE_H
 #define NAND2TETRIS_SYMBOL_TABLE_H
 #include "../Parser/Parser.h"
-#include <unordered_map>
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <vector>
 
 namespace nand2tetris::jack{
 
@@ -24,7 +27,7 @@ namespace nand2tetris::jack{
      * @brief Structure representing a symbol in the symbol table.
      */
     struct Symbol{
-        std::string_view type; ///< The data type of the symbol (e.g., "int", "boolean", "MyClass").
+        SymbolId type;         ///< The data type of the symbol (e.g., "int", "boolean", "MyClass").
         SymbolKind kind;       ///< The kind of the symbol (STATIC, FIELD, ARG, LCL).
         int index;             ///< The running index of the symbol within its kind.
         int declLine;          ///< The line number where the symbol was declared.
@@ -32,14 +35,22 @@ namespace nand2tetris::jack{
     };
 
     /**
-     * @brief Structure representing a snapshot of a subroutine's symbol table state.
-     *
-     * Used for restoring the symbol table state during code generation or debugging.
+     * @brief A named entry in one of the symbol table's flat scopes.
+     */
+    struct ScopedSymbol {
+        SymbolId name;         ///< The identifier.
+        Symbol symbol;         ///< What it refers to.
+    };
+
+    /**
+     * @brief The symbols of one analysed subroutine: a slice of the table's shared subroutine storage.
      */
-    struct SubroutineSnapshot {
-        std::string_view name; ///< The name of the subroutine.
-        std::unordered_map<std::string_view, Symbol> symbols; ///< The symbols defined in this subroutine.
-        std::unordered_map<SymbolKind, int> indices; ///< The running indices at the end of this subroutine.
+    struct SubroutineScope {
+        SymbolId name;            ///< The name of the subroutine.
+        std::uint32_t first = 0;  ///< Offset of its first symbol in the shared storage.
+        std::uint32_t count = 0;  ///< Number of symbols (arguments + locals).
+        int argCount = 0;         ///< The running ARG index at the end of this subroutine.
+        int localCount = 0;       ///< The running LCL index at the end of this subroutine.
     };
 
     /**
@@ -47,6 +58,10 @@ namespace nand2tetris::jack{
      *
      * Manages the scope and properties of variables (identifiers) during compilation.
      * It handles two scopes: class-level (static, field) and subroutine-level (argument, local).
+     *
+     * Jack scopes are small, so each is a contiguous array searched linearly by SymbolId. Every subroutine's
+     * symbols are kept (in one shared array), so code generation re-enters a scope by id in O(1)
+     * instead of copying a map back.
      */
     class SymbolTable {
         public:
@@ -63,21 +78,23 @@ namespace nand2tetris::jack{
             /**
              * @brief Starts a new subroutine scope.
              *
-             * Clears the subroutine-level symbol table and resets the indices for ARG and LCL.
-             * Should be called when starting to compile a new subroutine.
+             * Opens an empty subroutine-level scope and resets the indices for ARG and LCL.
+             * Should be called when starting to analyse a new subroutine.
              *
              * @param name The name of the subroutine being started.
+             * @return The subroutine's id: 0 for the first subroutine of the class, 1 for the next, and so on.
              */
-            void startSubroutine(std::string_view name);
+            int startSubroutine(SymbolId name);
 
             /**
-             * @brief Restores a subroutine scope from history.
+             * @brief Re-enters the scope of a previously analysed subroutine.
              *
-             * Used during code generation to restore the symbol table state of a previously analyzed subroutine.
+             * Used during code generation, which visits subroutines in the same order as the analyser.
              *
-             * @param name The name of the subroutine to restore.
+             * @param id The id returned by startSubroutine().
+             * @throws std::runtime_error If no subroutine has that id.
              */
-            void startSubroutineFromHistory(std::string_view name);
+            void enterSubroutine(int id);
 
             /**
              * @brief Returns the number of variables of the given kind defined in the current scope.
@@ -95,15 +112,15 @@ namespace nand2tetris::jack{
              * @param name The name of the identifier.
              * @return The SymbolKind of the identifier, or SymbolKind::NONE if not found.
              */
-            SymbolKind kindOf(std::string_view name) const;
+            SymbolKind kindOf(SymbolId name) const;
 
             /**
              * @brief Returns the type of the named identifier.
              *
              * @param name The name of the identifier.
-             * @return The type of the identifier (e.g., "int"), or an empty string if not found.
+             * @return The type of the identifier (e.g., "int"), or NO_SYMBOL if not found.
              */
-            std::string_view typeOf(std::string_view name) const;
+            SymbolId typeOf(SymbolId name) const;
 
             /**
              * @brief Returns the index of the named identifier.
@@ -111,7 +128,7 @@ namespace nand2tetris::jack{
              * @param name The name of the identifier.
              * @return The index of the identifier, or -1 if not found.
              */
-            int indexOf(std::string_view name) const;
+            int indexOf(SymbolId name) const;
 
             /**
              * @brief Defines a new variable in the symbol table.
@@ -126,17 +143,19 @@ namespace nand2tetris::jack{
              * @param col The column number of the declaration (for error reporting).
              * @throws std::runtime_error if the variable is already defined in the current scope.
              */
-            void define(std::string_view name, std::string_view type, SymbolKind kind,int line, int col);
+            void define(SymbolId name, SymbolId type, SymbolKind kind,int line, int col);
 
             /**
-             * @brief Dumps the symbol table content to a JSON file.
+             * @brief Dumps the symbol table as newline-delimited JSON, one object per line.
              *
-             * Useful for debugging and visualization.
+             * A {"className"} line, then one line per symbol ("scope" is "class" or the subroutine's
+             * name), with a {"subroutine"} line opening each subroutine's symbols. Read by
+             * tools/symbol_table_viz.py.
              *
              * @param className The name of the class being dumped.
-             * @param path The file path to write the JSON to.
+             * @param out Where to write it.
              */
-            void dumpToJSON(std::string_view className, const std::string& path) const;
+            void dumpToNdjson(std::string_view className, std::ostream& out) const;
 
         private:
             /**
@@ -147,14 +166,18 @@ namespace nand2tetris::jack{
              * @param name The name to look up.
              * @return A pointer to the Symbol if found, nullptr otherwise.
              */
-            const Symbol* lookup(std::string_view name) const;
+            const Symbol* lookup(SymbolId name) const;
 
-            std::unordered_map<std::string_view,Symbol> classScope;      ///< Stores class-level symbols (STATIC, FIELD).
-            std::unordered_map<std::string_view,Symbol> subRoutineScope; ///< Stores subroutine-level symbols (ARG, LCL).
-            std::unordered_map<SymbolKind, int> indices;                 ///< Tracks the next available index for each SymbolKind.
+            /**
+             * @brief The entry named 'name' in [first, last), or nullptr.
+             */
+            static const ScopedSymbol* find(const ScopedSymbol* first, const ScopedSymbol* last, SymbolId name);
 
-            std::vector<SubroutineSnapshot> history; ///< Stores snapshots of previous subroutines.
-            std::string_view currentSubroutineName;  ///< Name of the currently active subroutine.
+            std::vector<ScopedSymbol> classScope;         ///< Stores class-level symbols (STATIC, FIELD).
+            std::vector<ScopedSymbol> subroutineSymbols;  ///< Every subroutine's ARG/LCL symbols, one slice per subroutine.
+            std::vector<SubroutineScope> subroutines;     ///< Indexed by subroutine id.
+            std::array<int, 4> indices{};                 ///< Next available index, indexed by SymbolKind (NONE excluded).
+            int current = -1;                             ///< Id of the active subroutine, or -1 at class level.
 
     };
 };
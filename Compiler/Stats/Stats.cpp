@@ -0,0 +1,117 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "Stats.h"
+#include "../Tokenizer/TokenTypes.h"
+#include "../Parser/AST.h"
+#include "../VMWriter/VMInstruction.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+
+namespace nand2tetris::jack {
+
+    static_assert(StatsCounters::TOKEN_TYPES == static_cast<std::size_t>(TokenType::END_OF_FILE) + 1);
+    static_assert(StatsCounters::AST_NODE_TYPES == static_cast<std::size_t>(ASTNodeType::IDENTIFIER) + 1);
+    static_assert(StatsCounters::VM_OPS == static_cast<std::size_t>(VMOp::RETURN) + 1);
+
+    namespace {
+        // In enum order.
+        constexpr const char* TOKEN_NAMES[] = {"keyword", "symbol", "identifier", "integer", "string", "end of file"};
+        constexpr const char* AST_NODE_NAMES[] = {
+            "class", "classVarDec", "subroutineDec", "varDec",
+            "let", "if", "while", "do", "return",
+            "integer", "string", "keyword", "binaryOp", "unaryOp", "call", "identifier"};
+        constexpr const char* VM_OP_NAMES[] = {"push", "pop", "arithmetic", "label", "goto", "if-goto", "call", "function", "return"};
+
+        // Function-local, so a thread may count during static initialisation (the OS image).
+        std::mutex& blocksMutex() {
+            static std::mutex mtx;
+            return mtx;
+        }
+
+        std::deque<StatsCounters>& blocks() {
+            static std::deque<StatsCounters> all; // A deque keeps every thread's block in place.
+            return all;
+        }
+
+        template <std::size_t N>
+        std::uint64_t sum(const std::array<std::uint64_t, N>& counts) {
+            std::uint64_t total = 0;
+            for (const std::uint64_t n : counts) total += n;
+            return total;
+        }
+
+        /// "N (name a, name b, ...)", most frequent first, leaving out the ones that never occurred.
+        template <std::size_t N>
+        void writeBreakdown(std::ostream& out, const std::array<std::uint64_t, N>& counts, const char* const (&names)[N]) {
+            std::array<std::size_t, N> order{};
+            for (std::size_t i = 0; i < N; ++i) order[i] = i;
+            std::stable_sort(order.begin(), order.end(), [&counts](const std::size_t a, const std::size_t b) {
+                return counts[a] > counts[b];
+            });
+            out << sum(counts);
+            const char* separator = " (";
+            for (const std::size_t i : order) {
+                if (counts[i] == 0) break;
+                out << separator << names[i] << " " << counts[i];
+                separator = ", ";
+            }
+            if (separator[0] == ',') out << ")";
+            out << "\n";
+        }
+    }
+
+    StatsCounters &StatsCounters::operator+=(const StatsCounters &other) {
+        for (std::size_t i = 0; i < TOKEN_TYPES; ++i) tokens[i] += other.tokens[i];
+        for (std::size_t i = 0; i < AST_NODE_TYPES; ++i) astNodes[i] += other.astNodes[i];
+        registryLocks += other.registryLocks;
+        registryContended += other.registryContended;
+        registryWaitNs += other.registryWaitNs;
+        symbolLookups += other.symbolLookups;
+        symbolMisses += other.symbolMisses;
+        for (std::size_t i = 0; i < VM_OPS; ++i) vmCommands[i] += other.vmCommands[i];
+        return *this;
+    }
+
+    StatsCounters &Stats::registerThread() {
+        std::scoped_lock lock(blocksMutex());
+        return blocks().emplace_back();
+    }
+
+    void Stats::lockCounted(std::mutex &mtx) {
+        StatsCounters& counters = local();
+        ++counters.registryLocks;
+        if (mtx.try_lock()) return;
+
+        // Only a contended lock pays for the clock.
+        const auto start = std::chrono::steady_clock::now();
+        mtx.lock();
+        ++counters.registryContended;
+        counters.registryWaitNs += static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    StatsCounters Stats::total() {
+        StatsCounters sumOfAll;
+        std::scoped_lock lock(blocksMutex());
+        for (const StatsCounters& counters : blocks()) sumOfAll += counters;
+        return sumOfAll;
+    }
+
+    void Stats::write(std::ostream &out) {
+        const StatsCounters t = total();
+        out << " Counters (--stats):\n";
+        out << "   Tokens:         ";
+        writeBreakdown(out, t.tokens, TOKEN_NAMES);
+        out << "   AST Nodes:      ";
+        writeBreakdown(out, t.astNodes, AST_NODE_NAMES);
+        out << "   Registry Locks: " << t.registryLocks << " (" << t.registryContended << " contended, "
+            << static_cast<double>(t.registryWaitNs) / 1e6 << " ms waiting)\n";
+        out << "   Symbol Lookups: " << t.symbolLookups << " (" << t.symbolMisses << " misses)\n";
+        out << "   VM Commands:    ";
+        writeBreakdown(out, t.vmCommands, VM_OP_NAMES);
+        out.flush();
+    }
+}
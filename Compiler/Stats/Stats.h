@@ -0,0 +1,117 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_STATS_H
+#define NAND2TETRIS_STATS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Hot-path event counts of one thread (or, from Stats::total(), of the whole build).
+     *
+     * Indexed by the enums' underlying values; Stats.cpp checks the sizes against the enums.
+     */
+    struct StatsCounters {
+        static constexpr std::size_t TOKEN_TYPES = 6;     ///< TokenType
+        static constexpr std::size_t AST_NODE_TYPES = 16; ///< ASTNodeType
+        static constexpr std::size_t VM_OPS = 9;          ///< VMOp
+
+        std::array<std::uint64_t, TOKEN_TYPES> tokens{};       ///< Tokenizer: tokens scanned, by type.
+        std::array<std::uint64_t, AST_NODE_TYPES> astNodes{};  ///< Parser: nodes built, by type.
+        std::uint64_t registryLocks = 0;     ///< GlobalRegistry: shard locks taken.
+        std::uint64_t registryContended = 0; ///< ...of which found the shard held by another thread.
+        std::uint64_t registryWaitNs = 0;    ///< ...and the time spent waiting for it.
+        std::uint64_t symbolLookups = 0;     ///< SymbolTable::lookup calls.
+        std::uint64_t symbolMisses = 0;      ///< ...that found nothing in either scope.
+        std::array<std::uint64_t, VM_OPS> vmCommands{};        ///< VMWriter: commands delivered (after the peephole pass), by opcode.
+
+        StatsCounters& operator+=(const StatsCounters& other);
+    };
+
+    /**
+     * @brief The counters behind --stats.
+     *
+     * Compiled in only with the CMake option JACK_ENABLE_STATS; otherwise every JACK_STAT
+     * hook is an empty statement and the compiler is exactly as fast as without them. Each
+     * thread increments its own block (plain integers, no atomics or shared cache lines), so
+     * the counting does not change the contention it measures.
+     */
+    class Stats {
+        public:
+#ifdef JACK_ENABLE_STATS
+            static constexpr bool ENABLED = true;
+#else
+            static constexpr bool ENABLED = false;
+#endif
+
+            /**
+             * @brief The calling thread's counters, created on first use. They outlive the thread.
+             */
+            static StatsCounters& local() {
+                thread_local StatsCounters* counters = nullptr;
+                if (!counters) counters = &registerThread();
+                return *counters;
+            }
+
+            /**
+             * @brief Locks 'mtx', counting the acquisition and any time spent waiting for it.
+             */
+            static void lockCounted(std::mutex& mtx);
+
+            /**
+             * @brief The sum over every thread that has counted anything.
+             *
+             * Call only once the counting threads are idle (e.g. after the build's tasks finished).
+             */
+            static StatsCounters total();
+
+            /**
+             * @brief Writes total() as the --stats section of the build report.
+             */
+            static void write(std::ostream& out);
+
+        private:
+            static StatsCounters& registerThread();
+    };
+
+    /**
+     * @brief A std::scoped_lock on one mutex that, with JACK_ENABLE_STATS, also counts it
+     *        (see StatsCounters::registryLocks).
+     */
+    class CountedLock {
+        public:
+            explicit CountedLock(std::mutex& mtx) : mtx(mtx) {
+#ifdef JACK_ENABLE_STATS
+                Stats::lockCounted(mtx);
+#else
+                mtx.lock();
+#endif
+            }
+            ~CountedLock() { mtx.unlock(); }
+
+            CountedLock(const CountedLock&) = delete;
+            CountedLock& operator=(const CountedLock&) = delete;
+
+        private:
+            std::mutex& mtx;
+    };
+}
+
+#ifdef JACK_ENABLE_STATS
+    /// Counts one event: JACK_STAT(symbolLookups).
+    #define JACK_STAT(field) (++::nand2tetris::jack::Stats::local().field)
+    /// Counts one event of an enum-indexed counter: JACK_STAT_AT(tokens, TokenType::SYMBOL).
+    #define JACK_STAT_AT(field, index) (++::nand2tetris::jack::Stats::local().field[static_cast<std::size_t>(index)])
+#else
+    #define JACK_STAT(field) ((void)0)
+    #define JACK_STAT_AT(field, index) ((void)0)
+#endif
+
+#endif //NAND2TETRIS_STATS_H
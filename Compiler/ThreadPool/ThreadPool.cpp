@@ -0,0 +1,138 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "ThreadPool.h"
+#include <chrono>
+
+namespace nand2tetris::jack {
+
+    namespace {
+        // Identifies the pool and worker the current thread belongs to (nullptr/0 for outside threads).
+        thread_local const void* currentPool = nullptr;
+        thread_local std::size_t currentWorker = 0;
+    }
+
+    std::size_t ThreadPool::defaultThreadCount() {
+        // hardware_concurrency() is allowed to return 0 when it cannot tell.
+        const unsigned int hw = std::thread::hardware_concurrency();
+        return hw == 0 ? 1 : hw;
+    }
+
+    ThreadPool::ThreadPool(std::size_t threadCount) {
+        if (threadCount == 0) {
+            threadCount = defaultThreadCount();
+        }
+
+        workers.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+
+        // Start the threads only after every queue exists, since workers steal from each other.
+        threads.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            threads.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::scoped_lock lock(sleepMtx);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+
+        for (auto& t : threads) {
+            if (t.joinable()) t.join();
+        }
+    }
+
+    void ThreadPool::enqueue(std::function<void()> task) {
+        // Workers keep their own children local; everyone else spreads the load round-robin.
+        const std::size_t target = (currentPool == this)
+            ? currentWorker
+            : nextQueue.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+        {
+            std::scoped_lock lock(workers[target]->mtx);
+            workers[target]->queue.push_back(std::move(task));
+        }
+        {
+            std::scoped_lock lock(sleepMtx);
+            ++pending;
+        }
+        wakeUp.notify_one();
+    }
+
+    bool ThreadPool::takeTask(const std::size_t self, std::function<void()>& out, bool& stolen) {
+        // 1. Own queue, newest first.
+        {
+            Worker& own = *workers[self];
+            std::scoped_lock lock(own.mtx);
+            if (!own.queue.empty()) {
+                out = std::move(own.queue.back());
+                own.queue.pop_back();
+                stolen = false;
+                return true;
+            }
+        }
+
+        // 2. Steal the oldest task from a sibling, starting with our right-hand neighbour
+        // so that thieves do not all hammer worker 0.
+        for (std::size_t offset = 1; offset < workers.size(); ++offset) {
+            Worker& victim = *workers[(self + offset) % workers.size()];
+            std::scoped_lock lock(victim.mtx);
+            if (!victim.queue.empty()) {
+                out = std::move(victim.queue.front());
+                victim.queue.pop_front();
+                stolen = true;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::workerLoop(const std::size_t self) {
+        currentPool = this;
+        currentWorker = self;
+
+        while (true) {
+            {
+                std::unique_lock lock(sleepMtx);
+                wakeUp.wait(lock, [this] { return stopping || pending > 0; });
+                if (stopping) return;
+                // Claim one queued task. Tasks are pushed before pending is bumped,
+                // so a claimed ticket always has a task waiting in some queue.
+                --pending;
+            }
+
+            std::function<void()> task;
+            bool stolen = false;
+            while (!takeTask(self, task, stolen)) {
+                // The scan raced with another worker; the task is still there, look again.
+                std::this_thread::yield();
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            task(); // packaged_task stores any exception in its future, so this cannot throw.
+            const auto end = std::chrono::steady_clock::now();
+
+            Worker& own = *workers[self];
+            std::scoped_lock lock(own.mtx);
+            own.stats.tasksRun++;
+            if (stolen) own.stats.tasksStolen++;
+            own.stats.busyMs += std::chrono::duration<double, std::milli>(end - start).count();
+        }
+    }
+
+    std::vector<WorkerStats> ThreadPool::getStats() const {
+        std::vector<WorkerStats> result;
+        result.reserve(workers.size());
+        for (const auto& w : workers) {
+            std::scoped_lock lock(w->mtx);
+            result.push_back(w->stats);
+        }
+        return result;
+    }
+}
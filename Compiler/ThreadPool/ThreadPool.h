@@ -0,0 +1,127 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_THREAD_POOL_H
+#define NAND2TETRIS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Per-worker bookkeeping reported at the end of a build.
+     */
+    struct WorkerStats {
+        std::size_t tasksRun = 0;    ///< Number of tasks this worker executed.
+        std::size_t tasksStolen = 0; ///< How many of those were stolen from another worker's queue.
+        double busyMs = 0.0;         ///< Total wall-clock time spent inside tasks.
+    };
+
+    /**
+     * @brief A fixed-size work-stealing thread pool.
+     *
+     * Every worker owns a double-ended queue. Workers pop their own work from the back (LIFO, cache-warm)
+     * and steal from the front of other workers' queues (FIFO, oldest first) when they run dry.
+     * Tasks submitted from outside the pool are distributed round-robin across the worker queues;
+     * tasks submitted from inside a worker go to that worker's own queue.
+     */
+    class ThreadPool {
+        public:
+            /**
+             * @brief Starts the worker threads.
+             *
+             * @param threadCount Number of workers. 0 selects defaultThreadCount().
+             */
+            explicit ThreadPool(std::size_t threadCount = 0);
+
+            /**
+             * @brief Stops the pool. Tasks that are already running finish; queued tasks are discarded.
+             */
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            /**
+             * @brief Schedules a callable on the pool.
+             *
+             * Exceptions thrown by the callable are captured and rethrown from future::get().
+             *
+             * @param f The callable to run. Must be invocable with no arguments.
+             * @return A future holding the callable's result.
+             */
+            template <typename F>
+            auto submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+                using R = std::invoke_result_t<std::decay_t<F>>;
+                // packaged_task is move-only, std::function needs copyable targets.
+                auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+                std::future<R> result = task->get_future();
+                enqueue([task] { (*task)(); });
+                return result;
+            }
+
+            /**
+             * @brief Returns the number of worker threads.
+             */
+            std::size_t size() const { return workers.size(); }
+
+            /**
+             * @brief Returns a snapshot of each worker's statistics, indexed by worker id.
+             */
+            std::vector<WorkerStats> getStats() const;
+
+            /**
+             * @brief The pool size used when none is requested: one worker per hardware thread.
+             */
+            static std::size_t defaultThreadCount();
+
+        private:
+            struct Worker {
+                std::deque<std::function<void()>> queue; ///< Local work queue (owner: back, thieves: front).
+                mutable std::mutex mtx;                  ///< Guards queue and stats.
+                WorkerStats stats;
+            };
+
+            std::vector<std::unique_ptr<Worker>> workers;
+            std::vector<std::thread> threads;
+
+            std::mutex sleepMtx;             ///< Guards the sleep/wake handshake.
+            std::condition_variable wakeUp;  ///< Signalled whenever work is queued or the pool stops.
+            std::size_t pending = 0;         ///< Tasks queued but not yet picked up (guarded by sleepMtx).
+            bool stopping = false;           ///< Set once by the destructor (guarded by sleepMtx).
+            std::atomic<std::size_t> nextQueue{0}; ///< Round-robin cursor for external submissions.
+
+            /**
+             * @brief Pushes a type-erased task onto a worker queue and wakes a sleeper.
+             */
+            void enqueue(std::function<void()> task);
+
+            /**
+             * @brief Takes a task from the worker's own queue, or steals one from a sibling.
+             *
+             * @param self Index of the calling worker.
+             * @param out Receives the task.
+             * @param stolen Set to true if the task came from another worker's queue.
+             * @return true if a task was found.
+             */
+            bool takeTask(std::size_t self, std::function<void()>& out, bool& stolen);
+
+            /**
+             * @brief Main loop executed by each worker thread.
+             */
+            void workerLoop(std::size_t self);
+    };
+}
+
+#endif //NAND2TETRIS_THREAD_POOL_H
@@ -0,0 +1,222 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "SimdScan.h"
+#include "TokenTypes.h"
+#include <cstdint>
+
+#if defined(JACK_ENABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define JACK_SCAN_SSE2 1
+	#include <emmintrin.h>
+#elif defined(JACK_ENABLE_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+	#define JACK_SCAN_NEON 1
+	#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#include <intrin.h>
+#endif
+
+namespace nand2tetris::jack::scan {
+
+    namespace {
+        // Every kernel reduces a 16-byte comparison to an integer mask with LANE_BITS bits per byte
+        // (1 for SSE2 movemask, 4 for the NEON shift-narrow trick). The generic loops below only
+        // ever divide bit positions and popcounts by LANE_BITS, so they are shared by both.
+
+        inline unsigned countTrailingZeros(const std::uint64_t m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward64(&index, m);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(m));
+#endif
+        }
+
+        inline unsigned highestBit(const std::uint64_t m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanReverse64(&index, m);
+            return static_cast<unsigned>(index);
+#else
+            return 63u - static_cast<unsigned>(__builtin_clzll(m));
+#endif
+        }
+
+        inline unsigned popCount(const std::uint64_t m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+            return static_cast<unsigned>(__popcnt64(m));
+#else
+            return static_cast<unsigned>(__builtin_popcountll(m));
+#endif
+        }
+
+#if defined(JACK_SCAN_SSE2)
+        constexpr unsigned LANE_BITS = 1;
+        constexpr std::uint64_t FULL_MASK = 0xFFFF;
+
+        using Vec = __m128i;
+
+        inline Vec load(const char* p) {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        }
+
+        inline std::uint64_t toMask(const Vec m) {
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(m));
+        }
+
+        inline Vec equals(const Vec v, const char c) {
+            return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+        }
+
+        inline std::uint64_t spaceMask(const Vec v) {
+            // '\t'..'\r' are contiguous: subtract '\t' and test (unsigned) <= 4.
+            const Vec shifted = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+            const Vec control = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted);
+            return toMask(_mm_or_si128(control, equals(v, ' ')));
+        }
+
+        inline std::uint64_t pairMask(const char* p, const char first, const char second) {
+            return toMask(_mm_and_si128(equals(load(p), first), equals(load(p + 1), second)));
+        }
+#elif defined(JACK_SCAN_NEON)
+        constexpr unsigned LANE_BITS = 4;
+        constexpr std::uint64_t FULL_MASK = ~std::uint64_t{0};
+
+        using Vec = uint8x16_t;
+
+        inline Vec load(const char* p) {
+            return vld1q_u8(reinterpret_cast<const std::uint8_t*>(p));
+        }
+
+        inline std::uint64_t toMask(const Vec m) {
+            // Narrow each 0x00/0xFF byte to a nibble: 16 bytes -> one 64-bit mask.
+            return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+        }
+
+        inline Vec equals(const Vec v, const char c) {
+            return vceqq_u8(v, vdupq_n_u8(static_cast<std::uint8_t>(c)));
+        }
+
+        inline std::uint64_t spaceMask(const Vec v) {
+            const Vec control = vcleq_u8(vsubq_u8(v, vdupq_n_u8('\t')), vdupq_n_u8(4));
+            return toMask(vorrq_u8(control, equals(v, ' ')));
+        }
+
+        inline std::uint64_t pairMask(const char* p, const char first, const char second) {
+            return toMask(vandq_u8(equals(load(p), first), equals(load(p + 1), second)));
+        }
+#endif
+    }
+
+#if defined(JACK_SCAN_SSE2) || defined(JACK_SCAN_NEON)
+    constexpr std::size_t LANES = 16;
+
+    const char* skipSpaces(const char* p, const char* end) {
+        while (end - p >= static_cast<std::ptrdiff_t>(LANES)) {
+            const std::uint64_t other = ~spaceMask(load(p)) & FULL_MASK;
+            if (other) return p + countTrailingZeros(other) / LANE_BITS;
+            p += LANES;
+        }
+        while (p < end && isSpaceChar(*p)) ++p;
+        return p;
+    }
+
+    const char* findNewline(const char* p, const char* end) {
+        while (end - p >= static_cast<std::ptrdiff_t>(LANES)) {
+            const std::uint64_t newlines = toMask(equals(load(p), '\n'));
+            if (newlines) return p + countTrailingZeros(newlines) / LANE_BITS;
+            p += LANES;
+        }
+        while (p < end && *p != '\n') ++p;
+        return p;
+    }
+
+    const char* findBlockCommentEnd(const char* p, const char* end) {
+        // pairMask reads one byte past the block, so keep LANES + 1 bytes in hand.
+        while (end - p > static_cast<std::ptrdiff_t>(LANES)) {
+            const std::uint64_t closers = pairMask(p, '*', '/');
+            if (closers) return p + countTrailingZeros(closers) / LANE_BITS;
+            p += LANES;
+        }
+        for (; p + 1 < end; ++p) {
+            if (p[0] == '*' && p[1] == '/') return p;
+        }
+        return nullptr;
+    }
+
+    LineDelta countLines(const char* p, const char* end) {
+        LineDelta delta;
+        const char* const start = p;
+        while (end - p >= static_cast<std::ptrdiff_t>(LANES)) {
+            const Vec v = load(p);
+            const std::uint64_t newlines = toMask(equals(v, '\n'));
+            std::uint64_t returns = toMask(equals(v, '\r'));
+            if (newlines) {
+                const unsigned last = highestBit(newlines);
+                delta.newlines += popCount(newlines) / LANE_BITS;
+                delta.lastNewline = static_cast<std::size_t>(p - start) + last / LANE_BITS;
+                delta.carriageReturns = 0;
+                // Keep only the carriage returns after the last newline (last is the lane's top bit).
+                returns = last + 1 >= 64 ? 0 : returns >> (last + 1);
+            }
+            delta.carriageReturns += popCount(returns) / LANE_BITS;
+            p += LANES;
+        }
+        for (; p < end; ++p) {
+            if (*p == '\n') {
+                ++delta.newlines;
+                delta.lastNewline = static_cast<std::size_t>(p - start);
+                delta.carriageReturns = 0;
+            } else if (*p == '\r') {
+                ++delta.carriageReturns;
+            }
+        }
+        return delta;
+    }
+#else
+    const char* skipSpaces(const char* p, const char* end) {
+        while (p < end && isSpaceChar(*p)) ++p;
+        return p;
+    }
+
+    const char* findNewline(const char* p, const char* end) {
+        while (p < end && *p != '\n') ++p;
+        return p;
+    }
+
+    const char* findBlockCommentEnd(const char* p, const char* end) {
+        for (; p + 1 < end; ++p) {
+            if (p[0] == '*' && p[1] == '/') return p;
+        }
+        return nullptr;
+    }
+
+    LineDelta countLines(const char* p, const char* end) {
+        LineDelta delta;
+        const char* const start = p;
+        for (; p < end; ++p) {
+            if (*p == '\n') {
+                ++delta.newlines;
+                delta.lastNewline = static_cast<std::size_t>(p - start);
+                delta.carriageReturns = 0;
+            } else if (*p == '\r') {
+                ++delta.carriageReturns;
+            }
+        }
+        return delta;
+    }
+#endif
+
+    const char* backendName() {
+#if defined(JACK_SCAN_SSE2)
+        return "sse2";
+#elif defined(JACK_SCAN_NEON)
+        return "neon";
+#else
+        return "scalar";
+#endif
+    }
+}
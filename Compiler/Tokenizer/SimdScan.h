@@ -0,0 +1,48 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_SIMD_SCAN_H
+#define NAND2TETRIS_SIMD_SCAN_H
+
+#include <cstddef>
+
+namespace nand2tetris::jack::scan {
+
+    /**
+     * @brief Line/column movement produced by skipping over a span of source bytes.
+     */
+    struct LineDelta {
+        std::size_t newlines = 0;       ///< Number of '\n' bytes in the span.
+        std::size_t lastNewline = 0;    ///< Offset of the last '\n' (valid only when newlines > 0).
+        std::size_t carriageReturns = 0;///< '\r' bytes after the last '\n' (or in the whole span if none).
+    };
+
+    /**
+     * @brief Returns the first byte in [p, end) that is not Jack whitespace, or end.
+     */
+    const char* skipSpaces(const char* p, const char* end);
+
+    /**
+     * @brief Returns the first '\n' in [p, end), or end.
+     */
+    const char* findNewline(const char* p, const char* end);
+
+    /**
+     * @brief Returns the '*' of the first "*\/" pair in [p, end), or nullptr if there is none.
+     */
+    const char* findBlockCommentEnd(const char* p, const char* end);
+
+    /**
+     * @brief Counts the newlines in [p, end) and locates the last one, so callers can update
+     * line/column for a whole span at once.
+     */
+    LineDelta countLines(const char* p, const char* end);
+
+    /**
+     * @brief Name of the vector unit the kernels were compiled for ("sse2", "neon" or "scalar").
+     */
+    const char* backendName();
+}
+
+#endif //NAND2TETRIS_SIMD_SCAN_H
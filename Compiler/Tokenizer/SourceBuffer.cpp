@@ -0,0 +1,159 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "SourceBuffer.h"
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef JACK_ENABLE_MMAP
+	#ifdef _WIN32
+		#include <windows.h>
+	#else
+		#include <fcntl.h>
+		#include <sys/mman.h>
+		#include <sys/stat.h>
+		#include <unistd.h>
+	#endif
+#endif
+
+namespace nand2tetris::jack {
+
+    SourceBuffer::SourceBuffer(const std::string &filePath) : name(filePath) {
+        if (!tryMap(filePath)) {
+            readIntoMemory(filePath);
+        }
+    }
+
+    SourceBuffer SourceBuffer::fromString(std::string name, std::string contents) {
+        SourceBuffer buffer;
+        buffer.name = std::move(name);
+        buffer.owned = std::move(contents);
+        buffer.data = buffer.owned.data();
+        buffer.length = buffer.owned.size();
+        return buffer;
+    }
+
+    SourceBuffer::~SourceBuffer() {
+        release();
+    }
+
+    SourceBuffer::SourceBuffer(SourceBuffer &&other) noexcept {
+        *this = std::move(other);
+    }
+
+    SourceBuffer& SourceBuffer::operator=(SourceBuffer &&other) noexcept {
+        if (this == &other) return *this;
+        release();
+
+        mapping = std::exchange(other.mapping, nullptr);
+#ifdef _WIN32
+        mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+        length = std::exchange(other.length, 0);
+        const bool otherOwned = other.data == other.owned.data();
+        owned = std::move(other.owned);
+        name = std::move(other.name);
+        // A moved std::string may relocate its characters (small-string buffer), so re-point at ours.
+        data = mapping ? static_cast<const char*>(mapping) : (otherOwned ? owned.data() : "");
+        other.data = "";
+        return *this;
+    }
+
+    bool SourceBuffer::tryMap(const std::string &filePath) {
+#ifndef JACK_ENABLE_MMAP
+        (void)filePath;
+        return false;
+#elif defined(_WIN32)
+        HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size;
+        // Zero-length files cannot be mapped; let the stream path produce the empty buffer.
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file); // The mapping object keeps its own reference to the file.
+        if (!handle) return false;
+
+        void* view = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(handle);
+            return false;
+        }
+
+        mapping = view;
+        mappingHandle = handle;
+        data = static_cast<const char*>(view);
+        length = static_cast<std::size_t>(size.QuadPart);
+        return true;
+#else
+        const int fd = ::open(filePath.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st{};
+        // Zero-length files cannot be mapped; let the stream path produce the empty buffer.
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+
+        const auto size = static_cast<std::size_t>(st.st_size);
+        void* view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping keeps the file alive.
+        if (view == MAP_FAILED) return false;
+
+        // The tokenizer reads front to back exactly once.
+        ::madvise(view, size, MADV_SEQUENTIAL);
+
+        mapping = view;
+        data = static_cast<const char*>(view);
+        length = size;
+        return true;
+#endif
+    }
+
+    void SourceBuffer::readIntoMemory(const std::string &filePath) {
+        std::ifstream in(filePath, std::ios::binary | std::ios::ate);
+        if (!in) {
+            throw std::runtime_error("Cannot open Jack file: " + filePath);
+        }
+
+        // Size the buffer once and read it in a single call instead of streaming byte by byte.
+        const std::streamsize size = in.tellg();
+        if (size < 0) {
+            throw std::runtime_error("Cannot read Jack file: " + filePath);
+        }
+        owned.resize(static_cast<std::size_t>(size));
+        in.seekg(0);
+        if (size > 0 && !in.read(owned.data(), size)) {
+            throw std::runtime_error("Cannot read Jack file: " + filePath);
+        }
+
+        data = owned.data();
+        length = owned.size();
+    }
+
+    void SourceBuffer::release() noexcept {
+        if (mapping) {
+#ifdef JACK_ENABLE_MMAP
+	#ifdef _WIN32
+            UnmapViewOfFile(mapping);
+            CloseHandle(mappingHandle);
+            mappingHandle = nullptr;
+	#else
+            ::munmap(mapping, length);
+	#endif
+#endif
+            mapping = nullptr;
+        }
+        owned.clear();
+        data = "";
+        length = 0;
+    }
+}
@@ -0,0 +1,96 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_SOURCE_BUFFER_H
+#define NAND2TETRIS_SOURCE_BUFFER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Owns the raw bytes of a source file for the lifetime of a compilation unit.
+     *
+     * Every Token, AST node and GlobalRegistry entry is a string_view into this buffer,
+     * so it must outlive all of them. When the platform supports it (and JACK_ENABLE_MMAP is on),
+     * the file is memory-mapped read-only and the views point straight into the page cache.
+     * Otherwise, or if mapping fails, the file is read into an owned std::string.
+     *
+     * A buffer can also be built from bytes already in memory (fromString()), which lets a
+     * compiler embedded in another program work without touching the filesystem.
+     */
+    class SourceBuffer {
+        public:
+            SourceBuffer() = default;
+
+            /**
+             * @brief Loads a file, mapping it if possible.
+             *
+             * @param filePath The file to load.
+             * @throws std::runtime_error if the file cannot be opened or read.
+             */
+            explicit SourceBuffer(const std::string& filePath);
+
+            /**
+             * @brief Takes ownership of source text that is already in memory.
+             *
+             * @param name What diagnostics call the source (usually a file name, e.g. "Main.jack").
+             * @param contents The Jack source code.
+             */
+            static SourceBuffer fromString(std::string name, std::string contents);
+
+            ~SourceBuffer();
+
+            SourceBuffer(const SourceBuffer&) = delete;
+            SourceBuffer& operator=(const SourceBuffer&) = delete;
+            SourceBuffer(SourceBuffer&& other) noexcept;
+            SourceBuffer& operator=(SourceBuffer&& other) noexcept;
+
+            /**
+             * @brief Returns the file contents.
+             */
+            std::string_view view() const { return {data, length}; }
+
+            /**
+             * @brief The path the contents were loaded from, or the name given to fromString().
+             */
+            const std::string& getName() const { return name; }
+
+            /**
+             * @brief True if the contents live in a memory mapping rather than an owned copy.
+             */
+            bool isMapped() const { return mapping != nullptr; }
+
+        private:
+            const char* data = "";  ///< Start of the contents (mapping or owned.data()).
+            std::size_t length = 0; ///< Number of bytes.
+
+            void* mapping = nullptr; ///< Base address of the mapping, or nullptr when using 'owned'.
+#ifdef _WIN32
+            void* mappingHandle = nullptr; ///< HANDLE returned by CreateFileMapping.
+#endif
+            std::string owned; ///< Fallback storage when the file is not mapped.
+            std::string name;  ///< File path or in-memory name.
+
+            /**
+             * @brief Attempts to memory-map the file.
+             * @return true on success; false means the caller should fall back to reading.
+             */
+            bool tryMap(const std::string& filePath);
+
+            /**
+             * @brief Reads the whole file into 'owned' with a single sized read.
+             */
+            void readIntoMemory(const std::string& filePath);
+
+            /**
+             * @brief Releases the mapping (if any) and resets to the empty state.
+             */
+            void release() noexcept;
+    };
+}
+
+#endif //NAND2TETRIS_SOURCE_BUFFER_H
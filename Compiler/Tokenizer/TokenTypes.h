@@ -5,8 +5,12 @@
 #ifndef NAND2TETRIS_TOKEN_H
 #define NAND2TETRIS_TOKEN_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include "../Interner/SymbolId.h"
 
 namespace nand2tetris::jack {
 
@@ -32,6 +36,13 @@ namespace nand2tetris::jack {
         ELSE, WHILE, RETURN, TRUE_, FALSE_, NULL_, THIS_
     };
 
+    /**
+     * @brief The interned id of a keyword's spelling (the StringInterner reserves these first).
+     */
+    constexpr SymbolId keywordSymbol(const Keyword kw) {
+        return 1 + static_cast<SymbolId>(kw);
+    }
+
     /**
      * @brief Converts a Keyword enum value to its string representation.
      *
@@ -66,16 +77,13 @@ namespace nand2tetris::jack {
         return "<unknown>";
     }
 
-    /**
-     * @brief Checks if a string corresponds to a Jack keyword.
-     *
-     * @param s The string to check.
-     * @param outKw Output parameter where the corresponding Keyword enum will be stored if found.
-     * @return true if the string is a keyword, false otherwise.
-     */
+    namespace detail {
+        struct KeywordEntry {
+            std::string_view text;
+            Keyword keyword;
+        };
 
-    inline bool isKeywordString(std::string_view s, Keyword &outKw) {
-        static const std::unordered_map<std::string_view, Keyword> keywordMap = {
+        inline constexpr std::array<KeywordEntry, 21> KEYWORDS = {{
             {"class",       Keyword::CLASS},
             {"method",      Keyword::METHOD},
             {"function",    Keyword::FUNCTION},
@@ -97,17 +105,109 @@ namespace nand2tetris::jack {
             {"false",       Keyword::FALSE_},
             {"null",        Keyword::NULL_},
             {"this",        Keyword::THIS_}
-        };
+        }};
+
+        inline constexpr std::size_t KEYWORD_MIN_LENGTH = 2;  ///< "do", "if"
+        inline constexpr std::size_t KEYWORD_MAX_LENGTH = 11; ///< "constructor"
+        inline constexpr std::size_t KEYWORD_TABLE_SIZE = 32;
+
+        /**
+         * @brief Perfect hash over the 21 Jack keywords (first two characters plus length).
+         *
+         * Only defined for strings of at least KEYWORD_MIN_LENGTH characters.
+         */
+        constexpr std::size_t keywordHash(const std::string_view s) {
+            return (static_cast<unsigned char>(s[0]) * 2u +
+                    static_cast<unsigned char>(s[1]) * 14u +
+                    s.size() * 5u) & (KEYWORD_TABLE_SIZE - 1);
+        }
+
+        constexpr std::array<std::int8_t, KEYWORD_TABLE_SIZE> makeKeywordTable() {
+            std::array<std::int8_t, KEYWORD_TABLE_SIZE> table{};
+            for (auto& slot : table) slot = -1;
+            for (std::size_t i = 0; i < KEYWORDS.size(); ++i) {
+                table[keywordHash(KEYWORDS[i].text)] = static_cast<std::int8_t>(i);
+            }
+            return table;
+        }
+
+        /// Maps keywordHash() to an index into KEYWORDS, or -1 for an empty slot.
+        inline constexpr std::array<std::int8_t, KEYWORD_TABLE_SIZE> KEYWORD_TABLE = makeKeywordTable();
 
-        const auto it = keywordMap.find(s);
-        if (it != keywordMap.end()) {
-            outKw = it->second;
+        constexpr bool keywordHashIsPerfect() {
+            for (std::size_t i = 0; i < KEYWORDS.size(); ++i) {
+                if (KEYWORD_TABLE[keywordHash(KEYWORDS[i].text)] != static_cast<std::int8_t>(i)) return false;
+            }
             return true;
         }
+        static_assert(keywordHashIsPerfect(), "keywordHash() collides; pick new multipliers");
+    }
+
+    /**
+     * @brief Checks if a string corresponds to a Jack keyword.
+     *
+     * One perfect-hash probe and one string compare; no allocation and no static-init guard.
+     *
+     * @param s The string to check.
+     * @param outKw Output parameter where the corresponding Keyword enum will be stored if found.
+     * @return true if the string is a keyword, false otherwise.
+     */
+    constexpr bool isKeywordString(const std::string_view s, Keyword &outKw) {
+        if (s.size() < detail::KEYWORD_MIN_LENGTH || s.size() > detail::KEYWORD_MAX_LENGTH) {
+            return false;
+        }
 
-        return false;
+        const std::int8_t index = detail::KEYWORD_TABLE[detail::keywordHash(s)];
+        if (index < 0 || detail::KEYWORDS[index].text != s) {
+            return false;
+        }
+
+        outKw = detail::KEYWORDS[index].keyword;
+        return true;
     }
 
+    /**
+     * @brief Character classes used by the Tokenizer's scanning loops.
+     */
+    enum CharClass : std::uint8_t {
+        CHAR_SPACE       = 1u << 0, ///< ' ', '\t', '\n', '\v', '\f', '\r' (same set as std::isspace in the C locale).
+        CHAR_DIGIT       = 1u << 1, ///< '0'-'9'.
+        CHAR_IDENT_START = 1u << 2, ///< 'a'-'z', 'A'-'Z', '_'.
+        CHAR_SYMBOL      = 1u << 3  ///< One of the Jack symbols: {}()[].,;+-*/&|<>=~
+    };
+
+    namespace detail {
+        constexpr std::array<std::uint8_t, 256> makeCharClassTable() {
+            std::array<std::uint8_t, 256> table{};
+            for (const char c : std::string_view(" \t\n\v\f\r")) table[static_cast<unsigned char>(c)] |= CHAR_SPACE;
+            for (char c = '0'; c <= '9'; ++c) table[static_cast<unsigned char>(c)] |= CHAR_DIGIT;
+            for (char c = 'a'; c <= 'z'; ++c) table[static_cast<unsigned char>(c)] |= CHAR_IDENT_START;
+            for (char c = 'A'; c <= 'Z'; ++c) table[static_cast<unsigned char>(c)] |= CHAR_IDENT_START;
+            table[static_cast<unsigned char>('_')] |= CHAR_IDENT_START;
+            for (const char c : std::string_view("{}()[].,;+-*/&|<>=~")) table[static_cast<unsigned char>(c)] |= CHAR_SYMBOL;
+            return table;
+        }
+
+        /// CharClass bits for every byte value.
+        inline constexpr std::array<std::uint8_t, 256> CHAR_CLASS_TABLE = makeCharClassTable();
+    }
+
+    /**
+     * @brief Tests whether a character belongs to any of the given CharClass bits.
+     *
+     * @param c The character to classify.
+     * @param mask One or more CharClass values OR-ed together.
+     */
+    constexpr bool hasCharClass(const char c, const std::uint8_t mask) {
+        return (detail::CHAR_CLASS_TABLE[static_cast<unsigned char>(c)] & mask) != 0;
+    }
+
+    constexpr bool isSpaceChar(const char c)      { return hasCharClass(c, CHAR_SPACE); }
+    constexpr bool isDigitChar(const char c)      { return hasCharClass(c, CHAR_DIGIT); }
+    constexpr bool isIdentStartChar(const char c) { return hasCharClass(c, CHAR_IDENT_START); }
+    constexpr bool isIdentChar(const char c)      { return hasCharClass(c, CHAR_IDENT_START | CHAR_DIGIT); }
+    constexpr bool isSymbolChar(const char c)     { return hasCharClass(c, CHAR_SYMBOL); }
+
     /**
      * @brief Converts a TokenType enum value to its string representation.
      *
@@ -127,26 +227,96 @@ namespace nand2tetris::jack {
     }
 
     /**
-     * @brief Base class representing a token in the Jack language.
+     * @brief A single token of the Jack language.
      *
-     * This abstract struct holds common information for all tokens, such as type and location.
+     * Tokens are small tagged values (no heap allocation, no virtual dispatch) that the Tokenizer
+     * hands out by value. The payload depends on the type:
+     *  - IDENTIFIER: a string_view into the source buffer, plus its interned SymbolId.
+     *  - SYMBOL, STRING_CONST: a string_view into the source buffer.
+     *  - KEYWORD: the Keyword enum (its spelling is available through getValue(), its id through getSymbol()).
+     *  - INT_CONST: the integer value.
      */
     struct Token {
-        protected:
+        private:
+            std::string_view text;                   ///< Text payload (identifier/symbol/string, or keyword spelling).
+            union {
+                int intVal = 0;                      ///< Integer payload for INT_CONST.
+                SymbolId symbol;                     ///< Interned name for IDENTIFIER and KEYWORD.
+            };
+            int line = 0;                            ///< The line number where the token appears.
+            int column = 0;                          ///< The column number where the token appears.
             TokenType type = TokenType::END_OF_FILE; ///< The type of the token.
-            int line;                        ///< The line number where the token appears.
-            int column;                      ///< The column number where the token appears.
+            Keyword keyword{};                       ///< Keyword payload for KEYWORD.
+
+            Token(const TokenType t, const std::string_view text, const int intVal, const Keyword kw,
+                  const int line, const int column)
+                : text(text), intVal(intVal), line(line), column(column), type(t), keyword(kw) {}
 
         public:
             /**
-             * @brief Constructs a new Token.
+             * @brief Constructs an END_OF_FILE token at line 0, column 0.
+             */
+            Token() = default;
+
+            /**
+             * @brief Creates a token that carries text (Identifier, String Constant, Symbol).
              *
              * @param t The type of the token.
+             * @param text The text content.
              * @param line The line number.
              * @param column The column number.
              */
-            explicit Token(const TokenType t, const int line, const int column)
-                : type(t), line(line), column(column) {}
+            static Token makeText(const TokenType t, const std::string_view text, const int line, const int column) {
+                return {t, text, 0, Keyword{}, line, column};
+            }
+
+            /**
+             * @brief Creates an identifier token.
+             *
+             * @param text The identifier's spelling.
+             * @param symbol Its interned id.
+             * @param line The line number.
+             * @param column The column number.
+             */
+            static Token makeIdentifier(const std::string_view text, const SymbolId symbol, const int line, const int column) {
+                Token t{TokenType::IDENTIFIER, text, 0, Keyword{}, line, column};
+                t.symbol = symbol;
+                return t;
+            }
+
+            /**
+             * @brief Creates an integer constant token.
+             *
+             * @param val The integer value.
+             * @param line The line number.
+             * @param column The column number.
+             */
+            static Token makeInt(const int val, const int line, const int column) {
+                return {TokenType::INT_CONST, {}, val, Keyword{}, line, column};
+            }
+
+            /**
+             * @brief Creates a keyword token.
+             *
+             * @param kw The keyword value.
+             * @param line The line number.
+             * @param column The column number.
+             */
+            static Token makeKeyword(const Keyword kw, const int line, const int column) {
+                Token t{TokenType::KEYWORD, keywordToString(kw), 0, kw, line, column};
+                t.symbol = keywordSymbol(kw);
+                return t;
+            }
+
+            /**
+             * @brief Creates the End-Of-File token.
+             *
+             * @param line The line number.
+             * @param column The column number.
+             */
+            static Token makeEof(const int line, const int column) {
+                return {TokenType::END_OF_FILE, {}, 0, Keyword{}, line, column};
+            }
 
             /**
              * @brief Gets the type of the token.
@@ -166,141 +336,56 @@ namespace nand2tetris::jack {
              */
             int getColumn() const { return column; }
 
-            /**
-             * @brief Returns a string representation of the token for debugging.
-             * @return A string describing the token.
-             */
-            virtual std::string toString() const = 0;
-
             /**
              * @brief Gets the string value of the token if applicable.
-             * @return A string_view of the token's value.
-             */
-            virtual std::string_view getValue() const { return ""; }
-
-            virtual ~Token() = default;
-    };
-
-    /**
-     * @brief Represents a token that holds text content (Identifier, String Constant, Symbol).
-     */
-    struct TextToken final : public Token {
-        private:
-            std::string_view text; ///< The text content of the token.
-
-        public:
-            /**
-             * @brief Constructs a new TextToken.
              *
-             * @param t The type of the token.
-             * @param text The text content.
-             * @param line The line number.
-             * @param column The column number.
+             * Identifiers, symbols and strings return their text; keywords return their spelling.
+             * Integer constants and EOF return an empty view.
+             *
+             * @return A string_view of the token's value.
              */
-            TextToken(const TokenType t, const std::string_view text, const int line, const int column)
-                : Token(t, line, column), text(text) {};
+            std::string_view getValue() const { return text; }
 
             /**
-             * @brief Gets the text content of the token.
+             * @brief Gets the text content of an IDENTIFIER, SYMBOL or STRING_CONST token.
              * @return The text content.
              */
             std::string_view getText() const { return text; }
 
-            std::string toString() const override {
-                return "[" + std::to_string(line) + ":" + std::to_string(column) + "] " +
-                       typeToString(type) + " '" + std::string(text) + "'";
-            }
-
-            ~TextToken() override = default;
-
-            std::string_view getValue() const override { return text; }
-    };
-
-    /**
-     * @brief Represents an integer constant token.
-     */
-    struct IntToken final : public Token {
-        private:
-            int intVal = 0; ///< The integer value.
-
-        public:
             /**
-             * @brief Constructs a new IntToken.
-             *
-             * @param val The integer value.
-             * @param line The line number.
-             * @param column The column number.
+             * @brief Gets the interned name of an IDENTIFIER or KEYWORD token.
+             * @return The SymbolId (NO_SYMBOL for other token types).
              */
-            explicit IntToken(const int val, const int line, const int column)
-                : Token(TokenType::INT_CONST, line, column), intVal(val) {}
+            SymbolId getSymbol() const {
+                return type == TokenType::IDENTIFIER || type == TokenType::KEYWORD ? symbol : NO_SYMBOL;
+            }
 
             /**
-             * @brief Gets the integer value.
+             * @brief Gets the value of an INT_CONST token.
              * @return The integer value.
              */
             int getInt() const { return intVal; }
 
-            std::string toString() const override {
-                return "[" + std::to_string(line) + ":" + std::to_string(column) + "] " +
-                       typeToString(type) + " '" + std::to_string(intVal) + "'";
-            }
-
-            ~IntToken() override = default;
-    };
-
-    /**
-     * @brief Represents a keyword token.
-     */
-    struct KeywordToken final : public Token {
-        private:
-            Keyword keyword{}; ///< The specific keyword.
-
-        public:
             /**
-             * @brief Constructs a new KeywordToken.
-             *
-             * @param keyword The keyword value.
-             * @param line The line number.
-             * @param column The column number.
-             */
-            explicit KeywordToken(const Keyword keyword, const int line, const int column)
-                : Token(TokenType::KEYWORD, line, column), keyword(keyword) {}
-
-            /**
-             * @brief Gets the keyword value.
+             * @brief Gets the value of a KEYWORD token.
              * @return The Keyword.
              */
             Keyword getKeyword() const { return keyword; }
 
-            std::string toString() const override {
+            /**
+             * @brief Returns a string representation of the token for debugging.
+             * @return A string describing the token.
+             */
+            std::string toString() const {
+                std::string value;
+                switch (type) {
+                    case TokenType::INT_CONST:   value = std::to_string(intVal); break;
+                    case TokenType::END_OF_FILE: value = "<EOF>"; break;
+                    default:                     value = std::string(text); break;
+                }
                 return "[" + std::to_string(line) + ":" + std::to_string(column) + "] " +
-                       typeToString(type) + " '" + keywordToString(keyword) + "'";
+                       typeToString(type) + " '" + value + "'";
             }
-
-            ~KeywordToken() override = default;
-
-            std::string_view getValue() const override { return keywordToString(this->keyword); }
-    };
-
-    /**
-     * @brief Represents the End-Of-File token.
-     */
-    struct EofToken final : public Token {
-        /**
-         * @brief Constructs a new EofToken.
-         *
-         * @param line The line number.
-         * @param column The column number.
-         */
-        EofToken(const int line, const int column)
-            : Token(TokenType::END_OF_FILE, line, column) {}
-
-        std::string toString() const override {
-            return "[" + std::to_string(line) + ":" + std::to_string(column) + "] " +
-                   typeToString(type) + " '<EOF>'";
-        }
-
-        ~EofToken() override = default;
     };
 }
 
@@ -3,35 +3,49 @@
 //
 
 #include "Tokenizer.h"
-#include <fstream>
+#include "SimdScan.h"
+#include "../Interner/StringInterner.h"
+#include "../Stats/Stats.h"
+#include <algorithm>
 #include <stdexcept>
-#include <unordered_map>
 #include <string_view>
+#include <utility>
 
 namespace nand2tetris::jack {
 
-    Tokenizer::Tokenizer(const std::string &filePath) : fileName(filePath) {
+    Tokenizer::Tokenizer(const std::string &filePath, DiagnosticSink* diagnostics)
+        : fileName(filePath), diagnostics(diagnostics) {
         // Load the raw file content into the buffer first.
         loadFile(filePath);
         // Prime the tokenizer by fetching the first token immediately.
         currentToken = fetchNext();
     }
 
-    std::unique_ptr<Token> Tokenizer::fetchNext() {
+    Tokenizer::Tokenizer(SourceBuffer source, DiagnosticSink* diagnostics)
+        : fileName(source.getName()), diagnostics(diagnostics) {
+        loadBuffer(std::move(source));
+        currentToken = fetchNext();
+    }
+
+    Token Tokenizer::fetchNext() {
         // Before attempting to read a token, we must bypass any whitespace or comments
         // that might precede it.
         skipWhitespaceAndComments();
-        return nextToken();
+        ++tokenCount;
+        Token token = nextToken();
+        JACK_STAT_AT(tokens, token.getType());
+        return token;
     }
 
     const Token& Tokenizer::peek() {
         // Lazy load the lookahead token only when requested.
         // This allows us to see what's coming next without consuming it.
-        if (!peekToken) {
+        if (!hasPeek) {
             peekToken = fetchNext();
+            hasPeek = true;
         }
 
-        return *peekToken;
+        return peekToken;
     }
 
     void Tokenizer::loadFile(const std::string &filePath) {
@@ -39,12 +53,13 @@ namespace nand2tetris::jack {
         if (filePath.length() < 5 || filePath.substr(filePath.length() - 5) != ".jack") {
             throw std::runtime_error("Invalid file extension. Expected a .jack file: " + filePath);
         }
-        std::ifstream in(filePath);
-        if (!in) {
-            throw std::runtime_error("Cannot open Jack file: " + filePath);
-        }
-        // Read the entire file into the 'src' string buffer using iterators.
-        src.assign((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        // Map (or, as a fallback, read) the file. All token views point into this buffer.
+        loadBuffer(SourceBuffer(filePath));
+    }
+
+    void Tokenizer::loadBuffer(SourceBuffer buffer) {
+        source = std::move(buffer);
+        src = source.view();
 
         // Reset parsing state.
         pos = 0;
@@ -52,37 +67,51 @@ namespace nand2tetris::jack {
         column = 1;
     }
 
-    void Tokenizer::advanceChar() {
-        if (pos >= src.size()) {
+    void Tokenizer::advanceTo(const std::size_t newPos) {
+        // The gap between two tokens is usually a few bytes; walk those directly.
+        if (newPos - pos < SHORT_SPAN) {
+            for (; pos < newPos; ++pos) {
+                const char c = src[pos];
+                if (c == '\n') {
+                    ++line;
+                    column = 1;
+                } else if (c != '\r') {
+                    // Ignore carriage returns; we count lines on \n.
+                    ++column;
+                }
+            }
             return;
         }
-        const char c = src[pos++];
-
-        // Handle line endings to keep track of line/column numbers for error reporting.
-        if (c == '\n') {
-            ++line;
-            column = 1;
-        } else if (c == '\r') {
-            // Ignore carriage returns; we count lines on \n.
+
+        // Recompute line/column for the whole skipped span at once: newlines are counted with
+        // vector popcounts, and the column restarts after the last one. Carriage returns never
+        // occupy a column (lines are counted on \n), matching the byte-at-a-time rules exactly.
+        const scan::LineDelta delta = scan::countLines(src.data() + pos, src.data() + newPos);
+        if (delta.newlines > 0) {
+            line += delta.newlines;
+            column = 1 + (newPos - (pos + delta.lastNewline + 1)) - delta.carriageReturns;
         } else {
-            ++column;
+            column += (newPos - pos) - delta.carriageReturns;
         }
+        pos = newPos;
+    }
+
+    void Tokenizer::advanceColumns(const std::size_t count) {
+        pos += count;
+        column += count;
     }
 
     bool Tokenizer::hasMoreTokens() const {
-        // If currentToken is null, we assume we haven't started or are in a valid state
-        // to fetch more, unless we explicitly hit EOF.
-        if (!currentToken) {
-            return true;
-        }
-        return currentToken->getType() != TokenType::END_OF_FILE;
+        // The constructor primes currentToken, so we only stop once we have hit EOF.
+        return currentToken.getType() != TokenType::END_OF_FILE;
     }
 
     void Tokenizer::advance() {
         // If we have previously peeked, the next token is already waiting in peekToken.
-        // We simply move it to currentToken.
-        if (peekToken) {
-            currentToken = std::move(peekToken);
+        // We simply copy it into currentToken.
+        if (hasPeek) {
+            currentToken = peekToken;
+            hasPeek = false;
             return;
         }
 
@@ -94,151 +123,171 @@ namespace nand2tetris::jack {
     }
 
     void Tokenizer::skipWhitespaceAndComments() {
-        while (pos < src.size()) {
-            const char c = src[pos];
+        const char* const begin = src.data();
+        const char* const end = begin + src.size();
 
+        while (pos < src.size()) {
             // Skip standard whitespace characters (space, tab, newline, etc.)
-            if (std::isspace(static_cast<unsigned char>(c))) {
-                advanceChar();
-                continue;
+            // Short runs (the usual gap between tokens) are stepped over inline; a run that is
+            // still going after SHORT_SPAN bytes is finished with the vector scanner.
+            const std::size_t shortEnd = std::min(src.size(), pos + SHORT_SPAN);
+            while (pos < shortEnd && isSpaceChar(src[pos])) {
+                if (src[pos] == '\n') {
+                    ++line;
+                    column = 1;
+                } else if (src[pos] != '\r') {
+                    ++column;
+                }
+                ++pos;
+            }
+            if (pos == shortEnd && pos < src.size() && isSpaceChar(src[pos])) {
+                advanceTo(static_cast<std::size_t>(scan::skipSpaces(begin + pos, end) - begin));
             }
 
-            // Check for line comments starting with "//"
-            if (c == '/' && pos + 1 < src.size() && src[pos + 1] == '/') {
-                advanceChar(); // consume first /
-                advanceChar(); // consume second /
-                // Consume everything until the end of the line
-                while (pos < src.size() && src[pos] != '\n') {
-                    advanceChar();
-                }
-                continue;
+            if (pos + 1 >= src.size() || src[pos] != '/') {
+                break;
             }
 
-            // Check for block comments starting with "/*"
-            if (c == '/' && pos + 1 < src.size() && src[pos + 1] == '*') {
-                advanceChar(); // consume /
-                advanceChar(); // consume *
-                // Consume everything until we find the closing "*/"
-                while (pos + 1 < src.size() && !(src[pos] == '*' && src[pos + 1] == '/')) {
-                    advanceChar();
-                }
+            // Check for line comments starting with "//": skip to the end of the line.
+            if (src[pos + 1] == '/') {
+                advanceTo(static_cast<std::size_t>(scan::findNewline(begin + pos + 2, end) - begin));
+                continue;
+            }
 
-                if (pos + 1 >= src.size()) {
-                    errorHere("Unterminated block comment");
+            // Check for block comments starting with "/*": skip past the closing "*/".
+            if (src[pos + 1] == '*') {
+                const char* close = scan::findBlockCommentEnd(begin + pos + 2, end);
+                if (!close) {
+                    // Report from where the scanner gives up: the last byte (or just past "/*").
+                    advanceTo(std::max(pos + 2, src.size() - 1));
+                    lexicalError(line, column, "Unterminated block comment");
+                    advanceTo(src.size()); // The rest of the file is the comment.
+                    break;
                 }
-                advanceChar(); // consume *
-                advanceChar(); // consume /
+                advanceTo(static_cast<std::size_t>(close + 2 - begin));
                 continue;
             }
 
-            // If we hit a character that isn't whitespace or a comment start, we are done.
+            // A lone '/' is the division symbol.
             break;
         }
     }
 
-    std::unique_ptr<Token> Tokenizer::nextToken() {
-        // If we've reached the end of the source, return an EOF token.
-        if (pos >= src.size()) {
-            return std::make_unique<EofToken>(line, column);
-        }
+    Token Tokenizer::nextToken() {
+        // Loops only past characters that were reported (with a DiagnosticSink) and skipped.
+        while (true) {
+            // If we've reached the end of the source, return an EOF token.
+            if (pos >= src.size()) {
+                return Token::makeEof(static_cast<int>(line), static_cast<int>(column));
+            }
 
-        // Capture the start position of the token for error reporting.
-        std::size_t tokenLine = line;
-        std::size_t tokenColumn = column;
-        const char c = src[pos];
-
-        // Check for single-character symbols used in Jack.
-        constexpr std::string_view symbols = "{}()[].,;+-*/&|<>=~";
-        if (symbols.find(c) != std::string_view::npos) {
-            std::string_view symView = std::string_view(src).substr(pos, 1);
-            advanceChar();
-            return std::make_unique<TextToken>(TokenType::SYMBOL, symView, tokenLine, tokenColumn);
-        }
+            // Capture the start position of the token for error reporting.
+            std::size_t tokenLine = line;
+            std::size_t tokenColumn = column;
+            const char c = src[pos];
 
-        // Check for string constants starting with double quotes.
-        if (c == '"') {
-            return readString(tokenLine, tokenColumn);
-        }
+            // Check for single-character symbols used in Jack.
+            if (isSymbolChar(c)) {
+                std::string_view symView = src.substr(pos, 1);
+                advanceColumns(1);
+                return Token::makeText(TokenType::SYMBOL, symView, static_cast<int>(tokenLine), static_cast<int>(tokenColumn));
+            }
 
-        // Check for integer constants (digits).
-        if (std::isdigit(static_cast<unsigned char>(c))) {
-            return readNumber(tokenLine, tokenColumn);
-        }
+            // Check for string constants starting with double quotes.
+            if (c == '"') {
+                return readString(tokenLine, tokenColumn);
+            }
 
-        // Check for identifiers or keywords (letters or underscore).
-        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
-            return readIdentifierOrKeyword(tokenLine, tokenColumn);
-        }
+            // Check for integer constants (digits).
+            if (isDigitChar(c)) {
+                return readNumber(tokenLine, tokenColumn);
+            }
 
-        errorHere("Unexpected character: '" + std::string(1, c) + "'");
-    }
+            // Check for identifiers or keywords (letters or underscore).
+            if (isIdentStartChar(c)) {
+                return readIdentifierOrKeyword(tokenLine, tokenColumn);
+            }
 
-    std::unique_ptr<Token> Tokenizer::readString(const std::size_t tokenline, const std::size_t tokencolumn) {
-        advanceChar(); // consume the opening quote "
+            lexicalError(line, column, "Unexpected character: '" + std::string(1, c) + "'");
+            advanceColumns(1); // Never a line break: whitespace was skipped before it.
+            skipWhitespaceAndComments();
+        }
+    }
 
-        const std::size_t start = pos;
+    Token Tokenizer::readString(const std::size_t tokenline, const std::size_t tokencolumn) {
+        const std::size_t start = pos + 1; // skip the opening quote "
+        std::size_t end = start;
         // Read until we hit the closing quote.
-        while (pos < src.size() && src[pos] != '"') {
+        while (end < src.size() && src[end] != '"') {
             // Jack strings cannot contain newlines.
-            if (src[pos] == '\n' || src[pos] == '\r') errorAt(tokenline, tokencolumn, "Newline in string");
-            advanceChar();
+            if (src[end] == '\n' || src[end] == '\r') {
+                lexicalError(tokenline, tokencolumn, "Newline in string");
+                break; // Recover: the string ends with the line.
+            }
+            ++end;
         }
 
-        std::string_view val = std::string_view(src).substr(start, pos - start);
+        std::string_view val = src.substr(start, end - start);
 
-        if (pos >= src.size()) {
-            errorAt(tokenline, tokencolumn, "Unterminated string constant");
+        if (end >= src.size() || src[end] != '"') {
+            if (end >= src.size()) lexicalError(tokenline, tokencolumn, "Unterminated string constant");
+            advanceColumns(end - pos);
+            return Token::makeText(TokenType::STRING_CONST, val, static_cast<int>(tokenline), static_cast<int>(tokencolumn));
         }
-        advanceChar(); // consume the closing quote "
-        return std::make_unique<TextToken>(TokenType::STRING_CONST, val, tokenline, tokencolumn);
+        advanceColumns(end + 1 - pos); // the quotes and everything between them sit on one line
+        return Token::makeText(TokenType::STRING_CONST, val, static_cast<int>(tokenline), static_cast<int>(tokencolumn));
     }
 
     const Token& Tokenizer::current() const {
-        if (!currentToken) {
-            throw std::logic_error("Tokenizer::current() called with no current token");
-        }
-        return *currentToken;
+        return currentToken;
     }
 
-    std::unique_ptr<Token> Tokenizer::readNumber(const std::size_t tokenline, const std::size_t tokencolumn) {
+    Token Tokenizer::readNumber(const std::size_t tokenline, const std::size_t tokencolumn) {
         int value = 0;
+        std::size_t end = pos;
 
         // Consume consecutive digits.
-        while (pos < src.size() && std::isdigit(static_cast<unsigned char>(src[pos]))) {
-            const int digit = src[pos] - '0';
+        while (end < src.size() && isDigitChar(src[end])) {
+            const int digit = src[end] - '0';
 
             // Check for overflow BEFORE updating the value.
             // The maximum allowed integer in Jack is 32767.
             // If value > 3276, then value * 10 >= 32760. Adding any digit > 7 would exceed 32767.
             if (value > 3276 || (value == 3276 && digit > 7)) {
-                errorAt(tokenline, tokencolumn, "Integer constant too large (max 32767)");
+                lexicalError(tokenline, tokencolumn, "Integer constant too large (max 32767)");
+                // Recover: the whole number is one token, worth the largest constant.
+                while (end < src.size() && isDigitChar(src[end])) ++end;
+                value = 32767;
+                break;
             }
 
             value = value * 10 + digit;
-            advanceChar();
+            ++end;
         }
+        advanceColumns(end - pos);
 
-        return std::make_unique<IntToken>(value, tokenline, tokencolumn);
+        return Token::makeInt(value, static_cast<int>(tokenline), static_cast<int>(tokencolumn));
     }
 
-    std::unique_ptr<Token> Tokenizer::readIdentifierOrKeyword(const std::size_t tokenline, const std::size_t tokencolumn) {
-        const std::size_t start = pos;
+    Token Tokenizer::readIdentifierOrKeyword(const std::size_t tokenline, const std::size_t tokencolumn) {
+        std::size_t end = pos;
         // Consume alphanumeric characters and underscores.
-        while (pos < src.size() && (std::isalnum(static_cast<unsigned char>(src[pos])) || src[pos] == '_')) {
-            advanceChar();
+        while (end < src.size() && isIdentChar(src[end])) {
+            ++end;
         }
 
         // Extract the text we just scanned.
-        std::string_view s = std::string_view(src).substr(start, pos - start);
+        std::string_view s = src.substr(pos, end - pos);
+        advanceColumns(end - pos);
 
         // Check if this text matches a reserved keyword.
         Keyword kw;
         if (isKeywordString(s, kw)) {
-            return std::make_unique<KeywordToken>(kw, tokenline, tokencolumn);
+            return Token::makeKeyword(kw, static_cast<int>(tokenline), static_cast<int>(tokencolumn));
         }
 
         // Otherwise, it's a user-defined identifier.
-        return std::make_unique<TextToken>(TokenType::IDENTIFIER, s, tokenline, tokencolumn);
+        return Token::makeIdentifier(s, intern(s), static_cast<int>(tokenline), static_cast<int>(tokencolumn));
     }
 
     [[noreturn]] void Tokenizer::errorAt(const std::size_t errLine, const std::size_t errColumn, const std::string_view message) const {
@@ -248,7 +297,19 @@ namespace nand2tetris::jack {
             std::to_string(errLine) + ":" +
             std::to_string(errColumn) + ": " +
             std::string(message);
-        throw std::runtime_error(full);
+        throw CompilationError({fileName, static_cast<int>(errLine), static_cast<int>(errColumn),
+                                DiagnosticPhase::SYNTAX, std::string(message)}, full);
+    }
+
+    void Tokenizer::lexicalError(const std::size_t errLine, const std::size_t errColumn, const std::string_view message) const {
+        const Diagnostic diagnostic{fileName, static_cast<int>(errLine), static_cast<int>(errColumn),
+                                    DiagnosticPhase::LEXICAL, std::string(message)};
+        if (diagnostics) {
+            diagnostics->report(diagnostic);
+            return;
+        }
+        throw CompilationError(diagnostic, fileName + ":" + std::to_string(errLine) + ":" + std::to_string(errColumn) +
+                                           ": " + std::string(message));
     }
 
     [[noreturn]] void Tokenizer::errorHere(const std::string_view message) const {
@@ -7,8 +7,9 @@
 
 #include <string>
 #include <string_view>
-#include <memory>
 #include "TokenTypes.h"
+#include "SourceBuffer.h"
+#include "../Diagnostics/Diagnostics.h"
 
 namespace nand2tetris::jack {
 
@@ -24,9 +25,20 @@ namespace nand2tetris::jack {
              * @brief Constructs a Tokenizer for the given file.
              *
              * @param filePath The path to the .jack file to tokenize.
+             * @param diagnostics If set, lexical errors are reported there and skipped over instead of thrown.
              * @throws std::runtime_error if the file cannot be opened or has an invalid extension.
              */
-            explicit Tokenizer(const std::string& filePath);
+            explicit Tokenizer(const std::string& filePath, DiagnosticSink* diagnostics = nullptr);
+
+            /**
+             * @brief Constructs a Tokenizer over a source that is already loaded (e.g. in memory).
+             *
+             * No extension check is made; errors are reported against source.getName().
+             *
+             * @param source The Jack source code; the Tokenizer keeps it alive for its tokens.
+             * @param diagnostics If set, lexical errors are reported there and skipped over instead of thrown.
+             */
+            explicit Tokenizer(SourceBuffer source, DiagnosticSink* diagnostics = nullptr);
 
             /**
              * @brief Checks if there are more tokens in the input.
@@ -46,7 +58,6 @@ namespace nand2tetris::jack {
              * @brief Returns the current token.
              *
              * @return A reference to the current Token object.
-             * @throws std::logic_error if there is no current token.
              */
             const Token& current() const;
 
@@ -59,14 +70,14 @@ namespace nand2tetris::jack {
             const Token& peek();
 
             /**
-             * @brief Reports an error at the current tokenizer position and throws an exception.
+             * @brief Reports an error at the current tokenizer position and throws a CompilationError.
              *
              * @param message The error message.
              */
             [[noreturn]] void errorHere(std::string_view message) const;
 
             /**
-             * @brief Reports an error at a specific location and throws an exception.
+             * @brief Reports an error at a specific location and throws a CompilationError.
              *
              * @param errLine The line number of the error.
              * @param errColumn The column number of the error.
@@ -76,25 +87,54 @@ namespace nand2tetris::jack {
 
             std::string getFilePath();
 
+            /**
+             * @brief Number of tokens scanned so far (including any lookahead).
+             */
+            std::size_t getTokenCount() const { return tokenCount; }
+
+            /**
+             * @brief Size of the source file in bytes.
+             */
+            std::size_t getSourceSize() const { return src.size(); }
+
 
         private:
-            std::string src;        ///< The source code content.
+            static constexpr std::size_t SHORT_SPAN = 16; ///< Spans shorter than this skip the vector kernels.
+
+            SourceBuffer source;    ///< Owns the file bytes (memory-mapped when available).
+            std::string_view src;   ///< The source code content (a view into 'source').
             std::size_t pos = 0;    ///< Current character position in the source.
             std::size_t line = 1;   ///< Current line number.
             std::size_t column = 1; ///< Current column number.
 
             std::string fileName;   ///< The name of the file being tokenized.
+            DiagnosticSink* diagnostics; ///< Where lexical errors go; nullptr = they are thrown.
+
+            Token currentToken;     ///< The current token.
+            Token peekToken;        ///< The next token (used for lookahead, valid when hasPeek is set).
+            bool hasPeek = false;   ///< True once peek() has scanned the lookahead token.
+            std::size_t tokenCount = 0; ///< Tokens produced by fetchNext() (for tracing).
 
-            std::unique_ptr<Token> currentToken; ///< The current token.
-            std::unique_ptr<Token> peekToken = nullptr; ///< The next token (used for lookahead).
+            /**
+             * @brief A lexical error: reported to 'diagnostics' (the caller then skips over the
+             *        bad input), or thrown like errorAt() when there is no sink.
+             */
+            void lexicalError(std::size_t errLine, std::size_t errColumn, std::string_view message) const;
 
             /**
              * @brief Loads the content of the file into the source buffer.
              *
+             * The file is memory-mapped where supported, so no copy of the source is made.
+             *
              * @param filePath The path to the file.
              */
             void loadFile(const std::string& filePath);
 
+            /**
+             * @brief Takes over a loaded source buffer and resets the scanning state.
+             */
+            void loadBuffer(SourceBuffer buffer);
+
             /**
              * @brief Skips whitespace and comments in the source code.
              */
@@ -103,16 +143,16 @@ namespace nand2tetris::jack {
             /**
              * @brief Scans and returns the next token from the source.
              *
-             * @return A unique_ptr to the next Token.
+             * @return The next Token.
              */
-            std::unique_ptr<Token> nextToken();
+            Token nextToken();
 
             /**
              * @brief Helper to fetch the next token, handling whitespace skipping.
              *
-             * @return A unique_ptr to the next Token.
+             * @return The next Token.
              */
-            std::unique_ptr<Token> fetchNext();
+            Token fetchNext();
 
 
             /**
@@ -120,34 +160,39 @@ namespace nand2tetris::jack {
              *
              * @param tokenline The starting line of the token.
              * @param tokencolumn The starting column of the token.
-             * @return A unique_ptr to the resulting Token.
+             * @return The resulting Token.
              */
-            std::unique_ptr<Token> readIdentifierOrKeyword(std::size_t tokenline, std::size_t tokencolumn);
+            Token readIdentifierOrKeyword(std::size_t tokenline, std::size_t tokencolumn);
 
             /**
              * @brief Reads an integer constant from the source.
              *
              * @param tokenline The starting line of the token.
              * @param tokencolumn The starting column of the token.
-             * @return A unique_ptr to the resulting Token.
+             * @return The resulting Token.
              */
-            std::unique_ptr<Token> readNumber(std::size_t tokenline, std::size_t tokencolumn);
+            Token readNumber(std::size_t tokenline, std::size_t tokencolumn);
 
             /**
              * @brief Reads a string constant from the source.
              *
              * @param tokenline The starting line of the token.
              * @param tokencolumn The starting column of the token.
-             * @return A unique_ptr to the resulting Token.
+             * @return The resulting Token.
              */
-            std::unique_ptr<Token> readString(std::size_t tokenline, std::size_t tokencolumn);
+            Token readString(std::size_t tokenline, std::size_t tokencolumn);
 
             /**
-             * @brief Advances the current character position.
+             * @brief Moves the current position forward to 'newPos'.
              *
-             * Updates line and column counters accordingly.
+             * Updates line and column counters for every byte skipped, however many lines it spans.
+             */
+            void advanceTo(std::size_t newPos);
+
+            /**
+             * @brief Moves forward over 'count' bytes known to contain no line breaks (token text).
              */
-            void advanceChar();
+            void advanceColumns(std::size_t count);
 
     };
 }
@@ -0,0 +1,123 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "Trace.h"
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <utility>
+
+namespace nand2tetris::jack {
+
+    std::atomic<TraceRecorder*> TraceRecorder::current{nullptr};
+
+    namespace {
+        std::atomic<std::uint64_t> nextRecorderId{1};
+
+        // The calling thread's buffer in the recorder identified by 'owner'.
+        struct LocalSlot {
+            std::uint64_t owner = 0;
+            void* buffer = nullptr;
+        };
+        thread_local LocalSlot localSlot;
+
+        void writeJsonString(std::ostream& out, const std::string_view s) {
+            out << '"';
+            for (const char c : s) {
+                switch (c) {
+                    case '"':  out << "\\\""; break;
+                    case '\\': out << "\\\\"; break; // Windows paths
+                    case '\n': out << "\\n"; break;
+                    case '\t': out << "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) out << ' ';
+                        else out << c;
+                }
+            }
+            out << '"';
+        }
+    }
+
+    TraceRecorder::TraceRecorder()
+        : id(nextRecorderId.fetch_add(1, std::memory_order_relaxed)), origin(std::chrono::steady_clock::now()) {}
+
+    void TraceRecorder::install(TraceRecorder *recorder) {
+        current.store(recorder, std::memory_order_release);
+    }
+
+    double TraceRecorder::nowUs() const {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    TraceRecorder::ThreadBuffer& TraceRecorder::localBuffer() {
+        if (localSlot.owner != id) {
+            std::scoped_lock lock(buffersMtx);
+            ThreadBuffer& buffer = buffers.emplace_back();
+            buffer.tid = static_cast<int>(buffers.size());
+            buffer.name = "worker " + std::to_string(buffers.size() - 1);
+            localSlot = {id, &buffer};
+        }
+        return *static_cast<ThreadBuffer*>(localSlot.buffer);
+    }
+
+    void TraceRecorder::record(TraceEvent event) {
+        localBuffer().events.push_back(std::move(event));
+    }
+
+    void TraceRecorder::nameThisThread(std::string name) {
+        localBuffer().name = std::move(name);
+    }
+
+    void TraceRecorder::writeJson(const std::string &filePath) const {
+        std::ofstream out(filePath, std::ios::binary);
+        if (!out) {
+            throw std::runtime_error("Could not open trace file: " + filePath);
+        }
+
+        out << std::fixed << std::setprecision(3); // Timestamps are microseconds; keep ns resolution.
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        const auto separator = [&] {
+            if (!first) out << ",\n";
+            first = false;
+        };
+
+        for (const ThreadBuffer& buffer : buffers) {
+            // Metadata event: names the row in the viewer.
+            separator();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.tid << ",\"args\":{\"name\":";
+            writeJsonString(out, buffer.name);
+            out << "}}";
+
+            for (const TraceEvent& e : buffer.events) {
+                separator();
+                out << "{\"name\":\"" << e.name << "\",\"cat\":\"jack\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.tid
+                    << ",\"ts\":" << e.startUs << ",\"dur\":" << e.durationUs << ",\"args\":{\"unit\":";
+                writeJsonString(out, e.unit);
+                if (e.tokens) out << ",\"tokens\":" << e.tokens;
+                if (e.astNodes) out << ",\"astNodes\":" << e.astNodes;
+                if (e.bytes) out << ",\"bytes\":" << e.bytes;
+                out << "}}";
+            }
+        }
+        out << "\n]}\n";
+
+        if (!out) {
+            throw std::runtime_error("Could not write trace file: " + filePath);
+        }
+    }
+
+    TraceScope::TraceScope(const char *name, const std::string_view unit) : recorder(TraceRecorder::active()) {
+        if (!recorder) return;
+        event.name = name;
+        event.unit = std::string(unit);
+        event.startUs = recorder->nowUs();
+    }
+
+    TraceScope::~TraceScope() {
+        if (!recorder) return;
+        event.durationUs = recorder->nowUs() - event.startUs;
+        recorder->record(std::move(event));
+    }
+}
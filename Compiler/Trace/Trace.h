@@ -0,0 +1,134 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_TRACE_H
+#define NAND2TETRIS_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief One completed timing event ("ph":"X" in the Chrome trace-event format).
+     */
+    struct TraceEvent {
+        const char* name = "";      ///< Phase name (a string literal).
+        std::string unit;           ///< File or class the event belongs to.
+        double startUs = 0.0;       ///< Microseconds since the recorder was created.
+        double durationUs = 0.0;
+        std::size_t tokens = 0;     ///< Tokens scanned (0 = not applicable).
+        std::size_t astNodes = 0;   ///< AST nodes allocated (0 = not applicable).
+        std::size_t bytes = 0;      ///< Bytes read or emitted (0 = not applicable).
+    };
+
+    /**
+     * @brief Collects per-file, per-phase timing events and writes them as a Chrome/Perfetto trace.
+     *
+     * Each thread appends to its own buffer, so recording never contends on a shared lock (which
+     * would distort the very contention the trace is meant to show). At most one recorder is
+     * active at a time; TraceScope is a no-op when none is installed.
+     */
+    class TraceRecorder {
+        public:
+            TraceRecorder();
+            TraceRecorder(const TraceRecorder&) = delete;
+            TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+            /**
+             * @brief Makes 'recorder' the target of every TraceScope (nullptr disables tracing).
+             *
+             * Must be called before the worker threads start recording.
+             */
+            static void install(TraceRecorder* recorder);
+
+            /**
+             * @brief The installed recorder, or nullptr when tracing is off.
+             */
+            static TraceRecorder* active() { return current.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Appends an event to the calling thread's buffer.
+             */
+            void record(TraceEvent event);
+
+            /**
+             * @brief Labels the calling thread in the trace viewer (defaults to "worker N").
+             */
+            void nameThisThread(std::string name);
+
+            /**
+             * @brief Microseconds since the recorder was created.
+             */
+            double nowUs() const;
+
+            /**
+             * @brief Writes every recorded event in the Chrome trace-event JSON format.
+             *
+             * Call only after all recording threads have finished.
+             *
+             * @throws std::runtime_error if the file cannot be written.
+             */
+            void writeJson(const std::string& filePath) const;
+
+        private:
+            struct ThreadBuffer {
+                int tid = 0;
+                std::string name;
+                std::vector<TraceEvent> events;
+            };
+
+            static std::atomic<TraceRecorder*> current;
+
+            const std::uint64_t id;           ///< Distinguishes recorders, so stale thread-local buffers are never reused.
+            const std::chrono::steady_clock::time_point origin;
+            std::deque<ThreadBuffer> buffers; ///< One per recording thread; a deque keeps them in place.
+            std::mutex buffersMtx;            ///< Taken once per thread, when its buffer is created.
+
+            /**
+             * @brief The calling thread's buffer, created on first use.
+             */
+            ThreadBuffer& localBuffer();
+    };
+
+    /**
+     * @brief Times the enclosing block and records it as one trace event.
+     *
+     * Costs a single atomic load when tracing is disabled.
+     */
+    class TraceScope {
+        public:
+            /**
+             * @param name Phase name; must be a string literal (or otherwise outlive the recorder).
+             * @param unit The file or class being processed.
+             */
+            TraceScope(const char* name, std::string_view unit);
+            ~TraceScope();
+
+            TraceScope(const TraceScope&) = delete;
+            TraceScope& operator=(const TraceScope&) = delete;
+
+            void setTokens(const std::size_t n) { event.tokens = n; }
+            void setAstNodes(const std::size_t n) { event.astNodes = n; }
+            void setBytes(const std::size_t n) { event.bytes = n; }
+
+            /**
+             * @brief True when the event will actually be recorded (so callers can skip computing args).
+             */
+            bool enabled() const { return recorder != nullptr; }
+
+        private:
+            TraceRecorder* recorder;
+            TraceEvent event;
+    };
+}
+
+#endif //NAND2TETRIS_TRACE_H
@@ -0,0 +1,178 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "VMCode.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include "../Interner/StringInterner.h"
+
+namespace nand2tetris::jack {
+
+	namespace {
+		// Indexed by the enum values; each push/pop/arithmetic line is one or two appends.
+		constexpr std::string_view SEGMENT_NAMES[] = {
+			"constant", "argument", "local", "static", "this", "that", "pointer", "temp"
+		};
+		constexpr std::string_view PUSH_PREFIXES[] = {
+			"push constant ", "push argument ", "push local ", "push static ",
+			"push this ", "push that ", "push pointer ", "push temp "
+		};
+		constexpr std::string_view POP_PREFIXES[] = {
+			"pop constant ", "pop argument ", "pop local ", "pop static ",
+			"pop this ", "pop that ", "pop pointer ", "pop temp "
+		};
+		constexpr std::string_view COMMAND_NAMES[] = {
+			"add", "sub", "neg", "eq", "gt", "lt", "and", "or", "not"
+		};
+		constexpr std::string_view COMMAND_LINES[] = {
+			"add\n", "sub\n", "neg\n", "eq\n", "gt\n", "lt\n", "and\n", "or\n", "not\n"
+		};
+		// Indexed by VMOp, for the ops that take a label.
+		constexpr std::string_view LABEL_PREFIXES[] = {
+			"", "", "", "label ", "goto ", "if-goto ", "", "", ""
+		};
+	}
+
+	void VMCode::reserve(const std::size_t rows) {
+		ops.reserve(rows);
+		operands.reserve(rows);
+		args.reserve(rows);
+		names.reserve(rows);
+	}
+
+	void VMCode::clear() {
+		truncate(0);
+	}
+
+	void VMCode::truncate(const std::size_t rows) {
+		ops.resize(rows);
+		operands.resize(rows);
+		args.resize(rows);
+		names.resize(rows);
+	}
+
+	void VMCode::append(const VMInstruction &ins) {
+		const auto operand = ins.op == VMOp::ARITHMETIC ? static_cast<std::uint8_t>(ins.command)
+														: static_cast<std::uint8_t>(ins.segment);
+		append(ins.op, operand, ins.arg, ins.name);
+	}
+
+	void VMCode::append(const VMCode &other, const std::size_t begin, const std::size_t end) {
+		const auto first = static_cast<std::ptrdiff_t>(begin);
+		const auto last = static_cast<std::ptrdiff_t>(end);
+		ops.insert(ops.end(), other.ops.begin() + first, other.ops.begin() + last);
+		operands.insert(operands.end(), other.operands.begin() + first, other.operands.begin() + last);
+		args.insert(args.end(), other.args.begin() + first, other.args.begin() + last);
+		names.insert(names.end(), other.names.begin() + first, other.names.begin() + last);
+	}
+
+	void VMCode::erase(const std::size_t i) {
+		const auto at = static_cast<std::ptrdiff_t>(i);
+		ops.erase(ops.begin() + at);
+		operands.erase(operands.begin() + at);
+		args.erase(args.begin() + at);
+		names.erase(names.begin() + at);
+	}
+
+	VMInstruction VMCode::operator[](const std::size_t i) const {
+		VMInstruction ins;
+		ins.op = ops[i];
+		if (ins.op == VMOp::ARITHMETIC) ins.command = static_cast<Command>(operands[i]);
+		else ins.segment = static_cast<Segment>(operands[i]);
+		ins.arg = args[i];
+		ins.name = names[i];
+		return ins;
+	}
+
+	void VMCode::set(const std::size_t i, const VMInstruction &ins) {
+		ops[i] = ins.op;
+		operands[i] = ins.op == VMOp::ARITHMETIC ? static_cast<std::uint8_t>(ins.command)
+												 : static_cast<std::uint8_t>(ins.segment);
+		args[i] = ins.arg;
+		names[i] = ins.name;
+	}
+
+	std::string_view VMCode::segmentToString(const Segment seg) {
+		return SEGMENT_NAMES[static_cast<std::size_t>(seg)];
+	}
+
+	std::string_view VMCode::commandToString(const Command cmd) {
+		return COMMAND_NAMES[static_cast<std::size_t>(cmd)];
+	}
+
+	void VMCode::print(std::string &out, const std::size_t begin, const std::size_t end) const {
+		// Formats through a raw cursor into space made ahead of time: the longest line without a
+		// name ("push constant ~v", "not") is well under LINE_MAX bytes, and a name adds its length.
+		constexpr std::size_t LINE_MAX = 40;
+		std::size_t used = out.size();
+		out.resize(used + (end - begin) * 16 + LINE_MAX);
+		char* cursor = out.data() + used;
+		const auto reserveLine = [&](const std::size_t extra) {
+			used = static_cast<std::size_t>(cursor - out.data());
+			if (out.size() - used < LINE_MAX + extra) {
+				out.resize(std::max(out.size() * 2, used + LINE_MAX + extra));
+			}
+			cursor = out.data() + used;
+		};
+		const auto put = [&](const std::string_view text) {
+			std::memcpy(cursor, text.data(), text.size());
+			cursor += text.size();
+		};
+		const auto putInt = [&](const int value) {
+			cursor = std::to_chars(cursor, cursor + 12, value).ptr;
+		};
+
+		for (std::size_t i = begin; i < end; ++i) {
+			const int arg = args[i];
+			const std::string_view name = names[i] == NO_SYMBOL ? std::string_view() : nameOf(names[i]);
+			reserveLine(name.size());
+			switch (ops[i]) {
+				case VMOp::PUSH:
+					put(PUSH_PREFIXES[operands[i]]);
+					if (operands[i] == static_cast<std::uint8_t>(Segment::CONST) && arg < 0) {
+						// 'push constant' takes 0..32767; ~v is in range for every negative v (and -1 is "0, not").
+						putInt(~arg);
+						put("\nnot\n");
+						break;
+					}
+					putInt(arg);
+					*cursor++ = '\n';
+					break;
+				case VMOp::POP:
+					put(POP_PREFIXES[operands[i]]);
+					putInt(arg);
+					*cursor++ = '\n';
+					break;
+				case VMOp::ARITHMETIC:
+					put(COMMAND_LINES[operands[i]]);
+					break;
+				case VMOp::LABEL:
+				case VMOp::GOTO:
+				case VMOp::IF_GOTO:
+					put(LABEL_PREFIXES[static_cast<std::size_t>(ops[i])]);
+					if (name.empty()) {
+						*cursor++ = 'L';
+						putInt(arg);
+					} else {
+						put(name);
+					}
+					*cursor++ = '\n';
+					break;
+				case VMOp::CALL:
+				case VMOp::FUNCTION:
+					put(ops[i] == VMOp::CALL ? "call " : "function ");
+					put(name);
+					*cursor++ = ' ';
+					putInt(arg);
+					*cursor++ = '\n';
+					break;
+				case VMOp::RETURN:
+					put("return\n");
+					break;
+			}
+		}
+		out.resize(static_cast<std::size_t>(cursor - out.data()));
+	}
+}
@@ -0,0 +1,104 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_VM_CODE_H
+#define NAND2TETRIS_VM_CODE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "VMInstruction.h"
+
+namespace nand2tetris::jack {
+
+	/**
+	 * @brief VM code in a compact struct-of-arrays form: the compiler's intermediate representation.
+	 *
+	 * Each command is one row of four columns, 10 bytes in all: the op, its operand (segment or
+	 * arithmetic command), a 32-bit argument, and a name. Names (call and function targets, named
+	 * labels) are SymbolIds from the global interner, which serves as the label/function table;
+	 * generated labels are just their id in the argument column. Passes can scan or rewrite the
+	 * columns without touching text, and print() produces the .vm text.
+	 */
+	class VMCode {
+		public:
+			std::size_t size() const { return ops.size(); }
+			bool empty() const { return ops.empty(); }
+
+			void reserve(std::size_t rows);
+			void clear();
+
+			/**
+			 * @brief Drops every row from 'rows' on.
+			 */
+			void truncate(std::size_t rows);
+
+			void append(VMOp op, std::uint8_t operand, int arg, SymbolId name = NO_SYMBOL) {
+				ops.push_back(op);
+				operands.push_back(operand);
+				args.push_back(arg);
+				names.push_back(name);
+			}
+			void append(const VMInstruction& ins);
+
+			/**
+			 * @brief Appends rows [begin, end) of another VMCode.
+			 */
+			void append(const VMCode& other, std::size_t begin, std::size_t end);
+
+			/**
+			 * @brief Removes row 'i', moving the later ones up.
+			 */
+			void erase(std::size_t i);
+
+			/**
+			 * @brief Row 'i', unpacked.
+			 */
+			VMInstruction operator[](std::size_t i) const;
+
+			/**
+			 * @brief Overwrites row 'i'.
+			 */
+			void set(std::size_t i, const VMInstruction& ins);
+
+			VMOp op(const std::size_t i) const { return ops[i]; }
+			int arg(const std::size_t i) const { return args[i]; }
+			SymbolId name(const std::size_t i) const { return names[i]; }
+			void setArg(const std::size_t i, const int value) { args[i] = value; }
+			void setOp(const std::size_t i, const VMOp value) { ops[i] = value; }
+
+			/**
+			 * @brief Appends the .vm text of rows [begin, end) to 'out'.
+			 */
+			void print(std::string& out, std::size_t begin, std::size_t end) const;
+			void print(std::string& out) const { print(out, 0, size()); }
+
+			static std::string_view segmentToString(Segment seg);
+			static std::string_view commandToString(Command cmd);
+
+		private:
+			std::vector<VMOp> ops;
+			std::vector<std::uint8_t> operands; ///< Segment (push/pop) or Command (arithmetic).
+			std::vector<std::int32_t> args;     ///< Segment index, nArgs / nLocals, or a generated label id.
+			std::vector<SymbolId> names;        ///< Call / function target or named label; NO_SYMBOL otherwise.
+	};
+
+	/**
+	 * @brief Destination for VM code in IR form (e.g. a translator to Hack assembly), instead of text.
+	 */
+	class VMCodeSink {
+		public:
+			virtual ~VMCodeSink() = default;
+
+			/**
+			 * @brief Delivers the code of one whole class.
+			 *
+			 * @throws std::runtime_error if the code cannot be consumed.
+			 */
+			virtual void write(const VMCode& code) = 0;
+	};
+}
+
+#endif //NAND2TETRIS_VM_CODE_H
@@ -0,0 +1,41 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_VM_INSTRUCTION_H
+#define NAND2TETRIS_VM_INSTRUCTION_H
+
+#include <cstdint>
+#include "../Interner/SymbolId.h"
+
+namespace nand2tetris::jack {
+
+	enum class Segment {CONST, ARG, LOCAL, STATIC, THIS, THAT, POINTER, TEMP};
+
+	enum class Command {ADD, SUB, NEG, EQ, GT, LT, AND, OR, NOT};
+
+	enum class VMOp : std::uint8_t {PUSH, POP, ARITHMETIC, LABEL, GOTO, IF_GOTO, CALL, FUNCTION, RETURN};
+
+	/**
+	 * @brief One VM command: a row of a VMCode, unpacked.
+	 *
+	 * While it is being optimized, a 'push constant' may carry any 16-bit value; negative ones are printed
+	 * as 'push constant ~v' followed by 'not'.
+	 */
+	struct VMInstruction {
+		VMOp op = VMOp::RETURN;
+		Segment segment = Segment::CONST; ///< PUSH / POP.
+		Command command = Command::ADD;   ///< ARITHMETIC.
+		int arg = 0;                      ///< Segment index, nArgs / nLocals, or a generated label id.
+		SymbolId name = NO_SYMBOL;        ///< Call / function target, or a named label (none = generated label "L<arg>").
+
+		/**
+		 * @brief True if both are LABEL/GOTO/IF_GOTO instructions naming the same label.
+		 */
+		bool sameLabelAs(const VMInstruction& other) const {
+			return name == other.name && (name != NO_SYMBOL || arg == other.arg);
+		}
+	};
+}
+
+#endif //NAND2TETRIS_VM_INSTRUCTION_H
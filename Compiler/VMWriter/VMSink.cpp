@@ -0,0 +1,99 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "VMSink.h"
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+	#include <io.h>
+	#include <process.h>
+#else
+	#include <unistd.h>
+#endif
+
+namespace nand2tetris::jack {
+
+	FileSink::FileSink(const std::string &filePath) : path(filePath) {
+		// Text mode keeps the platform's native line endings, exactly as std::ofstream did.
+		file = std::fopen(filePath.c_str(), "w");
+		if (!file) {
+			throw std::runtime_error("Could not open output file: " + filePath);
+		}
+		// The writer already buffers the whole class; a second stdio buffer would only add a copy.
+		std::setvbuf(file, nullptr, _IONBF, 0);
+	}
+
+	FileSink::~FileSink() {
+		if (file) std::fclose(file);
+	}
+
+	void FileSink::write(const std::string_view bytes) {
+		if (bytes.empty()) return;
+		if (std::fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+			throw std::runtime_error("Could not write output file: " + path);
+		}
+	}
+
+	bool UpdateFileSink::matchesFile() const {
+		std::FILE* existing = std::fopen(path.c_str(), "r");
+		if (!existing) return false;
+		// One byte more than expected, so that a longer file is caught as well.
+		std::vector<char> buffer(contents.size() + 1);
+		const std::size_t read = std::fread(buffer.data(), 1, buffer.size(), existing);
+		std::fclose(existing);
+		return read == contents.size() && std::memcmp(buffer.data(), contents.data(), read) == 0;
+	}
+
+	bool UpdateFileSink::commit() {
+		if (matchesFile()) return false;
+
+		// Next to the target, so the rename stays within one file system. The process id keeps
+		// two compilers building the same folder off each other's temporary file.
+#ifdef _WIN32
+		const std::string temp = path + ".tmp" + std::to_string(::_getpid());
+#else
+		const std::string temp = path + ".tmp" + std::to_string(::getpid());
+#endif
+		std::error_code ec;
+		try {
+			FileSink out(temp);
+			out.write(contents);
+		} catch (const std::runtime_error&) {
+			std::filesystem::remove(temp, ec);
+			throw;
+		}
+		std::filesystem::rename(temp, path, ec); // Replaces the old file in one step
+		if (ec) {
+			std::filesystem::remove(temp, ec);
+			throw std::runtime_error("Could not replace output file: " + path);
+		}
+		return true;
+	}
+
+	void StreamSink::write(const std::string_view bytes) {
+		out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+		if (!out) {
+			throw std::runtime_error("Could not write VM output stream");
+		}
+	}
+
+	void FdSink::write(std::string_view bytes) {
+		while (!bytes.empty()) {
+#ifdef _WIN32
+			const int written = ::_write(fd, bytes.data(), static_cast<unsigned>(bytes.size()));
+#else
+			const ssize_t written = ::write(fd, bytes.data(), bytes.size());
+#endif
+			if (written < 0) {
+				if (errno == EINTR) continue;
+				throw std::runtime_error("Could not write VM output to descriptor " + std::to_string(fd));
+			}
+			bytes.remove_prefix(static_cast<std::size_t>(written));
+		}
+	}
+}
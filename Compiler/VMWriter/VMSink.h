@@ -0,0 +1,142 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_VM_SINK_H
+#define NAND2TETRIS_VM_SINK_H
+
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace nand2tetris::jack {
+
+	/**
+	 * @brief Destination for the bytes a VMWriter produces.
+	 *
+	 * The VMWriter assembles a whole class in memory and hands it over in one write() call,
+	 * so a sink only needs to move a single contiguous block to wherever it belongs.
+	 */
+	class VMSink {
+		public:
+			virtual ~VMSink() = default;
+
+			/**
+			 * @brief Delivers a block of VM code.
+			 *
+			 * @throws std::runtime_error if the bytes cannot be written.
+			 */
+			virtual void write(std::string_view bytes) = 0;
+	};
+
+	/**
+	 * @brief Writes VM code to a file on disk.
+	 *
+	 * The file is opened (and truncated) on construction so path errors surface before code
+	 * generation starts; the contents arrive in one unbuffered write.
+	 */
+	class FileSink final : public VMSink {
+		public:
+			/**
+			 * @throws std::runtime_error if the file cannot be opened for writing.
+			 */
+			explicit FileSink(const std::string& filePath);
+			~FileSink() override;
+
+			FileSink(const FileSink&) = delete;
+			FileSink& operator=(const FileSink&) = delete;
+
+			void write(std::string_view bytes) override;
+
+		private:
+			std::string path;          ///< Used in error messages.
+			std::FILE* file = nullptr; ///< Open handle, closed by the destructor.
+	};
+
+	/**
+	 * @brief Writes a file on disk only if its contents change.
+	 *
+	 * Rewriting an identical output would still bump its modification time, and with it every
+	 * downstream step keyed on it (VM translator, assembler, test runners). This sink collects
+	 * the bytes, and commit() compares them with the file already there: if they are the same it
+	 * is left untouched; otherwise they go to a temporary file next to it that is renamed over
+	 * it, so readers see either the old file or the new one, never a partial write.
+	 */
+	class UpdateFileSink final : public VMSink {
+		public:
+			explicit UpdateFileSink(std::string filePath) : path(std::move(filePath)) {}
+
+			void write(std::string_view bytes) override { contents.append(bytes); }
+
+			/**
+			 * @brief Puts the collected bytes in place, unless the file already has them.
+			 *
+			 * @return true if the file was (re)written.
+			 * @throws std::runtime_error if the file cannot be written.
+			 */
+			bool commit();
+
+		private:
+			std::string path;
+			std::string contents;
+
+			/**
+			 * @brief Whether the file exists with exactly 'contents' (read in text mode, as written).
+			 */
+			bool matchesFile() const;
+	};
+
+	/**
+	 * @brief Collects VM code in memory (for tests, tools and in-process consumers).
+	 */
+	class MemorySink final : public VMSink {
+		public:
+			void write(std::string_view bytes) override { contents.append(bytes); }
+
+			/**
+			 * @brief Everything written so far.
+			 */
+			const std::string& str() const { return contents; }
+
+			/**
+			 * @brief Moves the contents out, leaving the sink empty.
+			 */
+			std::string take() { return std::move(contents); }
+
+		private:
+			std::string contents;
+	};
+
+	/**
+	 * @brief Adapts an existing std::ostream.
+	 */
+	class StreamSink final : public VMSink {
+		public:
+			explicit StreamSink(std::ostream& out) : out(out) {}
+
+			void write(std::string_view bytes) override;
+
+		private:
+			std::ostream& out;
+	};
+
+	/**
+	 * @brief Writes to an already-open file descriptor: a pipe, a socket (POSIX) or a file.
+	 *
+	 * The descriptor is borrowed, not closed. Partial writes and EINTR are retried.
+	 */
+	class FdSink final : public VMSink {
+		public:
+			explicit FdSink(int fd) : fd(fd) {}
+
+			void write(std::string_view bytes) override;
+
+		private:
+			int fd;
+	};
+}
+
+#endif //NAND2TETRIS_VM_SINK_H
@@ -3,82 +3,108 @@
 //
 
 #include "VMWriter.h"
+#include "../Interner/StringInterner.h"
+#include "../Optimizer/PeepholeOptimizer.h"
+#include "../Stats/Stats.h"
 
 namespace nand2tetris::jack {
-	VMWriter::VMWriter(std::ostream &out):out(out) {};
-
-	// ReSharper disable once CppMemberFunctionMayBeStatic
-	std::string VMWriter::segmentToString(const Segment seg) { // NOLINT(*-convert-member-functions-to-static)
-		switch (seg) {
-			case Segment::CONST: return "constant";
-			case Segment::ARG:     return "argument";
-			case Segment::LOCAL:   return "local";
-			case Segment::STATIC:  return "static";
-			case Segment::THIS:    return "this";
-			case Segment::THAT:    return "that";
-			case Segment::POINTER: return "pointer";
-			case Segment::TEMP:    return "temp";
-		}
-		return "unknown";
-	}
-	// ReSharper disable once CppMemberFunctionMayBeStatic
-	std::string VMWriter::commandToString(const Command cmd) {// NOLINT(*-convert-member-functions-to-static)
-		switch (cmd) {
-			case Command::ADD: return "add";
-			case Command::SUB: return "sub";
-			case Command::NEG: return "neg";
-			case Command::EQ:  return "eq";
-			case Command::GT:  return "gt";
-			case Command::LT:  return "lt";
-			case Command::AND: return "and";
-			case Command::OR:  return "or";
-			case Command::NOT: return "not";
-		}
-		return "unknown";
+
+	namespace {
+		constexpr std::size_t BYTES_PER_ROW = 4; ///< Rows to reserve per byte of initial capacity. ~16K rows fit all but the largest classes.
+
+		constexpr std::uint8_t operand(const Segment seg) { return static_cast<std::uint8_t>(seg); }
+		constexpr std::uint8_t operand(const Command cmd) { return static_cast<std::uint8_t>(cmd); }
+	}
+
+	VMWriter::VMWriter(VMSink &sink, const std::size_t initialCapacity):sink(&sink) {
+		buffer.reserve(initialCapacity);
+		code.reserve(initialCapacity / BYTES_PER_ROW);
+	}
+
+	VMWriter::VMWriter(VMCodeSink &sink):codeSink(&sink) {
+		code.reserve(DEFAULT_CAPACITY / BYTES_PER_ROW);
+	}
+
+	void VMWriter::setOptimizing(const bool enabled) {
+		endFunction();
+		optimizing = enabled;
 	}
 
 	void VMWriter::writePush(const Segment segment, const int index) {
-		out << "push " << segmentToString(segment) << " " << index << "\n";
+		code.append(VMOp::PUSH, operand(segment), index);
 	}
 
 	void VMWriter::writePop(const Segment segment, const int index) {
-		out << "pop " << segmentToString(segment) << " " << index << "\n";
+		code.append(VMOp::POP, operand(segment), index);
+	}
+
+	void VMWriter::writeArithmetic(const Command command) {
+		code.append(VMOp::ARITHMETIC, operand(command), 0);
+	}
+
+	void VMWriter::writeLabel(const std::string_view label) {
+		code.append(VMOp::LABEL, 0, 0, intern(label));
+	}
+
+	void VMWriter::writeGoto(const std::string_view label) {
+		code.append(VMOp::GOTO, 0, 0, intern(label));
 	}
 
-	void VMWriter::writeArithmetic(Command command) {
-		out << commandToString(command) << "\n";
+	void VMWriter::writeIf(const std::string_view label) {
+		code.append(VMOp::IF_GOTO, 0, 0, intern(label));
 	}
 
-	void VMWriter::writeLabel(const std::string &label) const {
-		out << "label " << label << "\n";
+	void VMWriter::writeLabel(const int labelId) {
+		code.append(VMOp::LABEL, 0, labelId);
 	}
 
-	void VMWriter::writeGoto(const std::string &label) const {
-		out << "goto " << label << "\n";
+	void VMWriter::writeGoto(const int labelId) {
+		code.append(VMOp::GOTO, 0, labelId);
 	}
 
-	void VMWriter::writeIf(const std::string& label) const {
-		out << "if-goto " << label << "\n";
+	void VMWriter::writeIf(const int labelId) {
+		code.append(VMOp::IF_GOTO, 0, labelId);
 	}
 
-	void VMWriter::writeCall(const std::string& name, int nArgs) const {
-		out << "call " << name << " " << nArgs << "\n";
+	void VMWriter::writeCall(const std::string_view name, const int nArgs) {
+		writeCall(intern(name), nArgs);
 	}
 
-	void VMWriter::writeFunction(const std::string& name, int nLocals) const {
-		out << "function " << name << " " << nLocals << "\n";
+	void VMWriter::writeFunction(const std::string_view name, const int nLocals) {
+		writeFunction(intern(name), nLocals);
 	}
 
-	void VMWriter::writeReturn() const {
-		out << "return\n";
+	void VMWriter::writeCall(const SymbolId name, const int nArgs) {
+		code.append(VMOp::CALL, 0, nArgs, name);
 	}
 
-	void VMWriter::writeStringConstant(const std::string_view& str) {
+	void VMWriter::writeFunction(const SymbolId name, const int nLocals) {
+		endFunction(); // Labels are local to a function, so each one is optimized alone.
+		code.append(VMOp::FUNCTION, 0, nLocals, name);
+	}
+
+	void VMWriter::writeCall(const std::string_view className, const std::string_view subroutine, const int nArgs) {
+		writeCall(std::string(className).append(1, '.').append(subroutine), nArgs);
+	}
+
+	void VMWriter::writeFunction(const std::string_view className, const std::string_view subroutine, const int nLocals) {
+		writeFunction(std::string(className).append(1, '.').append(subroutine), nLocals);
+	}
+
+	void VMWriter::writeReturn() {
+		code.append(VMOp::RETURN, 0, 0);
+	}
+
+	void VMWriter::writeStringConstant(const std::string_view str) {
+		// Interned once per process; a string literal calls these once per character.
+		static const SymbolId STRING_NEW = intern("String.new");
+		static const SymbolId STRING_APPEND_CHAR = intern("String.appendChar");
+
 		// 1. Push length of string
 		writePush(Segment::CONST, static_cast<int>(str.length()));
 
 		// 2. Call String.new(length) -> Returns string object pointer
-		writeCall("String.new", 1);
+		writeCall(STRING_NEW, 1);
 
 		// 3. Append characters one by one
 		for (const char c : str) {
@@ -86,9 +112,33 @@ namespace nand2tetris::jack {
 			writePush(Segment::CONST, static_cast<int>(c));
 			// Call String.appendChar(this, char)
 			// Note: appendChar returns 'this', so the stack stays valid for the next call
-			writeCall("String.appendChar", 2);
+			writeCall(STRING_APPEND_CHAR, 2);
 		}
 	}
 
+	void VMWriter::endFunction() {
+		if (optimizing && functionStart < code.size()) {
+			instructionsRemoved += PeepholeOptimizer::run(code, functionStart);
+		}
+		functionStart = code.size();
+	}
 
+	void VMWriter::flush() {
+		endFunction();
+		if (code.empty()) return;
+		if constexpr (Stats::ENABLED) {
+			for (std::size_t i = 0; i < code.size(); ++i) JACK_STAT_AT(vmCommands, code.op(i));
+		}
+
+		if (codeSink) {
+			codeSink->write(code);
+		} else {
+			code.print(buffer);
+			sink->write(buffer);
+			flushedBytes += buffer.size();
+			buffer.clear(); // Keeps the capacity for any further output.
+		}
+		code.clear();
+		functionStart = 0;
+	}
 }
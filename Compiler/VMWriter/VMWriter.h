@@ -5,39 +5,109 @@
 #ifndef NAND2TETRIS_VM_WRITER_H
 #define NAND2TETRIS_VM_WRITER_H
 
-#include <ostream>
+#include <cstddef>
 #include <string>
-namespace nand2tetris::jack {
+#include <string_view>
+#include <vector>
+#include "VMCode.h"
+#include "VMSink.h"
 
-	enum class Segment {CONST, ARG, LOCAL, STATIC, THIS, THAT, POINTER, TEMP};
+namespace nand2tetris::jack {
 
-	enum class Command {ADD, SUB, NEG, EQ, GT, LT, AND, OR, NOT};
+	/**
+	 * @brief Emits VM commands for one compilation unit.
+	 *
+	 * Commands are recorded as rows of a VMCode (no text is formatted while the class is being
+	 * generated). flush() prints the class into a preallocated buffer and delivers it to the VMSink
+	 * in one write; a writer built on a VMCodeSink hands over the VMCode itself instead.
+	 * Anything not flushed when the writer is destroyed is discarded.
+	 *
+	 * With optimization on, each function is run through the PeepholeOptimizer once it is complete
+	 * (when the next function starts, or on flush()).
+	 */
 	class VMWriter {
 		public:
-			explicit VMWriter(std::ostream &out);
+			static constexpr std::size_t DEFAULT_CAPACITY = 64 * 1024; ///< Fits all but the largest classes.
+
+			explicit VMWriter(VMSink &sink, std::size_t initialCapacity = DEFAULT_CAPACITY);
+			explicit VMWriter(VMCodeSink &sink);
 			~VMWriter()=default;
 
+			/**
+			 * @brief Routes every following function through the PeepholeOptimizer.
+			 */
+			void setOptimizing(bool enabled);
+
 			void writePush(Segment segment, int index);
 			void writePop(Segment segment, int index);
 			void writeArithmetic(Command command);
 
-			void writeLabel(const std::string& label) const;
-			void writeGoto(const std::string& label) const;
-			void writeIf(const std::string& label) const;
+			void writeLabel(std::string_view label);
+			void writeGoto(std::string_view label);
+			void writeIf(std::string_view label);
+
+			/// Generated labels: recorded as "L<labelId>" without building the string.
+			void writeLabel(int labelId);
+			void writeGoto(int labelId);
+			void writeIf(int labelId);
+
+			void writeCall(std::string_view name, int nArgs);
+			void writeFunction(std::string_view name, int nLocals);
+
+			/// Qualified names that are already interned (e.g. MethodSignature::qualifiedName).
+			void writeCall(SymbolId name, int nArgs);
+			void writeFunction(SymbolId name, int nLocals);
 
-			void writeCall(const std::string& name, int nArgs) const;
-			void writeFunction(const std::string& name, int nLocals) const;
-			void writeReturn() const;
+			/// Writes the qualified name "className.subroutine".
+			void writeCall(std::string_view className, std::string_view subroutine, int nArgs);
+			void writeFunction(std::string_view className, std::string_view subroutine, int nLocals);
 
-			void writeStringConstant(const std::string_view& str);
+			void writeReturn();
+
+			void writeStringConstant(std::string_view str);
+
+			/**
+			 * @brief Hands the recorded class to the sink (printed, unless it is a VMCodeSink) and starts afresh.
+			 *
+			 * @throws std::runtime_error if the sink fails.
+			 */
+			void flush();
+
+			/**
+			 * @brief Total bytes of VM text delivered so far.
+			 */
+			std::size_t getBytesEmitted() const { return flushedBytes; }
+
+			/**
+			 * @brief Commands the optimizer has removed so far.
+			 */
+			std::size_t getInstructionsRemoved() const { return instructionsRemoved; }
+
+			/**
+			 * @brief The code recorded since the last flush().
+			 */
+			const VMCode& getCode() const { return code; }
+
+			static std::string_view segmentToString(Segment seg) { return VMCode::segmentToString(seg); }
+			static std::string_view commandToString(Command cmd) { return VMCode::commandToString(cmd); }
 
 		private:
-			std::ostream& out;
-			std::string segmentToString(Segment seg) ;
-			std::string commandToString(Command cmd) ;
+			VMSink* sink = nullptr;
+			VMCodeSink* codeSink = nullptr;
+			VMCode code;                  ///< The class so far.
+			std::string buffer;           ///< Its text, while it is being delivered.
+			std::size_t flushedBytes = 0; ///< Bytes already handed to the sink.
+
+			bool optimizing = false;
+			std::size_t functionStart = 0; ///< First row of the current function.
+			std::size_t instructionsRemoved = 0;
 
+			/**
+			 * @brief Closes the current function: runs the optimizer over it, if enabled.
+			 */
+			void endFunction();
 	};
 }
 
 
-#endif //NAND2TETRIS_VM_WRITER_H
\ No newline at end of file
+#endif //NAND2TETRIS_VM_WRITER_H
@@ -0,0 +1,210 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "AstExport.h"
+#include <string>
+#include <vector>
+
+namespace nand2tetris::jack {
+
+    namespace {
+        /// A node still to be written, or a block of statements (an if's branches, a loop body).
+        struct Pending {
+            const Node* node;
+            const ArenaList<StatementNode*>* block; ///< Instead of 'node'.
+            const char* blockTag;
+            int blockLine;
+            int depth;
+        };
+
+        void appendJsonString(std::string& out, const std::string_view s) {
+            out += '"';
+            for (const char c : s) {
+                switch (c) {
+                    case '"':  out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) out += ' ';
+                        else out += c;
+                }
+            }
+            out += '"';
+        }
+
+        void appendRecord(std::string& out, const int depth, const char* tag, const std::string_view label, const int line) {
+            out += "{\"d\":";
+            out += std::to_string(depth);
+            out += ",\"t\":\"";
+            out += tag;
+            out += "\",\"x\":";
+            appendJsonString(out, label);
+            out += ",\"l\":";
+            out += std::to_string(line);
+            out += "}\n";
+        }
+
+        /// "int a, b" for a declaration of 'names'.
+        std::string declarationLabel(const SymbolId type, const ArenaList<SymbolId>& names) {
+            std::string label(nameOf(type));
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                label += i == 0 ? " " : ", ";
+                label += nameOf(names[i]);
+            }
+            return label;
+        }
+    }
+
+    void AstExport::writeNdjson(const ClassNode &node, const std::string_view fileName, std::ostream &out) {
+        std::string text; // One write at the end: the dump is small next to the file system call.
+        text += "{\"file\":";
+        appendJsonString(text, fileName);
+        text += "}\n";
+
+        std::vector<Pending> stack{{&node, nullptr, nullptr, 0, 0}};
+        // Children are pushed last-first so that they come off the stack in source order.
+        const auto pushNode = [&stack](const Node* child, const int depth) {
+            stack.push_back({child, nullptr, nullptr, 0, depth});
+        };
+        const auto pushNodes = [&stack](const auto& children, const int depth) {
+            for (std::size_t i = children.size(); i-- > 0;) stack.push_back({children[i], nullptr, nullptr, 0, depth});
+        };
+
+        while (!stack.empty()) {
+            const Pending item = stack.back();
+            stack.pop_back();
+            const int d = item.depth;
+            if (item.block) {
+                appendRecord(text, d, item.blockTag, "", item.blockLine);
+                pushNodes(*item.block, d + 1);
+                continue;
+            }
+
+            const Node& n = *item.node;
+            const int line = n.getLine();
+            switch (n.getType()) {
+                case ASTNodeType::CLASS: {
+                    const auto& c = static_cast<const ClassNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    appendRecord(text, d, "class", nameOf(c.className), line);
+                    pushNodes(c.subroutineDecs, d + 1);
+                    pushNodes(c.classVars, d + 1);
+                    break;
+                }
+                case ASTNodeType::CLASS_VAR_DEC: {
+                    const auto& v = static_cast<const ClassVarDecNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    const std::string kind = v.kind == ClassVarKind::STATIC ? "static " : "field ";
+                    appendRecord(text, d, "classVarDec", kind + declarationLabel(v.type, v.varNames), line);
+                    break;
+                }
+                case ASTNodeType::SUBROUTINE_DEC: {
+                    const auto& s = static_cast<const SubroutineDecNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    std::string label = s.subType == SubroutineType::CONSTRUCTOR ? "constructor "
+                                      : s.subType == SubroutineType::FUNCTION ? "function " : "method ";
+                    label += nameOf(s.returnType);
+                    label += ' ';
+                    label += nameOf(s.name);
+                    label += '(';
+                    for (std::size_t i = 0; i < s.parameters.size(); ++i) {
+                        if (i != 0) label += ", ";
+                        label += nameOf(s.parameters[i].type);
+                        label += ' ';
+                        label += nameOf(s.parameters[i].name);
+                    }
+                    label += ')';
+                    appendRecord(text, d, "subroutineDec", label, line);
+                    pushNodes(s.statements, d + 1);
+                    pushNodes(s.localVars, d + 1);
+                    break;
+                }
+                case ASTNodeType::VAR_DEC: {
+                    const auto& v = static_cast<const VarDecNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    appendRecord(text, d, "varDec", declarationLabel(v.type, v.varNames), line);
+                    break;
+                }
+                case ASTNodeType::LET_STATEMENT: {
+                    const auto& s = static_cast<const LetStatementNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    std::string label(nameOf(s.varName));
+                    if (s.indexExpr) label += "[]";
+                    appendRecord(text, d, "letStatement", label, line);
+                    pushNode(s.valueExpr, d + 1);
+                    if (s.indexExpr) pushNode(s.indexExpr, d + 1);
+                    break;
+                }
+                case ASTNodeType::IF_STATEMENT: {
+                    const auto& s = static_cast<const IfStatementNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    appendRecord(text, d, "ifStatement", "", line);
+                    if (!s.elseStatements.empty()) stack.push_back({nullptr, &s.elseStatements, "else", line, d + 1});
+                    stack.push_back({nullptr, &s.ifStatements, "statements", line, d + 1});
+                    pushNode(s.condition, d + 1);
+                    break;
+                }
+                case ASTNodeType::WHILE_STATEMENT: {
+                    const auto& s = static_cast<const WhileStatementNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    appendRecord(text, d, "whileStatement", "", line);
+                    stack.push_back({nullptr, &s.body, "statements", line, d + 1});
+                    pushNode(s.condition, d + 1);
+                    break;
+                }
+                case ASTNodeType::DO_STATEMENT: {
+                    const auto& s = static_cast<const DoStatementNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    appendRecord(text, d, "doStatement", "", line);
+                    pushNode(s.callExpression, d + 1);
+                    break;
+                }
+                case ASTNodeType::RETURN_STATEMENT: {
+                    const auto& s = static_cast<const ReturnStatementNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    appendRecord(text, d, "returnStatement", "", line);
+                    if (s.expression) pushNode(s.expression, d + 1);
+                    break;
+                }
+                case ASTNodeType::INTEGER_LITERAL: {
+                    const auto& e = static_cast<const IntegerLiteralNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    appendRecord(text, d, "integerConstant", std::to_string(e.value), line);
+                    break;
+                }
+                case ASTNodeType::STRING_LITERAL: {
+                    const auto& e = static_cast<const StringLiteralNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    appendRecord(text, d, "stringConstant", e.value, line);
+                    break;
+                }
+                case ASTNodeType::KEYWORD_LITERAL: {
+                    const auto& e = static_cast<const KeywordLiteralNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    appendRecord(text, d, "keyword", keywordToString(e.value), line);
+                    break;
+                }
+                case ASTNodeType::BINARY_OP: {
+                    const auto& e = static_cast<const BinaryOpNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    appendRecord(text, d, "binaryOp", std::string(1, e.op), line);
+                    pushNode(e.right, d + 1);
+                    pushNode(e.left, d + 1);
+                    break;
+                }
+                case ASTNodeType::UNARY_OP: {
+                    const auto& e = static_cast<const UnaryOpNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    appendRecord(text, d, "unaryOp", std::string(1, e.op), line);
+                    pushNode(e.term, d + 1);
+                    break;
+                }
+                case ASTNodeType::SUBROUTINE_CALL: {
+                    const auto& e = static_cast<const CallNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    std::string label;
+                    if (e.classNameOrVar != NO_SYMBOL) {
+                        label += nameOf(e.classNameOrVar);
+                        label += '.';
+                    }
+                    label += nameOf(e.functionName);
+                    appendRecord(text, d, "subroutineCall", label, line);
+                    pushNodes(e.arguments, d + 1);
+                    break;
+                }
+                case ASTNodeType::IDENTIFIER: {
+                    const auto& e = static_cast<const IdentifierNode&>(n); // NOLINT(*-pro-type-static-cast-downcast)
+                    appendRecord(text, d, "identifier", nameOf(e.name), line);
+                    if (e.indexExpr) pushNode(e.indexExpr, d + 1);
+                    break;
+                }
+            }
+        }
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+}
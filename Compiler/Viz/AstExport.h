@@ -0,0 +1,35 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_AST_EXPORT_H
+#define NAND2TETRIS_AST_EXPORT_H
+
+#include <ostream>
+#include <string_view>
+#include "../Parser/AST.h"
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Writes a class's AST for tools/jack_viz.py (--viz-ast).
+     *
+     * The format is newline-delimited JSON: a {"file"} line, then one line per node in pre-order,
+     * {"d": depth, "t": tag, "x": label, "l": line}. A node's parent is the closest line above it
+     * with a smaller depth, so the viewer builds the tree while it reads, in a single pass.
+     *
+     * One line per AST node, not per token as Node::printXml does, and the walk uses its own
+     * stack, so deeply nested expressions cannot overflow the worker's.
+     */
+    class AstExport {
+        public:
+            /**
+             * @brief Writes 'node' as described above.
+             *
+             * @param fileName What the viewer lists the class as (e.g. "Main.jack").
+             */
+            static void writeNdjson(const ClassNode& node, std::string_view fileName, std::ostream& out);
+    };
+}
+
+#endif //NAND2TETRIS_AST_EXPORT_H
@@ -0,0 +1,210 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#include "FileWatcher.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#if defined(__linux__)
+	#include <cerrno>
+	#include <poll.h>
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#elif defined(_WIN32)
+	#include <windows.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace nand2tetris::jack {
+
+    namespace {
+        // What the polling fallback compares; the notifying platforms only use the names.
+        struct FileStamp {
+            std::uintmax_t size = 0;
+            fs::file_time_type time{};
+
+            bool operator!=(const FileStamp& other) const { return size != other.size || time != other.time; }
+        };
+
+        bool isJackFile(const fs::path& path) {
+            return path.extension() == ".jack";
+        }
+
+        // The .jack files of a folder right now. Files that vanish mid-scan are skipped, not errors.
+        std::map<std::string, FileStamp> scan(const std::string& directory) {
+            std::map<std::string, FileStamp> files;
+            std::error_code ec;
+            for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+                if (!isJackFile(it->path())) continue;
+                FileStamp stamp;
+                std::error_code statError;
+                stamp.size = it->file_size(statError);
+                stamp.time = it->last_write_time(statError);
+                if (!statError) files.emplace(it->path().filename().string(), stamp);
+            }
+            return files;
+        }
+    }
+
+    struct FileWatcher::Directory {
+        std::string path;
+        std::map<std::string, FileStamp> files; ///< The .jack files as of the last event (or poll).
+#if defined(__linux__)
+        int watch = -1;
+#elif defined(_WIN32)
+        HANDLE handle = INVALID_HANDLE_VALUE;
+        OVERLAPPED overlapped{};
+        alignas(DWORD) char buffer[16 * 1024]; ///< FILE_NOTIFY_INFORMATION records.
+
+        // Queues the next batch of notifications; they complete into 'buffer' and signal the event.
+        bool issueRead() {
+            return ReadDirectoryChangesW(handle, buffer, sizeof(buffer), FALSE,
+                                         FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE,
+                                         nullptr, &overlapped, nullptr);
+        }
+#endif
+
+        // Records an event for one file name and reports the path if it is a .jack file.
+        void note(const fs::path& name, std::vector<std::string>& changed) {
+            if (!isJackFile(name)) return;
+            const fs::path full = fs::path(path) / name;
+            std::error_code ec;
+            if (fs::exists(full, ec)) files[name.string()];
+            else files.erase(name.string());
+            changed.push_back(full.string());
+        }
+    };
+
+    FileWatcher::FileWatcher(const std::vector<std::string> &directoryPaths) {
+#if defined(__linux__)
+        inotifyFd = inotify_init1(IN_CLOEXEC);
+        if (inotifyFd < 0) throw std::runtime_error("Cannot watch for changes: inotify is unavailable.");
+#endif
+        for (const std::string& path : directoryPaths) {
+            auto dir = std::make_unique<Directory>();
+            dir->path = path;
+            dir->files = scan(path);
+#if defined(__linux__)
+            // Close-after-write rather than every write, so a file is only reported once it is complete.
+            dir->watch = inotify_add_watch(inotifyFd, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE);
+            if (dir->watch < 0) throw std::runtime_error("Cannot watch folder: " + path);
+#elif defined(_WIN32)
+            dir->handle = CreateFileA(path.c_str(), FILE_LIST_DIRECTORY,
+                                      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                      FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+            if (dir->handle == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot watch folder: " + path);
+            dir->overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+            if (!dir->overlapped.hEvent || !dir->issueRead()) {
+                if (dir->overlapped.hEvent) CloseHandle(dir->overlapped.hEvent);
+                CloseHandle(dir->handle);
+                throw std::runtime_error("Cannot watch folder: " + path);
+            }
+#endif
+            directories.push_back(std::move(dir));
+        }
+    }
+
+    FileWatcher::~FileWatcher() {
+#if defined(__linux__)
+        if (inotifyFd >= 0) ::close(inotifyFd); // Removes every watch with it.
+#elif defined(_WIN32)
+        for (const auto& dir : directories) {
+            CancelIo(dir->handle);
+            CloseHandle(dir->overlapped.hEvent);
+            CloseHandle(dir->handle);
+        }
+#endif
+    }
+
+    void FileWatcher::rescan(std::vector<std::string> &out) {
+        for (const auto& dir : directories) {
+            std::map<std::string, FileStamp> now = scan(dir->path);
+            for (const auto& [name, stamp] : dir->files) out.push_back((fs::path(dir->path) / name).string());
+            for (const auto& [name, stamp] : now) out.push_back((fs::path(dir->path) / name).string());
+            dir->files = std::move(now);
+        }
+    }
+
+    std::vector<std::string> FileWatcher::waitForChanges() {
+        std::vector<std::string> changed;
+        bool lostEvents = false;
+
+        while (changed.empty() && !lostEvents) {
+#if defined(__linux__)
+            alignas(inotify_event) char buffer[16 * 1024];
+            pollfd pfd{inotifyFd, POLLIN, 0};
+            int timeout = -1; // Block for the first event, then only drain what is already queued.
+            for (;;) {
+                const int ready = ::poll(&pfd, 1, timeout);
+                if (ready < 0 && errno == EINTR) continue;
+                if (ready < 0) throw std::runtime_error("Watching for changes failed (poll).");
+                if (ready == 0) break;
+
+                const ssize_t length = ::read(inotifyFd, buffer, sizeof(buffer));
+                if (length < 0 && errno == EINTR) continue;
+                if (length <= 0) throw std::runtime_error("Watching for changes failed (read).");
+                for (const char* p = buffer; p < buffer + length;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(p);
+                    p += sizeof(inotify_event) + event->len;
+                    if (event->mask & IN_Q_OVERFLOW) lostEvents = true;
+                    if (event->len == 0) continue;
+                    const auto dir = std::find_if(directories.begin(), directories.end(),
+                                                  [event](const auto& d) { return d->watch == event->wd; });
+                    if (dir != directories.end()) (*dir)->note(event->name, changed);
+                }
+                timeout = 0;
+            }
+#elif defined(_WIN32)
+            std::vector<HANDLE> events;
+            for (const auto& dir : directories) events.push_back(dir->overlapped.hEvent);
+            DWORD timeout = INFINITE; // Block for the first event, then only drain what is already queued.
+            for (;;) {
+                const DWORD ready = WaitForMultipleObjects(static_cast<DWORD>(events.size()), events.data(), FALSE, timeout);
+                if (ready == WAIT_TIMEOUT) break;
+                if (ready >= WAIT_OBJECT_0 + events.size()) throw std::runtime_error("Watching for changes failed (wait).");
+
+                Directory& dir = *directories[ready - WAIT_OBJECT_0];
+                DWORD length = 0;
+                if (!GetOverlappedResult(dir.handle, &dir.overlapped, &length, FALSE)) {
+                    throw std::runtime_error("Watching for changes failed: " + dir.path);
+                }
+                ResetEvent(dir.overlapped.hEvent);
+                if (length == 0) lostEvents = true; // The records did not fit in the buffer.
+                for (DWORD offset = 0; length > 0;) {
+                    const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(dir.buffer + offset);
+                    dir.note(std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR)), changed);
+                    if (info->NextEntryOffset == 0) break;
+                    offset += info->NextEntryOffset;
+                }
+                if (!dir.issueRead()) throw std::runtime_error("Watching for changes failed: " + dir.path);
+                timeout = 0;
+            }
+#else
+            std::this_thread::sleep_for(std::chrono::milliseconds(POLL_INTERVAL_MS));
+            for (const auto& dir : directories) {
+                std::map<std::string, FileStamp> now = scan(dir->path);
+                for (const auto& [name, stamp] : now) {
+                    const auto it = dir->files.find(name);
+                    if (it == dir->files.end() || it->second != stamp) changed.push_back((fs::path(dir->path) / name).string());
+                }
+                for (const auto& [name, stamp] : dir->files) {
+                    if (!now.count(name)) changed.push_back((fs::path(dir->path) / name).string());
+                }
+                dir->files = std::move(now);
+            }
+#endif
+        }
+
+        if (lostEvents) rescan(changed);
+        std::sort(changed.begin(), changed.end());
+        changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+        return changed;
+    }
+}
@@ -0,0 +1,60 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+#ifndef NAND2TETRIS_FILE_WATCHER_H
+#define NAND2TETRIS_FILE_WATCHER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nand2tetris::jack {
+
+    /**
+     * @brief Reports .jack files that are created, rewritten, renamed or deleted in a set of folders.
+     *
+     * Uses the operating system's change notifications: inotify on Linux, ReadDirectoryChangesW
+     * on Windows. Elsewhere (e.g. macOS) the folders are polled every POLL_INTERVAL_MS, comparing
+     * each file's size and modification time.
+     */
+    class FileWatcher {
+        public:
+            static constexpr int POLL_INTERVAL_MS = 50; ///< Only used where there are no notifications.
+
+            /**
+             * @param directories The folders to watch (not recursively).
+             * @throws std::runtime_error if a folder cannot be watched.
+             */
+            explicit FileWatcher(const std::vector<std::string>& directories);
+            ~FileWatcher();
+
+            FileWatcher(const FileWatcher&) = delete;
+            FileWatcher& operator=(const FileWatcher&) = delete;
+
+            /**
+             * @brief Blocks until at least one .jack file has changed.
+             *
+             * Every event already queued is taken too, so an editor's save (often a write, a rename
+             * and a delete) comes back as one batch.
+             *
+             * @return The paths that changed, sorted and without duplicates. A path that no longer
+             *         exists was deleted. If the system dropped events, every .jack file that exists
+             *         or existed is returned.
+             * @throws std::runtime_error if the notifications fail.
+             */
+            std::vector<std::string> waitForChanges();
+
+        private:
+            struct Directory; ///< One watched folder and its platform state.
+            std::vector<std::unique_ptr<Directory>> directories;
+            int inotifyFd = -1; ///< Linux: the inotify instance behind every folder's watch.
+
+            /**
+             * @brief After lost events: adds every .jack file each folder has now or had before to 'out'.
+             */
+            void rescan(std::vector<std::string>& out);
+    };
+}
+
+#endif //NAND2TETRIS_FILE_WATCHER_H
@@ -10,6 +10,9 @@
 #include <thread>
 #include <functional>
 #include <cstdlib>
+#include <map>
+#include <set>
+#include <algorithm>
 
 
 
@@ -19,6 +22,19 @@
 #include "SemanticAnalyser/GlobalRegistry.h"
 #include "SemanticAnalyser/SemanticAnalyser.h"
 #include "CodeGenerator/CodeGenerator.h"
+#include "ThreadPool/ThreadPool.h"
+#include "BuildCache/BuildCache.h"
+#include "Trace/Trace.h"
+#include "HackBackend/HackTranslator.h"
+#include "HackBackend/HackAssembler.h"
+#include "Optimizer/TreeShaker.h"
+#include "Optimizer/StringPool.h"
+#include "Optimizer/Inliner.h"
+#include "Watch/FileWatcher.h"
+#include "Discovery/DirectoryWalker.h"
+#include "Diagnostics/Diagnostics.h"
+#include "Viz/AstExport.h"
+#include "Stats/Stats.h"
 
 
 #ifdef _WIN32
@@ -64,52 +80,301 @@ double getPeakMemoryMB() {
 }
 
 // This struct holds the entire lifecycle state of a single .jack file.
-// It keeps the Tokenizer (source string owner), AST, and SymbolTable alive.
+// It keeps the Tokenizer (source string owner), AST arena, and SymbolTable alive
+// (with --low-memory, only while the unit is being compiled).
 struct CompilationUnit {
 	std::string filePath;
 	std::unique_ptr<Tokenizer> tokenizer;
-	std::unique_ptr<ClassNode> ast;
+	std::unique_ptr<AstArena> arena; // Owns every node reachable from 'ast'.
+	ClassNode* ast = nullptr;
 	std::shared_ptr<SymbolTable> symbolTable;
+	std::uint64_t sourceHash = 0;       // Only computed with --incremental.
+	const CacheEntry* cached = nullptr; // Set when the file was not parsed because its cache entry matched.
+	AsmUnit assembly;                   // With --asm/--hack: the class, translated, waiting to be linked.
+	std::unique_ptr<DiagnosticSink> diagnostics; // Where its errors are collected (not with --watch: they are thrown).
+	bool deferred = false;              // --low-memory: registered, then released; parsed again to be compiled.
+	std::string astDump;                // --viz-ast: its AST, written by the worker that analysed it.
+	std::string symbolsDump;            // --viz-checker: its symbol table, likewise.
+};
+
+// The visualization dumps the workers write (--viz-ast / --viz-checker).
+struct VizDumps {
+	bool ast = false;
+	bool symbols = false;
+};
+
+// --low-memory: drops the source, tokens, AST and symbol table of a unit.
+// The registry interns its own copy of every name, so nothing outside the unit points into them.
+void releaseUnit(CompilationUnit& unit) {
+	unit.ast = nullptr;
+	unit.arena.reset();
+	unit.tokenizer.reset();
+	unit.symbolTable.reset();
+}
+
+// Builds the AST from a loaded Tokenizer and registers the class and its methods.
+// With a sink, a unit with syntax errors comes back without an AST (its errors are in the sink).
+CompilationUnit parseTokens(const std::string& filePath, std::unique_ptr<Tokenizer> tokenizer, GlobalRegistry* registry,
+							std::unique_ptr<DiagnosticSink> diagnostics = nullptr) {
+	const std::string fileName = fs::path(filePath).filename().string();
+	auto arena = std::make_unique<AstArena>();
+	const auto symbolTable = std::make_shared<SymbolTable>();
+	Parser parser(*tokenizer, *registry, *arena, diagnostics.get());
+	ClassNode* ast = nullptr;
+	{
+		TraceScope trace("parse", fileName);
+		try {
+			ast = parser.parse();
+		} catch (const CompilationStopped&) {
+			// Given up on; what was found is collected.
+		}
+		trace.setTokens(tokenizer->getTokenCount());
+		trace.setAstNodes(arena->getObjectCount());
+	}
+	if (diagnostics && diagnostics->hasErrors()) {
+		log("[Failed]    " + filePath);
+		ast = nullptr;
+	} else {
+		log("[Parsed]    " + filePath);
+	}
+	CompilationUnit unit{filePath, std::move(tokenizer), std::move(arena), ast, symbolTable};
+	unit.diagnostics = std::move(diagnostics);
+	return unit;
 };
 
 // Job 1: Parse
 // Reads the file, tokenizes it, and builds the AST.
 // Also registers the class and its methods into the GlobalRegistry.
-CompilationUnit parseJob(const std::string& filePath, GlobalRegistry* registry) {
-	auto tokenizer = std::make_unique<Tokenizer>(filePath);
-	const auto symbolTable = std::make_shared<SymbolTable>();
-	Parser parser(*tokenizer, *registry);
-	auto ast = parser.parse();
-	log("[Parsed]    " + filePath);
-	return {filePath, std::move(tokenizer), std::move(ast),symbolTable};
-};
+// With 'diagnostics', errors are collected there instead of thrown.
+CompilationUnit parseJob(const std::string& filePath, GlobalRegistry* registry, Diagnostics* diagnostics = nullptr) {
+	CompilationUnit failed;
+	failed.filePath = filePath;
+	if (diagnostics && diagnostics->limitReached()) return failed; // Not worth starting.
+
+	auto sink = diagnostics ? std::make_unique<DiagnosticSink>(*diagnostics, filePath) : nullptr;
+	std::unique_ptr<Tokenizer> tokenizer;
+	try {
+		// Loading the file and scanning the first token; the rest is tokenized on demand by the Parser.
+		TraceScope trace("tokenize", fs::path(filePath).filename().string());
+		tokenizer = std::make_unique<Tokenizer>(filePath, sink.get());
+		trace.setBytes(tokenizer->getSourceSize());
+	} catch (const CompilationStopped&) {
+		return failed;
+	}
+	return parseTokens(filePath, std::move(tokenizer), registry, std::move(sink));
+}
+
+// Job 1 (--watch): Parse a file whose contents have already been read (and hashed).
+// Resident units outlive many edits of their file, so they own a copy of it rather than a
+// mapping that the editor could truncate underneath them.
+CompilationUnit parseContentsJob(const std::string& filePath, std::string contents, GlobalRegistry* registry) {
+	auto tokenizer = std::make_unique<Tokenizer>(SourceBuffer::fromString(filePath, std::move(contents)));
+	return parseTokens(filePath, std::move(tokenizer), registry);
+}
+
+// Job 1 (incremental): Parse, or reuse the cache.
+// A file whose contents and .vm output match its cache entry is not parsed at all;
+// its signatures are registered straight from the manifest.
+CompilationUnit loadJob(const std::string& filePath, GlobalRegistry* registry, const BuildCache* cache,
+						Diagnostics* diagnostics) {
+	if (!cache) return parseJob(filePath, registry, diagnostics);
+
+	const std::uint64_t hash = BuildCache::hashBytes(SourceBuffer(filePath).view());
+	if (const CacheEntry* entry = cache->lookup(filePath, hash)) {
+		BuildCache::registerEntry(*entry, *registry);
+		CompilationUnit unit;
+		unit.filePath = filePath;
+		unit.sourceHash = hash;
+		unit.cached = entry;
+		return unit;
+	}
+
+	CompilationUnit unit = parseJob(filePath, registry, diagnostics);
+	unit.sourceHash = hash;
+	return unit;
+}
+
+// Parses a unit again whose signatures are already registered (from the manifest, or by the
+// parse phase of --low-memory), so the Parser registers into a throwaway registry instead.
+void reparseJob(CompilationUnit& unit, Diagnostics* diagnostics) {
+	GlobalRegistry scratch;
+	CompilationUnit reparsed = parseJob(unit.filePath, &scratch, diagnostics);
+	unit.tokenizer = std::move(reparsed.tokenizer);
+	unit.arena = std::move(reparsed.arena);
+	unit.ast = reparsed.ast;
+	unit.symbolTable = std::move(reparsed.symbolTable);
+	unit.diagnostics = std::move(reparsed.diagnostics);
+}
+
+// Helper to get a temporary file path.
+fs::path getTempPath(const std::string& filename) {
+	try {
+		return fs::temp_directory_path() / filename;
+	} catch (...) {
+		return fs::path(filename); // Fallback to local dir
+	}
+}
+
+// --viz-*: writes the unit's dumps as NDJSON next to each other in the temp folder, on the
+// worker that has just analysed it.
+void dumpForViz(CompilationUnit& unit, const VizDumps& viz) {
+	if (!viz.ast && !viz.symbols) return;
+	const fs::path source(unit.filePath);
+	TraceScope trace("viz dump", source.filename().string());
+	// Unique per file, so that same-named classes from different folders do not collide.
+	const std::string dumpName = source.stem().string() + "_" + std::to_string(std::hash<std::string>{}(unit.filePath));
+	if (viz.ast) {
+		unit.astDump = getTempPath(dumpName + ".ast.ndjson").string();
+		std::ofstream out(unit.astDump, std::ios::binary);
+		AstExport::writeNdjson(*unit.ast, source.filename().string(), out);
+	}
+	if (viz.symbols) {
+		unit.symbolsDump = getTempPath(dumpName + ".sym.ndjson").string();
+		std::ofstream out(unit.symbolsDump, std::ios::binary);
+		unit.symbolTable->dumpToNdjson(unit.ast->getClassName(), out);
+	}
+}
 
 // Job 2: Analyze
 // Performs semantic analysis (type checking, scope resolution) on the AST.
-void analyzeJob(const CompilationUnit& unit, const GlobalRegistry* registry) {
-	if (!unit.ast) return; // Skip if parse failed
-	SemanticAnalyser analyser(*registry);
-	analyser.analyseClass(*unit.ast,*unit.symbolTable);
+// Returns false if errors were collected in the unit's sink: it must not be compiled.
+bool analyzeJob(const CompilationUnit& unit, const GlobalRegistry* registry,
+				std::vector<RegistryDependency>* lookups = nullptr) {
+	if (!unit.ast) return false; // Skip if parse failed
+	TraceScope trace("analyse", fs::path(unit.filePath).filename().string());
+	trace.setAstNodes(unit.arena->getObjectCount());
+	SemanticAnalyser analyser(*registry, lookups, unit.diagnostics.get());
+	try {
+		analyser.analyseClass(*unit.ast,*unit.symbolTable);
+	} catch (const CompilationStopped&) {
+		// The build's error limit is reached.
+	}
+	if (unit.diagnostics && unit.diagnostics->hasErrors()) {
+		log("[Failed]    " + unit.filePath);
+		return false;
+	}
 	log("[Verified]  " + unit.filePath);
+	return true;
 }
 
 // Job 3: Compile
-// Generates VM code from the AST and writes it to a .vm file.
-void compileJob(const CompilationUnit& unit, const GlobalRegistry* registry) {
-	if (!unit.ast) return;
+// Generates VM code from the AST and writes it to a .vm file, or (with 'assembly') translates it
+// straight to Hack assembly without ever printing it.
+// The .vm file is only replaced if its contents change ('written' tells which it was).
+// Returns the number of VM commands the optimizer removed.
+std::size_t compileJob(const CompilationUnit& unit, const GlobalRegistry* registry, const CodeGenOptions& options,
+					   AsmUnit* assembly = nullptr, bool* written = nullptr) {
+	if (!unit.ast) return 0;
+
+	if (assembly) {
+		TraceScope trace("codegen", fs::path(unit.filePath).filename().string());
+		HackTranslator translator{std::string(nameOf(unit.ast->getClassSymbol()))};
+		CodeGenerator generator(*registry, translator,*unit.symbolTable, options);
+		generator.compileClass(*unit.ast);
+		*assembly = translator.take();
+		trace.setBytes(assembly->code.size());
+
+		log("[Translated] " + unit.filePath);
+		return generator.getInstructionsRemoved();
+	}
 
 	fs::path p(unit.filePath);
 	const fs::path outputPath = p.replace_extension(".vm");
 
-	std::ofstream out(outputPath);
-	if (!out) {
-		throw std::runtime_error("Could not open output file: " + outputPath.string());
+	TraceScope trace("codegen", fs::path(unit.filePath).filename().string());
+	UpdateFileSink out(outputPath.string());
+	CodeGenerator generator(*registry, out,*unit.symbolTable, options);
+	generator.compileClass(*unit.ast);
+	const bool replaced = out.commit();
+	if (written) *written = replaced;
+	trace.setBytes(generator.getBytesEmitted());
+
+	log((replaced ? "[Generated] " : "[Unchanged] ") + outputPath.string());
+	return generator.getInstructionsRemoved();
+}
+
+// Time a single unit spent in each post-registration stage.
+struct StageTimes {
+	double analyseMs = 0.0;
+	double codeGenMs = 0.0;
+	std::size_t commandsRemoved = 0; // By the -O1 peephole pass.
+	bool upToDate = false; // Skipped entirely by the build cache.
+	bool vmWritten = false;   // Its .vm file was replaced...
+	bool vmUnchanged = false; // ...or already had the generated code, and was left alone.
+};
+
+
+// Job 2+3: Analyze, then Compile, on the same worker.
+// Once the registry barrier has passed a unit depends on nothing but itself, so it can move
+// straight into code generation while its AST and symbol table are still hot in cache.
+// With 'lowMemory' the unit is released as soon as its output is written.
+StageTimes pipelineJob(CompilationUnit& unit, const GlobalRegistry* registry, BuildCache* cache,
+					   const CodeGenOptions& options, const bool toAssembly, Diagnostics* diagnostics,
+					   const bool lowMemory, const VizDumps& viz) {
+	StageTimes times;
+
+	if (unit.cached) {
+		TraceScope trace("cached", fs::path(unit.filePath).filename().string());
+		if (BuildCache::dependenciesUnchanged(*unit.cached, *registry)) {
+			cache->record(unit.filePath, *unit.cached);
+			log("[Cached]    " + unit.filePath);
+			times.upToDate = true;
+			return times;
+		}
+		// The source is unchanged but a signature it uses is not, so it must be re-checked and
+		// regenerated.
+		reparseJob(unit, diagnostics);
+	} else if (unit.deferred) {
+		reparseJob(unit, diagnostics);
 	}
 
-	CodeGenerator generator(*registry, out,*unit.symbolTable);
-	generator.compileClass(*unit.ast);
+	std::vector<RegistryDependency> lookups;
+	const auto start = std::chrono::high_resolution_clock::now();
+	if (diagnostics && diagnostics->limitReached()) return times;
+	const bool checked = analyzeJob(unit, registry, cache ? &lookups : nullptr);
+	const auto mid = std::chrono::high_resolution_clock::now();
+	if (!checked) return times;
+	dumpForViz(unit, viz);
+	bool written = false;
+	times.commandsRemoved = compileJob(unit, registry, options, toAssembly ? &unit.assembly : nullptr, &written);
+	if (!toAssembly) (written ? times.vmWritten : times.vmUnchanged) = true;
+	const auto end = std::chrono::high_resolution_clock::now();
+
+	if (cache && unit.ast) {
+		const std::string outputPath = fs::path(unit.filePath).replace_extension(".vm").string();
+		cache->record(unit.filePath, BuildCache::makeEntry(unit.sourceHash, unit.ast->getClassSymbol(), *registry,
+														   std::move(lookups), outputPath));
+	}
+	if (lowMemory) releaseUnit(unit); // The output is flushed; only unit.assembly is still needed.
+
+	times.analyseMs = std::chrono::duration<double, std::milli>(mid - start).count();
+	times.codeGenMs = std::chrono::duration<double, std::milli>(end - mid).count();
+	return times;
+}
 
-	log("[Generated] " + outputPath.string());
+// Job 2 (--tree-shake): Analyze, then collect the unit's calls for the whole-program call graph.
+// Code generation has to wait until every unit's calls are known.
+std::vector<SubroutineCalls> analyseForShakeJob(CompilationUnit& unit, const GlobalRegistry* registry,
+												const VizDumps& viz, StageTimes& times) {
+	const auto start = std::chrono::high_resolution_clock::now();
+	if (!analyzeJob(unit, registry)) return {}; // The build fails; the call graph is not needed.
+	dumpForViz(unit, viz);
+	TraceScope trace("call graph", fs::path(unit.filePath).filename().string());
+	std::vector<SubroutineCalls> calls = TreeShaker::collectCalls(*unit.ast, *unit.symbolTable, *registry);
+	times.analyseMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	return calls;
+}
+
+// Job 3 (--tree-shake): Compile the unit's reachable subroutines.
+StageTimes compileReachableJob(const CompilationUnit& unit, const GlobalRegistry* registry,
+							   const CodeGenOptions& options, AsmUnit* assembly) {
+	StageTimes times;
+	const auto start = std::chrono::high_resolution_clock::now();
+	bool written = false;
+	times.commandsRemoved = compileJob(unit, registry, options, assembly, &written);
+	if (!assembly && unit.ast) (written ? times.vmWritten : times.vmUnchanged) = true;
+	times.codeGenMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	return times;
 }
 
 // Validates that the Main class has a static void main() function.
@@ -117,7 +382,7 @@ void compileJob(const CompilationUnit& unit, const GlobalRegistry* registry) {
 void validateMainEntry(const GlobalRegistry& registry) {
 	try {
 		// 1. Fetch the signature from the registry
-		const auto sig = registry.getSignature("Main", "main");
+		const auto& sig = registry.getSignature(intern("Main"), intern("main"));
 
 		// 2. Check: Must be Static (Function)
 		if (!sig.isStatic) {
@@ -125,7 +390,7 @@ void validateMainEntry(const GlobalRegistry& registry) {
 		}
 
 		// 3. Check: Must return Void
-		if (sig.returnType != "void") {
+		if (sig.returnType != sym::VOID) {
 			throw std::runtime_error("Error: 'Main.main' must have a 'void' return type.");
 		}
 
@@ -135,6 +400,252 @@ void validateMainEntry(const GlobalRegistry& registry) {
 	}
 }
 
+// Waits for every task, then rethrows the first failure: a task may still be using the caller's
+// locals (the registry), so none may be abandoned.
+template <typename T>
+std::vector<T> getAll(std::vector<std::future<T>>& tasks) {
+	std::vector<T> results;
+	results.reserve(tasks.size());
+	std::exception_ptr failure;
+	for (auto& t : tasks) {
+		try {
+			results.push_back(t.get());
+		} catch (...) {
+			if (!failure) failure = std::current_exception();
+		}
+	}
+	if (failure) std::rethrow_exception(failure);
+	return results;
+}
+
+void waitAll(std::vector<std::future<void>>& tasks) {
+	std::exception_ptr failure;
+	for (auto& t : tasks) {
+		try {
+			t.get();
+		} catch (...) {
+			if (!failure) failure = std::current_exception();
+		}
+	}
+	if (failure) std::rethrow_exception(failure);
+}
+
+// A class kept resident by --watch. Its AST survives between rebuilds; the rest says whether it
+// must be rebuilt. What the cache entry holds as text is also kept interned, since every rebuild
+// re-registers each class and re-checks each lookup.
+struct WatchedFile {
+	CompilationUnit unit;
+	CacheEntry entry; // Source hash and the state of the .vm file it wrote.
+	std::vector<std::pair<SymbolId, MethodSignature>> exports;          // The class's signatures.
+	std::vector<std::pair<RegistryDependency, std::uint64_t>> lookups; // What analysis looked up, and its hash.
+};
+
+// What one --watch rebuild did.
+struct WatchRound {
+	std::size_t parsed = 0;    // Files whose contents changed.
+	std::size_t rechecked = 0; // Unchanged files re-analysed: a signature they use changed, or their .vm did.
+	std::size_t removed = 0;   // Files that were deleted.
+};
+
+// The .vm file compileJob writes for a source.
+std::string outputPathOf(const std::string& sourcePath) {
+	return fs::path(sourcePath).replace_extension(".vm").string();
+}
+
+// Job 2+3 (--watch): Analyze and compile a unit, and describe it for the next rebuild.
+// Fills everything in 'file' but the unit.
+void watchCompileJob(CompilationUnit& unit, const std::uint64_t sourceHash, const GlobalRegistry* registry,
+					 const CodeGenOptions& options, WatchedFile& file) {
+	std::vector<RegistryDependency> lookups;
+	analyzeJob(unit, registry, &lookups);
+	compileJob(unit, registry, options);
+
+	const SymbolId className = unit.ast->getClassSymbol();
+	file.entry = BuildCache::makeEntry(sourceHash, className, *registry, std::move(lookups), outputPathOf(unit.filePath));
+	file.exports.clear();
+	for (const SymbolId name : registry->getMethodNames(className)) {
+		file.exports.emplace_back(name, registry->getSignature(className, name));
+	}
+	file.lookups.clear();
+	for (const CachedDependency& d : file.entry.dependencies) {
+		file.lookups.push_back({{intern(d.className), intern(d.methodName)}, d.hash});
+	}
+}
+
+// Registers a resident class, as parsing it would.
+void registerWatched(const WatchedFile& file, GlobalRegistry& registry) {
+	const SymbolId className = file.unit.ast->getClassSymbol();
+	if (!registry.registerClass(className)) {
+		throw std::runtime_error("Duplicate class definition: Class '" + file.entry.className + "' is already defined.");
+	}
+	for (const auto& [name, signature] : file.exports) registry.registerMethod(className, name, signature);
+}
+
+// True if every lookup a resident class made still hashes the same.
+bool lookupsUnchanged(const WatchedFile& file, const GlobalRegistry& registry) {
+	return std::all_of(file.lookups.begin(), file.lookups.end(), [&registry](const auto& lookup) {
+		const RegistryDependency& d = lookup.first;
+		return BuildCache::dependencyHash(registry, d.className, d.methodName) == lookup.second;
+	});
+}
+
+// One --watch rebuild after the files in 'changed' were written or deleted (on the first, every file).
+// Only changed files are parsed, and only the classes whose lookups now see different signatures are
+// re-checked; every other class is registered from memory and left alone. 'files' is only updated
+// once the whole rebuild has succeeded, so a failed one can simply be retried. It may have rewritten
+// .vm files, though, so the retry runs with 'checkOutputs' and also rebuilds classes whose output changed.
+WatchRound rebuildWatched(std::map<std::string, WatchedFile>& files, const std::vector<std::string>& changed,
+						  const bool checkOutputs, const GlobalRegistry& standardLibrary, ThreadPool& pool,
+						  const CodeGenOptions& options) {
+	WatchRound round;
+	GlobalRegistry registry(standardLibrary); // The OS signatures, without registering them again.
+
+	// 1. Read what changed. A save that did not change the bytes is not a change.
+	std::set<std::string> stale;        // Resident files replaced or removed by this rebuild.
+	std::vector<std::string> paths;     // The files to parse...
+	std::vector<std::string> contents;  // ...their bytes...
+	std::vector<std::uint64_t> hashes;  // ...and hashes.
+	for (const std::string& path : changed) {
+		const auto resident = files.find(path);
+		std::error_code ec;
+		if (!fs::exists(path, ec)) {
+			if (resident != files.end()) {
+				stale.insert(path);
+				++round.removed;
+			}
+			continue;
+		}
+		std::string bytes(SourceBuffer(path).view());
+		const std::uint64_t hash = BuildCache::hashBytes(bytes);
+		if (resident != files.end() && resident->second.entry.sourceHash == hash &&
+			(!checkOutputs || BuildCache::outputUnchanged(resident->second.entry, outputPathOf(path)))) {
+			continue;
+		}
+		if (resident != files.end()) stale.insert(path);
+		paths.push_back(path);
+		contents.push_back(std::move(bytes));
+		hashes.push_back(hash);
+	}
+
+	// 2. Register: the unchanged classes from their entries, the changed ones by parsing them.
+	for (const auto& [path, file] : files) {
+		if (!stale.count(path)) registerWatched(file, registry);
+	}
+	std::vector<std::future<CompilationUnit>> parseTasks;
+	parseTasks.reserve(paths.size());
+	for (std::size_t i = 0; i < paths.size(); ++i) {
+		parseTasks.push_back(pool.submit([&paths, &contents, &registry, i] {
+			return parseContentsJob(paths[i], std::move(contents[i]), &registry);
+		}));
+	}
+	std::vector<CompilationUnit> parsed = getAll(parseTasks);
+	registry.freeze();
+	validateMainEntry(registry);
+
+	// 3. Compile the changed classes and the resident ones a changed signature affects.
+	std::vector<CompilationUnit*> targets;
+	std::vector<std::uint64_t> targetHashes;
+	for (std::size_t i = 0; i < parsed.size(); ++i) {
+		targets.push_back(&parsed[i]);
+		targetHashes.push_back(hashes[i]);
+	}
+	for (auto& [path, file] : files) {
+		if (stale.count(path) || (lookupsUnchanged(file, registry) &&
+								  (!checkOutputs || BuildCache::outputUnchanged(file.entry, outputPathOf(path))))) {
+			continue;
+		}
+		file.unit.symbolTable = std::make_shared<SymbolTable>(); // The AST is reused; its scopes are rebuilt.
+		targets.push_back(&file.unit);
+		targetHashes.push_back(file.entry.sourceHash);
+		++round.rechecked;
+	}
+	std::vector<WatchedFile> results(targets.size()); // All but the units, which are moved in below.
+	std::vector<std::future<void>> compileTasks;
+	compileTasks.reserve(targets.size());
+	for (std::size_t i = 0; i < targets.size(); ++i) {
+		compileTasks.push_back(pool.submit([&targets, &targetHashes, &registry, &options, &results, i] {
+			watchCompileJob(*targets[i], targetHashes[i], &registry, options, results[i]);
+		}));
+	}
+	waitAll(compileTasks);
+
+	// 4. Commit.
+	for (const std::string& path : stale) files.erase(path);
+	for (std::size_t i = 0; i < targets.size(); ++i) {
+		WatchedFile& file = files[i < parsed.size() ? paths[i] : targets[i]->filePath];
+		if (i < parsed.size()) file.unit = std::move(parsed[i]);
+		file.entry = std::move(results[i].entry);
+		file.exports = std::move(results[i].exports);
+		file.lookups = std::move(results[i].lookups);
+	}
+	round.parsed = parsed.size();
+	return round;
+}
+
+// --watch: build once, then rebuild whatever each batch of saved files affects, until interrupted.
+// The units, the pre-warmed registry and the worker threads stay resident between rebuilds.
+int runWatch(const std::vector<std::string>& userFiles, const std::vector<std::string>& userDirs,
+			 const CodeGenOptions& options, const std::size_t jobs) {
+	// Paths are compared as text, so every one is spelled the same way as the watcher's.
+	const auto normal = [](const std::string& path) { return fs::absolute(path).lexically_normal().string(); };
+
+	std::set<std::string> explicitFiles; // Given one by one: only these count, not their neighbours.
+	std::set<std::string> watchedFolders;
+	std::set<std::string> projectFolders;
+	for (const std::string& dir : userDirs) {
+		fs::path path = normal(dir);
+		if (!path.has_filename()) path = path.parent_path(); // "proj/" -> "proj"
+		projectFolders.insert(path.string());
+	}
+	for (const std::string& file : userFiles) {
+		const fs::path path = normal(file);
+		watchedFolders.insert(path.parent_path().string());
+		if (!projectFolders.count(path.parent_path().string())) explicitFiles.insert(path.string());
+	}
+	watchedFolders.insert(projectFolders.begin(), projectFolders.end());
+	const auto belongs = [&](const std::string& path) {
+		return explicitFiles.count(path) || projectFolders.count(fs::path(path).parent_path().string());
+	};
+
+	const GlobalRegistry standardLibrary; // Every rebuild starts from a copy.
+	std::map<std::string, WatchedFile> files;
+	// Declared after 'files' so that it is destroyed (and joined) first.
+	ThreadPool pool(jobs);
+	FileWatcher watcher({watchedFolders.begin(), watchedFolders.end()});
+
+	std::vector<std::string> pending; // Changes not yet built successfully; retried with the next ones.
+	bool failed = false;
+	for (const std::string& file : userFiles) pending.push_back(normal(file));
+	while (true) {
+		const auto start = std::chrono::high_resolution_clock::now();
+		try {
+			const WatchRound round = rebuildWatched(files, pending, failed, standardLibrary, pool, options);
+			pending.clear();
+			failed = false;
+			const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			log("[Watch]     Rebuilt in " + std::to_string(ms) + " ms: " + std::to_string(round.parsed) + " parsed, "
+				+ std::to_string(round.rechecked) + " re-checked, " + std::to_string(round.removed) + " removed ("
+				+ std::to_string(files.size()) + " classes resident)");
+		} catch (const std::exception& e) {
+			failed = true;
+			std::scoped_lock lock(consoleMutex);
+			std::cerr << "\n COMPILATION FAILED" << std::endl;
+			std::cerr << e.what() << std::endl;
+		}
+		log("[Watch]     Waiting for changes (Ctrl+C to stop)...");
+
+		for (bool relevant = false; !relevant;) {
+			for (const std::string& path : watcher.waitForChanges()) {
+				if (!belongs(path)) continue;
+				pending.push_back(path);
+				relevant = true;
+			}
+		}
+		std::sort(pending.begin(), pending.end());
+		pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+	}
+}
+
 // Helper to find the 'tools' directory for visualization scripts.
 std::string getToolsDir() {
 	fs::path homeDir;
@@ -157,46 +668,39 @@ std::string getToolsDir() {
 	return "";
 }
 
-// Helper to get a temporary file path.
-fs::path getTempPath(const std::string& filename) {
-	try {
-		return fs::temp_directory_path() / filename;
-	} catch (...) {
-		return fs::path(filename); // Fallback to local dir
-	}
+// Removes the dumps the workers wrote when there is no tool to show them.
+void removeDumps(const std::vector<std::string>& paths) {
+	std::error_code ec;
+	for (const auto& p : paths) fs::remove(p, ec);
 }
 
 // Launches the unified visualization dashboard (Registry + Symbol Tables).
+// The symbol tables were dumped by the workers (see dumpForViz); only the registry is left.
 void runUnifiedViz(const GlobalRegistry& registry, const std::vector<CompilationUnit>& units) {
-	// 1. Dump Registry to Temp
-	std::string regPath = getTempPath("jack_unified_reg.json").string();
-	registry.dumpToJSON(regPath);
-
-	// 2. Dump Symbol Tables for all files
 	std::vector<std::string> symPaths;
 	for (const auto& unit : units) {
-		if (!unit.symbolTable) continue;
-
-		// Create a unique filename for each symbol table
-		size_t h = std::hash<std::string>{}(unit.filePath);
-		std::string name = fs::path(unit.filePath).stem().string();
-		std::string path = "/tmp/jack_sym_" + name + "_" + std::to_string(h) + ".json";
-
-		unit.symbolTable->dumpToJSON(name, path);
-		symPaths.push_back(path);
+		if (!unit.symbolsDump.empty()) symPaths.push_back(unit.symbolsDump);
 	}
 
-	// 3. Locate the Python Script
+	// 1. Locate the Python Script
 	std::string toolsDir = getToolsDir();
 	if (toolsDir.empty()) {
 		std::cerr << "Error: 'tools' folder not found. Cannot launch visualization." << std::endl;
+		removeDumps(symPaths);
 		return;
 	}
 
 	fs::path script = fs::path(toolsDir) / "unified_viz.py";
 	std::string absScriptPath = fs::absolute(script).string();
 
-	// 4. Construct Command
+	// 2. Dump Registry to Temp
+	std::string regPath = getTempPath("jack_unified_reg.ndjson").string();
+	{
+		std::ofstream out(regPath, std::ios::binary);
+		registry.dumpToNdjson(out);
+	}
+
+	// 3. Construct Command
 	std::string cmd;
 	#ifdef _WIN32
 		cmd = "python \"" + absScriptPath + "\" --registry \"" + regPath + "\"";
@@ -209,50 +713,37 @@ void runUnifiedViz(const GlobalRegistry& registry, const std::vector<Compilation
 		for (const auto& p : symPaths) cmd += " \"" + p + "\"";
 	}
 
-	// 5. Run (Blocks until you close the dashboard)
+	// 4. Run (Blocks until you close the dashboard)
 	std::system(cmd.c_str());
 
-	// 6. Cleanup Temp Files
-	if (fs::exists(regPath)) fs::remove(regPath);
-	for (const auto& p : symPaths) if (fs::exists(p)) fs::remove(p);
+	// 5. Cleanup Temp Files
+	symPaths.push_back(regPath);
+	removeDumps(symPaths);
 }
 
 // Launches the AST visualization tool for all compiled units.
+// The ASTs were dumped by the workers (see dumpForViz).
 void runBatchAstViz(const std::vector<CompilationUnit>& units) {
+	std::vector<std::string> tempFiles;
+	std::string pyArgs = "";
+	for (const auto& unit : units) {
+		if (unit.astDump.empty()) continue;
+		tempFiles.push_back(unit.astDump);
+		pyArgs += " \"" + unit.astDump + "\"";
+	}
+	if (tempFiles.empty()) return;
+
 	std::string toolsDir = getToolsDir();
 	if (toolsDir.empty()) {
 		std::cerr << "Error: 'tools' folder not found." << std::endl;
+		removeDumps(tempFiles);
 		return;
 	}
 
 	fs::path scriptPath = fs::path(toolsDir) / "jack_viz.py";
 	std::string absScriptPath = fs::absolute(scriptPath).string();
 
-	std::vector<std::string> tempFiles;
-	std::string pyArgs = "";
-
-	// 1. Generate ALL XML files
-	for (const auto& unit : units) {
-		if (!unit.ast) continue;
-
-		// Create unique filename
-		size_t pathHash = std::hash<std::string>{}(unit.filePath);
-		std::string niceName = fs::path(unit.filePath).stem().string();
-		std::string xmlFilename = niceName + "_" + std::to_string(pathHash) + ".xml";
-
-		fs::path xmlPath = getTempPath(xmlFilename);
-
-		std::ofstream xmlFile(xmlPath);
-		unit.ast->printXml(xmlFile, 0);
-		xmlFile.close();
-
-		tempFiles.push_back(xmlPath.string());
-
-		pyArgs += " \"" + xmlPath.string() + "\"";
-	}
-	if (tempFiles.empty()) return;
-
-	// 2. Build the command
+	// Build the command
 	std::string cmd;
 	#ifdef _WIN32
 		// Windows: start /b (background)
@@ -272,7 +763,7 @@ int main(int argc, char* argv[]) {
 	std::ios_base::sync_with_stdio(false);
 
 	if (argc < 2) {
-		std::cerr << "Usage: JackCompiler <file.jack or directory>" << std::endl;
+		std::cerr << "Usage: JackCompiler <file.jack or directory> [-j N] [-O0|-O1] [--[no-]strength-reduce] [--incremental] [--asm] [--hack] [--tree-shake] [--string-pool] [--inline] [--inline-budget N] [--watch] [--recursive] [--low-memory] [--trace out.json] [--max-errors N] [--error-format text|json|sarif] [--stats]" << std::endl;
 		return 1;
 	}
 
@@ -280,9 +771,28 @@ int main(int argc, char* argv[]) {
 		const auto startTotal = std::chrono::high_resolution_clock::now();
 
 		std::vector<std::string> userFiles;
+		std::vector<std::string> userDirs; // The folders among them (watched for new classes with --watch).
+		std::vector<std::string> inputs;   // The paths as given, expanded once every flag is known.
 
 		bool vizAst = false;
 		bool vizSymbols = false;
+		bool incremental = false;
+		bool emitAsm = false;  // One linked <project>.asm instead of .vm files.
+		bool emitHack = false; // ...and/or its machine code, <project>.hack.
+		bool treeShake = false;
+		bool stringPooling = false;
+		int inlineBudget = 0; // > 0: --inline, with this many AST nodes per inlined body at most.
+		int strengthReduce = -1; // --strength-reduce (1) / --no-strength-reduce (0); -1 = on at -O1 only
+		bool watch = false;
+		bool recursive = false; // Walk the folders' subfolders too, in parallel with parsing.
+		bool lowMemory = false; // Hold a unit's AST only while it is registered, and again while it is compiled.
+		std::string tracePath; // Empty = tracing off
+		bool stats = false; // Print the hot-path counters (a JACK_ENABLE_STATS build only).
+		std::size_t maxErrors = 20; // 0 = report every error
+		DiagnosticFormat errorFormat = DiagnosticFormat::TEXT;
+		bool explicitErrorOptions = false; // --watch reports the first error of each rebuild as it always did.
+		std::size_t jobs = 0; // 0 = one worker per hardware thread
+		CodeGenOptions codeGenOptions;
 		// Iterate through ALL command line arguments
 		for (int i = 1; i < argc; ++i) {
 			std::string arg = argv[i];
@@ -294,8 +804,127 @@ int main(int argc, char* argv[]) {
 				vizSymbols = true;
 				continue;
 			}
+			if (arg == "-O0" || arg == "-O1") {
+				codeGenOptions.optimizationLevel = arg[2] - '0';
+				continue;
+			}
+			if (arg == "--strength-reduce" || arg == "--no-strength-reduce") {
+				strengthReduce = arg == "--strength-reduce" ? 1 : 0;
+				continue;
+			}
+			if (arg == "--incremental") {
+				incremental = true;
+				continue;
+			}
+			if (arg == "--asm") {
+				emitAsm = true;
+				continue;
+			}
+			if (arg == "--hack") {
+				emitHack = true;
+				continue;
+			}
+			if (arg == "--tree-shake") {
+				treeShake = true;
+				continue;
+			}
+			if (arg == "--string-pool") {
+				stringPooling = true;
+				continue;
+			}
+			if (arg == "--inline") {
+				if (inlineBudget == 0) inlineBudget = Inliner::DEFAULT_BUDGET;
+				continue;
+			}
+			if (arg == "--inline-budget") {
+				char* end = nullptr;
+				const long n = i + 1 < argc ? std::strtol(argv[i + 1], &end, 10) : 0;
+				if (n <= 0 || *end != '\0') {
+					std::cerr << "Error: --inline-budget requires a positive node count." << std::endl;
+					return 1;
+				}
+				inlineBudget = static_cast<int>(n);
+				++i;
+				continue;
+			}
+			if (arg == "--watch") {
+				watch = true;
+				continue;
+			}
+			if (arg == "--low-memory") {
+				lowMemory = true;
+				continue;
+			}
+			if (arg == "--recursive") {
+				recursive = true;
+				continue;
+			}
+			if (arg == "--stats") {
+				if (!Stats::ENABLED) {
+					std::cerr << "Error: --stats needs a compiler built with -DJACK_ENABLE_STATS=ON." << std::endl;
+					return 1;
+				}
+				stats = true;
+				continue;
+			}
+			if (arg == "--max-errors") {
+				char* end = nullptr;
+				const long n = i + 1 < argc ? std::strtol(argv[i + 1], &end, 10) : -1;
+				if (n < 0 || *end != '\0') {
+					std::cerr << "Error: --max-errors requires an error count (0 = no limit)." << std::endl;
+					return 1;
+				}
+				maxErrors = static_cast<std::size_t>(n);
+				explicitErrorOptions = true;
+				++i;
+				continue;
+			}
+			if (arg == "--error-format") {
+				const std::string format = i + 1 < argc ? argv[i + 1] : "";
+				if (format == "text") errorFormat = DiagnosticFormat::TEXT;
+				else if (format == "json") errorFormat = DiagnosticFormat::JSON;
+				else if (format == "sarif") errorFormat = DiagnosticFormat::SARIF;
+				else {
+					std::cerr << "Error: --error-format requires text, json or sarif." << std::endl;
+					return 1;
+				}
+				explicitErrorOptions = true;
+				++i;
+				continue;
+			}
+			if (arg == "--trace") {
+				if (i + 1 >= argc) {
+					std::cerr << "Error: --trace requires an output file." << std::endl;
+					return 1;
+				}
+				tracePath = argv[++i];
+				continue;
+			}
+			if (arg.rfind("-j", 0) == 0) {
+				// Accept both "-j 8" and "-j8"
+				std::string count = arg.substr(2);
+				if (count.empty()) {
+					if (i + 1 >= argc) {
+						std::cerr << "Error: -j requires a thread count." << std::endl;
+						return 1;
+					}
+					count = argv[++i];
+				}
+				char* end = nullptr;
+				const long n = std::strtol(count.c_str(), &end, 10);
+				if (end == count.c_str() || *end != '\0' || n <= 0) {
+					std::cerr << "Error: Invalid thread count for -j: '" << count << "'" << std::endl;
+					return 1;
+				}
+				jobs = static_cast<std::size_t>(n);
+				continue;
+			}
 
-			fs::path inputPathArg = arg;
+			inputs.push_back(arg);
+		}
+
+		for (const auto& input : inputs) {
+			fs::path inputPathArg = input;
 
 			if (!fs::exists(inputPathArg)) {
 				std::cerr << "Error: Path does not exist: " << inputPathArg << std::endl;
@@ -303,6 +932,8 @@ int main(int argc, char* argv[]) {
 			}
 
 			if (fs::is_directory(inputPathArg)) {
+				userDirs.push_back(inputPathArg.string());
+				if (recursive) continue; // Listed by the DirectoryWalker, during the parse phase.
 				bool foundAny = false;
 				// Iterate over files in the directory
 				for (const auto& entry : fs::directory_iterator(inputPathArg)) {
@@ -324,89 +955,399 @@ int main(int argc, char* argv[]) {
 			}
 		}
 
-		if (userFiles.empty()) {
-			std::cerr << "No files provided." << std::endl;
+		const bool toAssembly = emitAsm || emitHack;
+		codeGenOptions.strengthReduction = strengthReduce < 0 ? codeGenOptions.optimizationLevel > 0 : strengthReduce == 1;
+
+		if (incremental && toAssembly) {
+			// The cache tracks per-class .vm outputs; a linked program has to be rebuilt whole.
+			std::cerr << "Error: --incremental cannot be combined with --asm or --hack." << std::endl;
 			return 1;
 		}
-
-		// Check for Main.jack
-		bool hasMain = false;
-		for (const auto& file : userFiles) {
-			if (fs::path(file).filename() == "Main.jack") {
-				hasMain = true;
-				break;
-			}
+		if (incremental && treeShake) {
+			// What a class keeps depends on every other class, which per-file cache entries cannot express.
+			std::cerr << "Error: --incremental cannot be combined with --tree-shake." << std::endl;
+			return 1;
+		}
+		if (incremental && stringPooling) {
+			// The pool numbers the literals of the whole program, so any change can renumber them all.
+			std::cerr << "Error: --incremental cannot be combined with --string-pool." << std::endl;
+			return 1;
+		}
+		if (incremental && inlineBudget > 0) {
+			// An inlined body makes the caller depend on the callee's code, not just its signature.
+			std::cerr << "Error: --incremental cannot be combined with --inline." << std::endl;
+			return 1;
 		}
 
-		if (!hasMain) {
+		// With --recursive the files are only known once the parse phase has found them all.
+		const auto findMain = [](const auto& files, const auto& pathOf) {
+			for (const auto& file : files) {
+				if (fs::path(pathOf(file)).filename() == "Main.jack") return fs::path(pathOf(file));
+			}
+			return fs::path();
+		};
+		const auto missingMain = [] {
 			std::cerr << "\nError: Compilation Failed." << std::endl;
 			std::cerr << "Reason: Missing 'Main.jack'" << std::endl;
 			std::cerr << "The list of files to compile must include the Main class." << std::endl;
 			return 1;
+		};
+
+		fs::path mainFile;
+		if (!recursive) {
+			if (userFiles.empty()) {
+				std::cerr << "No files provided." << std::endl;
+				return 1;
+			}
+			mainFile = findMain(userFiles, [](const std::string& file) -> const std::string& { return file; });
+			if (mainFile.empty()) return missingMain();
+		}
+
+		if (watch) {
+			// The session keeps its own per-class state in memory and rebuilds .vm files only.
+			if (incremental || toAssembly || treeShake || stringPooling || inlineBudget > 0 || recursive || !tracePath.empty() || vizAst || vizSymbols
+				|| explicitErrorOptions || lowMemory || stats) {
+				std::cerr << "Error: --watch can only be combined with -j, -O0/-O1 and --[no-]strength-reduce." << std::endl;
+				return 1;
+			}
+			return runWatch(userFiles, userDirs, codeGenOptions, jobs);
 		}
 
 
+		// The registry may hold views into the cache's entries, so the cache is declared first.
+		std::unique_ptr<BuildCache> cache;
+		if (incremental) {
+			// One manifest per project, next to Main.jack (the outputs sit beside their sources).
+			// --recursive: Main.jack is not found yet, so it goes in the first folder given.
+			const fs::path projectDir = !recursive ? mainFile.parent_path()
+								 : !userDirs.empty() ? fs::absolute(userDirs.front()) : fs::path(userFiles.front()).parent_path();
+			const fs::path manifestPath = projectDir / BuildCache::MANIFEST_NAME;
+			// Outputs built at another optimization level are stale. Strength reduction only adds to
+			// the key when it is not the level's default, so existing caches stay valid.
+			std::string configKey = codeGenOptions.optimizationLevel > 0 ? "O1" : "default";
+			if (codeGenOptions.strengthReduction != (codeGenOptions.optimizationLevel > 0)) {
+				configKey += codeGenOptions.strengthReduction ? "+sr" : "-sr";
+			}
+			cache = std::make_unique<BuildCache>(manifestPath.string(), configKey);
+			cache->load();
+		}
+
 		GlobalRegistry registry;
+		std::vector<CompilationUnit> units;
+
+		// Installed before any worker runs; the pool below is joined before the recorder goes away.
+		std::unique_ptr<TraceRecorder> tracer;
+		if (!tracePath.empty()) {
+			tracer = std::make_unique<TraceRecorder>();
+			TraceRecorder::install(tracer.get());
+			tracer->nameThisThread("main");
+		}
+		struct TraceUninstall {
+			~TraceUninstall() { TraceRecorder::install(nullptr); }
+		} traceUninstall;
+
+		// Declared after the registry and units so that it is destroyed (and joined) first:
+		// if a phase throws, in-flight jobs may still be touching both.
+		ThreadPool pool(jobs);
+
+		// Every unit reports its errors here and the build goes on; they are printed together at the end of a phase.
+		Diagnostics diagnostics(maxErrors);
+		const auto reportFailure = [&diagnostics, errorFormat] {
+			if (errorFormat == DiagnosticFormat::TEXT) std::cerr << "\n COMPILATION FAILED" << std::endl;
+			diagnostics.write(std::cerr, errorFormat); // stdout has the progress log
+			return 1;
+		};
+
+		// The whole-program passes read every AST at once.
+		if (lowMemory && (treeShake || stringPooling || inlineBudget > 0)) {
+			std::cerr << "Error: --low-memory cannot be combined with --tree-shake, --string-pool or --inline." << std::endl;
+			return 1;
+		}
 
 		// --- PHASE 1: PARSING ---
 		const auto startParse = std::chrono::high_resolution_clock::now();
+		auto parsePhaseTrace = std::make_unique<TraceScope>("parse phase", "");
 		std::vector<std::future<CompilationUnit>> parseTasks;
 
+		// With --low-memory the units are released as soon as they are registered, so the parse
+		// phase holds one unit per worker instead of the whole project.
+		const auto parseUnit = [&registry, &cache, &diagnostics, lowMemory](const std::string& path) {
+			CompilationUnit unit = loadJob(path, &registry, cache.get(), &diagnostics);
+			if (lowMemory && unit.ast) {
+				releaseUnit(unit);
+				unit.deferred = true;
+			}
+			return unit;
+		};
 		parseTasks.reserve(userFiles.size());
 		for (const auto& f : userFiles) {
-			parseTasks.push_back(std::async(std::launch::async, parseJob, f, &registry));
+			parseTasks.push_back(pool.submit([&f, &parseUnit] { return parseUnit(f); }));
+		}
+		if (recursive) {
+			// Each file is queued for parsing as soon as its folder listing reaches it.
+			std::mutex parseTasksMtx;
+			DirectoryWalker walker(pool, [&parseTasks, &parseTasksMtx, &pool, &parseUnit](std::string path) {
+				auto task = pool.submit([path = std::move(path), &parseUnit] { return parseUnit(path); });
+				std::lock_guard<std::mutex> lock(parseTasksMtx);
+				parseTasks.push_back(std::move(task));
+			});
+			for (const auto& dir : userDirs) walker.walk(dir);
+			walker.wait();
 		}
 
-		std::vector<CompilationUnit> units;
 		for (auto& t : parseTasks) {
 			auto unit = t.get();
-			if (unit.ast) units.push_back(std::move(unit));
+			if (unit.ast || unit.cached || unit.deferred) units.push_back(std::move(unit));
 		}
+		if (recursive) {
+			// Found in whatever order the folders were listed: sort for reproducible output.
+			std::sort(units.begin(), units.end(), [](const CompilationUnit& a, const CompilationUnit& b) {
+				return a.filePath < b.filePath;
+			});
+			if (parseTasks.empty()) {
+				std::cerr << "No files provided." << std::endl;
+				return 1;
+			}
+			mainFile = findMain(units, [](const CompilationUnit& unit) -> const std::string& { return unit.filePath; });
+			if (mainFile.empty()) return missingMain();
+		}
+		// Every class is registered: switch the registry to its lock-free, read-only form.
+		registry.freeze();
+		parsePhaseTrace.reset();
 		const auto endParse = std::chrono::high_resolution_clock::now();
+		const double parsePeakMB = getPeakMemoryMB(); // Where the peak is unless --low-memory
+
+		if (diagnostics.size() > 0) {
+			// Nothing is generated, but the classes that did parse are still checked: one build, every error.
+			std::vector<std::future<bool>> analyseTasks;
+			analyseTasks.reserve(units.size());
+			for (auto& unit : units) {
+				analyseTasks.push_back(pool.submit([&unit, &registry, &diagnostics] {
+					if (unit.deferred) reparseJob(unit, &diagnostics);
+					const bool checked = analyzeJob(unit, &registry);
+					releaseUnit(unit);
+					return checked;
+				}));
+			}
+			for (auto& t : analyseTasks) t.get();
+			return reportFailure();
+		}
 
 		// Validate Entry Point
 		validateMainEntry(registry);
 
-
-		// --- PHASE 2: SEMANTIC ANALYSIS ---
-		const auto startAnalyze = std::chrono::high_resolution_clock::now();
-		std::vector<std::future<void>> analysisTasks;
-
-		analysisTasks.reserve(units.size());
-		for (const auto& unit : units) {
-			analysisTasks.push_back(std::async(std::launch::async, analyzeJob, std::ref(unit), &registry));
+		// --- PHASE 2: SEMANTIC ANALYSIS + CODE GENERATION (pipelined) ---
+		// Registration above is the only global barrier: every signature is known now,
+		// so each unit flows through analysis and codegen independently (unless --tree-shake
+		// needs the whole call graph first).
+		const auto startPipeline = std::chrono::high_resolution_clock::now();
+		auto pipelinePhaseTrace = std::make_unique<TraceScope>("analyse + codegen phase", "");
+		StageTimes stageTotals;
+		std::size_t upToDate = 0;
+		std::size_t outputsWritten = 0;
+		std::size_t outputsUnchanged = 0; // Generated byte for byte as they were, so not touched.
+		const auto countOutput = [&outputsWritten, &outputsUnchanged](const bool written) {
+			++(written ? outputsWritten : outputsUnchanged);
+		};
+		const auto addTimes = [&stageTotals, &upToDate, &countOutput](const StageTimes& times) {
+			stageTotals.analyseMs += times.analyseMs;
+			stageTotals.codeGenMs += times.codeGenMs;
+			stageTotals.commandsRemoved += times.commandsRemoved;
+			if (times.upToDate) ++upToDate;
+			if (times.vmWritten || times.vmUnchanged) countOutput(times.vmWritten);
+		};
+
+		std::unordered_set<SymbolId> reachable; // --tree-shake: the subroutines that are compiled.
+		std::size_t subroutineCount = 0;
+		StringPool stringPool;
+		Inliner inliner(inlineBudget);
+		VizDumps viz;
+		viz.ast = vizAst;
+		viz.symbols = vizSymbols;
+		// The whole-program tables have to see every class before any class is compiled.
+		const auto prepareCodeGen = [&] {
+			if (stringPooling) {
+				TraceScope trace("string pool", "");
+				if (registry.classExists(intern(StringPool::CLASS_NAME))) {
+					throw std::runtime_error("Error: --string-pool generates the class 'StringPool', which the program already defines.");
+				}
+				for (const auto& unit : units) {
+					stringPool.addClass(*unit.ast, registry, codeGenOptions.reachable);
+				}
+				stringPool.finish();
+				codeGenOptions.stringPool = &stringPool;
+			}
+			if (inlineBudget > 0) {
+				TraceScope trace("inline candidates", "");
+				for (const auto& unit : units) inliner.addClass(*unit.ast, registry);
+				codeGenOptions.inliner = &inliner;
+			}
+		};
+		if (treeShake) {
+			// Whole-program: analysis, then the call graph, then only the reachable code.
+			std::vector<StageTimes> times(units.size());
+			std::vector<std::future<std::vector<SubroutineCalls>>> analyseTasks;
+			analyseTasks.reserve(units.size());
+			for (std::size_t i = 0; i < units.size(); ++i) {
+				analyseTasks.push_back(pool.submit([&units, &times, &registry, &viz, i] {
+					return analyseForShakeJob(units[i], &registry, viz, times[i]);
+				}));
+			}
+			TreeShaker shaker;
+			for (auto& t : analyseTasks) shaker.addClass(t.get());
+			if (diagnostics.size() > 0) return reportFailure();
+
+			// Sys.init is the real entry point when the OS is compiled along (the bootstrap calls it).
+			reachable = shaker.reachableFrom({intern("Main.main"), intern("Sys.init")});
+			subroutineCount = shaker.size();
+			codeGenOptions.reachable = &reachable;
+			prepareCodeGen();
+
+			std::vector<std::future<StageTimes>> compileTasks;
+			compileTasks.reserve(units.size());
+			for (auto& unit : units) {
+				compileTasks.push_back(pool.submit([&unit, &registry, &codeGenOptions, toAssembly] {
+					return compileReachableJob(unit, &registry, codeGenOptions, toAssembly ? &unit.assembly : nullptr);
+				}));
+			}
+			for (const StageTimes& t : times) addTimes(t);
+			for (auto& t : compileTasks) addTimes(t.get());
+		} else {
+			prepareCodeGen();
+			std::vector<std::future<StageTimes>> pipelineTasks;
+			pipelineTasks.reserve(units.size());
+			for (auto& unit : units) {
+				pipelineTasks.push_back(pool.submit([&unit, &registry, &cache, &codeGenOptions, toAssembly, &diagnostics, lowMemory, &viz] {
+					return pipelineJob(unit, &registry, cache.get(), codeGenOptions, toAssembly, &diagnostics, lowMemory, viz);
+				}));
+			}
+			for (auto& t : pipelineTasks) addTimes(t.get());
+			// The cache is not saved, so the classes that did compile are rebuilt next time as well.
+			if (diagnostics.size() > 0) return reportFailure();
 		}
 
-		for (auto& t : analysisTasks) {
-			t.get();
+		// The pool is one more class, next to Main.jack like the others' .vm files.
+		AsmUnit stringPoolAssembly;
+		if (stringPooling && stringPool.size() > 0) {
+			TraceScope trace("codegen", std::string(StringPool::CLASS_NAME) + ".vm");
+			const std::string className(StringPool::CLASS_NAME);
+			if (toAssembly) {
+				HackTranslator translator{className};
+				VMWriter writer(translator);
+				stringPool.compile(writer);
+				stringPoolAssembly = translator.take();
+			} else {
+				const std::string outputPath = (mainFile.parent_path() / (className + ".vm")).string();
+				UpdateFileSink out(outputPath);
+				{
+					VMWriter writer(out);
+					stringPool.compile(writer);
+				}
+				const bool written = out.commit();
+				countOutput(written);
+				log((written ? "[Generated] " : "[Unchanged] ") + outputPath);
+			}
 		}
-		const auto endAnalyze = std::chrono::high_resolution_clock::now();
-
-		// --- PHASE 3: CODE GENERATION ---
-		const auto startCodeGen = std::chrono::high_resolution_clock::now();
-		std::vector<std::future<void>> compileTasks;
-
-		compileTasks.reserve(units.size());
-		for (auto& unit : units) {
-			compileTasks.push_back(std::async(std::launch::async, compileJob, std::ref(unit), &registry));
+		pipelinePhaseTrace.reset();
+		const auto endPipeline = std::chrono::high_resolution_clock::now();
+
+		// --- PHASE 3: LINK (--asm / --hack) ---
+		// The classes were translated in parallel above; joining them behind the bootstrap is cheap.
+		fs::path programPath;
+		std::size_t romWords = 0;
+		if (toAssembly) {
+			TraceScope trace("link", "");
+			std::vector<AsmUnit> assemblies;
+			assemblies.reserve(units.size());
+			for (auto& unit : units) assemblies.push_back(std::move(unit.assembly));
+			if (!stringPoolAssembly.code.empty()) assemblies.push_back(std::move(stringPoolAssembly));
+			const std::string program = HackTranslator::link(std::move(assemblies));
+			romWords = HackAssembler::countInstructions(program);
+
+			// Named after the project folder, as the course's VM translator does.
+			const fs::path projectDir = mainFile.parent_path();
+			programPath = projectDir / projectDir.filename();
+			if (emitAsm) {
+				UpdateFileSink out(programPath.string() + ".asm");
+				out.write(program);
+				const bool written = out.commit();
+				countOutput(written);
+				log((written ? "[Linked]    " : "[Unchanged] ") + programPath.string() + ".asm");
+			}
+			if (emitHack) {
+				TraceScope assembleTrace("assemble", "");
+				const std::string machineCode = HackAssembler::assemble(program);
+				UpdateFileSink out(programPath.string() + ".hack");
+				out.write(machineCode);
+				const bool written = out.commit();
+				countOutput(written);
+				log((written ? "[Assembled] " : "[Unchanged] ") + programPath.string() + ".hack");
+			}
+			trace.setBytes(program.size());
 		}
 
-		for (auto& t : compileTasks) {
-			t.get();
-		}
-		const auto endCodeGen = std::chrono::high_resolution_clock::now();
+		// Only a fully successful build updates the manifest.
+		if (cache) cache->save();
+
+		// Every task has finished (all futures are ready), so the workers' buffers are complete.
+		if (tracer) tracer->writeJson(tracePath);
 		const auto endTotal = std::chrono::high_resolution_clock::now();
 
 		// --- REPORT ---
 		std::cout << "\n========================================" << std::endl;
 		std::cout << " BUILD SUCCESSFUL" << std::endl;
 		std::cout << "========================================" << std::endl;
-		std::cout << " Files Compiled: " << units.size() << std::endl;
+		std::cout << " Files Compiled: " << units.size() - upToDate << std::endl;
+		if (incremental) {
+			std::cout << " Up to date:     " << upToDate << " (reused from " << BuildCache::MANIFEST_NAME << ")" << std::endl;
+		}
+		std::cout << " Outputs Written: " << outputsWritten << " of " << outputsWritten + outputsUnchanged
+				  << " (" << outputsUnchanged << " unchanged, left untouched)" << std::endl;
 		std::cout << " Parsing:        " << std::chrono::duration<double, std::milli>(endParse - startParse).count() << " ms" << std::endl;
-		std::cout << " Static Analysis:" << std::chrono::duration<double, std::milli>(endAnalyze - startAnalyze).count() << " ms" << std::endl;
-		std::cout << " Code Gen:       " << std::chrono::duration<double, std::milli>(endCodeGen - startCodeGen).count() << " ms" << std::endl;
+		std::cout << " Analysis + Gen: " << std::chrono::duration<double, std::milli>(endPipeline - startPipeline).count() << " ms" << std::endl;
+		std::cout << "   Static Analysis:" << stageTotals.analyseMs << " ms (summed over workers)" << std::endl;
+		std::cout << "   Code Gen:       " << stageTotals.codeGenMs << " ms (summed over workers)" << std::endl;
+		if (codeGenOptions.optimizationLevel > 0) {
+			std::cout << " Optimized (-O1): " << stageTotals.commandsRemoved << " VM commands removed by the peephole pass" << std::endl;
+		}
+		if (toAssembly) {
+			std::cout << " Hack Program:   " << programPath.filename().string() << (emitAsm ? ".asm" : ".hack")
+					  << " (" << romWords << " ROM words)" << std::endl;
+		}
+		if (inlineBudget > 0) {
+			// The report: what was expanded where, most call sites first.
+			const auto inlined = inliner.report();
+			std::size_t sites = 0;
+			for (const auto& [name, count] : inlined) sites += count;
+			std::cout << " Inlining:       " << sites << " call sites of " << inlined.size() << " subroutines ("
+					  << inliner.size() << " candidates, budget " << inliner.getBudget() << " nodes)" << std::endl;
+			constexpr std::size_t REPORT_LINES = 10;
+			for (std::size_t r = 0; r < inlined.size() && r < REPORT_LINES; ++r) {
+				std::cout << "   " << nameOf(inlined[r].first) << ": " << inlined[r].second << (inlined[r].second == 1 ? " site" : " sites") << std::endl;
+			}
+			if (inlined.size() > REPORT_LINES) {
+				std::cout << "   (" << inlined.size() - REPORT_LINES << " more)" << std::endl;
+			}
+		}
+		if (stringPooling) {
+			std::cout << " String Pool:    " << stringPool.size() << " distinct literals for "
+					  << stringPool.uses() << " uses, in StringPool" << (toAssembly ? "" : ".vm") << std::endl;
+		}
+		if (treeShake) {
+			std::cout << " Tree Shaking:   " << reachable.size() << " of " << subroutineCount
+					  << " subroutines reachable from Main.main (" << subroutineCount - reachable.size() << " removed)" << std::endl;
+		}
 		std::cout << " Total Time:     " << std::chrono::duration<double, std::milli>(endTotal - startTotal).count() << " ms" << std::endl;
-		std::cout << " Peak Memory:    " << getPeakMemoryMB() << " MB" << std::endl;
+		std::cout << " Peak Memory:    " << getPeakMemoryMB() << " MB (" << parsePeakMB << " MB by the end of parsing"
+				  << (lowMemory ? ", units released after registration and codegen" : "") << ")" << std::endl;
+		std::cout << " Workers:        " << pool.size() << std::endl;
+		const auto workerStats = pool.getStats();
+		for (std::size_t w = 0; w < workerStats.size(); ++w) {
+			std::cout << "   #" << w << ": " << workerStats[w].tasksRun << " tasks ("
+					  << workerStats[w].tasksStolen << " stolen), "
+					  << workerStats[w].busyMs << " ms busy" << std::endl;
+		}
+		if (stats) Stats::write(std::cout); // The workers are idle: every task has finished.
 		std::cout << "========================================" << std::endl;
 
 		// --- VISUALIZATION ---
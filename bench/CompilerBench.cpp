@@ -0,0 +1,535 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+// Whole-compiler benchmark: runs each phase in isolation and reports per-phase latency,
+// throughput and allocations, as text and as JSON for regression checks between releases.
+//
+// Usage: jack_bench [options] [<file.jack or directory>...]
+//   -n N                 Timed iterations per phase (default 20, after one warm-up run).
+//   -O0 | -O1            Optimization level of the code generator (default -O0).
+//   --classes N          Synthetic project: number of classes (default 50) ...
+//   --methods N          ... methods per class (default 10) ...
+//   --statements N       ... statements per method (default 40) ...
+//   --depth N            ... nesting depth of the long expressions (default 16) ...
+//   --string-length N    ... length of each string literal (default 64).
+//   --emit <dir>         Also write the synthetic project to <dir> (e.g. to time the CLI on it).
+//   --json <file>        Write the results as JSON ("-" for stdout).
+//   --baseline <file>    Compare with an earlier --json result and exit with 2 if the median of
+//   --tolerance P        any phase is more than P percent slower (default 10).
+// Without inputs the synthetic project is benchmarked; with inputs, those .jack files are.
+//
+// Phases (each timed alone, over all classes):
+//   tokenizer     scanning every token.
+//   parser        building the ASTs (including the scan the Parser drives; subtract 'tokenizer'
+//                 for the parse alone).
+//   semantic      SemanticAnalyser over the parsed classes.
+//   codegen       CodeGenerator into the VM IR (with the -O1 passes when enabled).
+//   vmwriter      printing the IR as .vm text.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../Compiler/CodeGenerator/CodeGenerator.h"
+#include "../Compiler/Parser/AstArena.h"
+#include "../Compiler/Parser/Parser.h"
+#include "../Compiler/SemanticAnalyser/SemanticAnalyser.h"
+#include "../Compiler/SemanticAnalyser/SymbolTable.h"
+#include "../Compiler/Tokenizer/Tokenizer.h"
+#include "../Compiler/VMWriter/VMCode.h"
+
+using namespace nand2tetris::jack;
+namespace fs = std::filesystem;
+
+// ---- Allocation counting -------------------------------------------------------------------
+// Every global allocation in the process goes through these, the compiler's included.
+
+namespace {
+	std::atomic<std::size_t> allocationCount{0};
+	std::atomic<std::size_t> allocatedBytes{0};
+
+	void* countedAlloc(const std::size_t size) {
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+		throw std::bad_alloc();
+	}
+}
+
+void* operator new(const std::size_t size) { return countedAlloc(size); }
+void* operator new[](const std::size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+	// ---- Synthetic projects ----------------------------------------------------------------
+
+	struct Shape {
+		int classes = 50;
+		int methods = 10;
+		int statements = 40;
+		int depth = 16;
+		int stringLength = 64;
+	};
+
+	struct Source {
+		std::string name;
+		std::string text;
+	};
+
+	std::string className(const int i) { return "C" + std::to_string(i); }
+
+	/// A nested arithmetic expression over the method's locals, 'depth' parentheses deep.
+	std::string deepExpression(const int depth, const int seed) {
+		static const char* const OPERANDS[] = {"x", "y", "t", "i", "a", "b", "3", "17"};
+		static const char* const OPS[] = {" + ", " - ", " * ", " / "};
+		std::string expr = "x";
+		for (int d = 0; d < depth; ++d) {
+			const int k = seed + d;
+			expr = std::string(k % 7 == 0 ? "-(" : "(") + OPERANDS[k % 8] + OPS[k % 4] + expr + ")";
+		}
+		return expr;
+	}
+
+	std::string stringLiteral(const int length, const int seed) {
+		std::string s;
+		s.reserve(static_cast<std::size_t>(length));
+		for (int i = 0; i < length; ++i) s += static_cast<char>('a' + (seed + i) % 26);
+		return s;
+	}
+
+	std::string generateClass(const Shape& shape, const int index) {
+		const std::string self = className(index);
+		const std::string next = className((index + 1) % shape.classes);
+		std::ostringstream out;
+		out << "class " << self << " {\n"
+			<< "    field int a, b;\n"
+			<< "    static int s;\n\n"
+			<< "    constructor " << self << " new(int x) {\n"
+			<< "        let a = x;\n"
+			<< "        let b = x + 1;\n"
+			<< "        return this;\n"
+			<< "    }\n\n"
+			<< "    function int f(int x) {\n"
+			<< "        let s = s + x;\n"
+			<< "        return s;\n"
+			<< "    }\n";
+
+		for (int m = 0; m < shape.methods; ++m) {
+			out << "\n    method int m" << m << "(int x, int y) {\n"
+				<< "        var int i, t;\n"
+				<< "        var String str;\n"
+				<< "        var Array arr;\n"
+				<< "        let i = 0;\n"
+				<< "        let t = x;\n"
+				<< "        let arr = Array.new(16);\n";
+			for (int st = 0; st < shape.statements; ++st) {
+				const int seed = index * 31 + m * 7 + st;
+				switch (st % 7) {
+					case 0:
+						out << "        let t = " << deepExpression(shape.depth, seed) << ";\n";
+						break;
+					case 1:
+						out << "        while (i < 10) {\n"
+							<< "            let t = t + (i * x);\n"
+							<< "            let i = i + 1;\n"
+							<< "        }\n";
+						break;
+					case 2:
+						out << "        if (t > y) {\n"
+							<< "            let t = t - y;\n"
+							<< "        } else {\n"
+							<< "            let t = y - t;\n"
+							<< "        }\n";
+						break;
+					case 3:
+						out << "        let str = \"" << stringLiteral(shape.stringLength, seed) << "\";\n"
+							<< "        do str.dispose();\n";
+						break;
+					case 4:
+						out << "        let arr[i] = " << next << ".f(t);\n";
+						break;
+					case 5:
+						out << "        do Output.printInt(t);\n";
+						break;
+					default:
+						out << "        let b = b + a;\n";
+						break;
+				}
+			}
+			out << "        do arr.dispose();\n"
+				<< "        return t;\n"
+				<< "    }\n";
+		}
+		out << "}\n";
+		return out.str();
+	}
+
+	std::vector<Source> generateProject(const Shape& shape) {
+		std::vector<Source> sources;
+		sources.reserve(static_cast<std::size_t>(shape.classes) + 1);
+		for (int i = 0; i < shape.classes; ++i) {
+			sources.push_back({className(i) + ".jack", generateClass(shape, i)});
+		}
+		std::string main = "class Main {\n"
+						   "    function void main() {\n"
+						   "        var C0 c;\n"
+						   "        let c = C0.new(1);\n";
+		if (shape.methods > 0) main += "        do c.m0(1, 2);\n";
+		main += "        return;\n"
+				"    }\n"
+				"}\n";
+		sources.push_back({"Main.jack", main});
+		return sources;
+	}
+
+	std::vector<Source> readProject(const std::vector<std::string>& inputs) {
+		std::vector<std::string> files;
+		for (const auto& input : inputs) {
+			if (fs::is_directory(input)) {
+				for (const auto& entry : fs::directory_iterator(input)) {
+					if (entry.path().extension() == ".jack") files.push_back(entry.path().string());
+				}
+			} else {
+				files.push_back(input);
+			}
+		}
+		std::sort(files.begin(), files.end());
+
+		std::vector<Source> sources;
+		for (const auto& f : files) {
+			std::ifstream in(f, std::ios::binary);
+			if (!in) throw std::runtime_error("Cannot read " + f);
+			std::ostringstream text;
+			text << in.rdbuf();
+			sources.push_back({fs::path(f).filename().string(), text.str()});
+		}
+		return sources;
+	}
+
+	// ---- Phases ----------------------------------------------------------------------------
+
+	/// Everything one class needs from parsing until its code is printed.
+	struct Unit {
+		std::unique_ptr<Tokenizer> tokenizer;
+		std::unique_ptr<AstArena> arena;
+		ClassNode* ast = nullptr;
+		SymbolTable symbolTable;
+		VMCode code;
+	};
+
+	/// Keeps the IR of one class (setup) or just counts the rows (timed runs).
+	class CaptureSink final : public VMCodeSink {
+		public:
+			explicit CaptureSink(VMCode* target) : target(target) {}
+			void write(const VMCode& code) override {
+				rows += code.size();
+				if (target) *target = code;
+			}
+			std::size_t rows = 0;
+		private:
+			VMCode* target;
+	};
+
+	struct PhaseResult {
+		std::string name;
+		std::vector<double> samples; ///< Milliseconds, one per iteration.
+		std::size_t allocations = 0; ///< Per iteration.
+		std::size_t bytes = 0;       ///< Per iteration.
+
+		double percentile(const double p) const {
+			const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(samples.size())));
+			return samples[std::min(samples.size() - 1, rank == 0 ? 0 : rank - 1)];
+		}
+		double median() const { return samples[samples.size() / 2]; }
+	};
+
+	/**
+	 * @brief Runs 'setup' and then times 'body', once to warm up and then 'iterations' times.
+	 *
+	 * Only 'body' is timed and counted; whatever it needs that is not part of the phase
+	 * (fresh source copies, an empty registry...) is made by 'setup'.
+	 */
+	template <typename Setup, typename Body>
+	PhaseResult measure(const std::string& name, const int iterations, Setup setup, Body body) {
+		PhaseResult result;
+		result.name = name;
+		result.samples.reserve(static_cast<std::size_t>(iterations));
+		for (int it = -1; it < iterations; ++it) {
+			auto state = setup();
+			const std::size_t allocsBefore = allocationCount.load(std::memory_order_relaxed);
+			const std::size_t bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+			const auto start = std::chrono::steady_clock::now();
+			body(state);
+			const auto end = std::chrono::steady_clock::now();
+			result.allocations = allocationCount.load(std::memory_order_relaxed) - allocsBefore;
+			result.bytes = allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+			if (it >= 0) result.samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+		}
+		std::sort(result.samples.begin(), result.samples.end());
+		return result;
+	}
+
+	std::vector<SourceBuffer> buffersOf(const std::vector<Source>& sources) {
+		std::vector<SourceBuffer> buffers;
+		buffers.reserve(sources.size());
+		for (const auto& s : sources) buffers.push_back(SourceBuffer::fromString(s.name, s.text));
+		return buffers;
+	}
+
+	/// Every source parsed into its own unit, with its classes registered in 'registry'.
+	std::vector<Unit> parseAll(const std::vector<Source>& sources, GlobalRegistry& registry) {
+		std::vector<Unit> units(sources.size());
+		for (std::size_t i = 0; i < sources.size(); ++i) {
+			units[i].tokenizer = std::make_unique<Tokenizer>(SourceBuffer::fromString(sources[i].name, sources[i].text));
+			units[i].arena = std::make_unique<AstArena>();
+			Parser parser(*units[i].tokenizer, registry, *units[i].arena);
+			units[i].ast = parser.parse();
+		}
+		return units;
+	}
+
+	// ---- Baseline comparison ---------------------------------------------------------------
+
+	/// The "median_ms" of phase 'name' in an earlier --json result, or a negative value.
+	double baselineMedian(const std::string& json, const std::string& name) {
+		const std::size_t at = json.find("\"name\": \"" + name + "\"");
+		if (at == std::string::npos) return -1;
+		const std::string key = "\"median_ms\": ";
+		const std::size_t value = json.find(key, at);
+		if (value == std::string::npos) return -1;
+		return std::strtod(json.c_str() + value + key.size(), nullptr);
+	}
+
+	std::string jsonNumber(const double value) {
+		char text[32];
+		std::snprintf(text, sizeof(text), "%.6g", value);
+		return text;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	int iterations = 20;
+	int optimizationLevel = 0;
+	double tolerance = 10.0;
+	Shape shape;
+	std::string emitDir, jsonPath, baselinePath;
+	std::vector<std::string> inputs;
+
+	const auto intArg = [&](int& i, const int minimum) {
+		if (i + 1 >= argc) {
+			std::cerr << "Missing value after " << argv[i] << std::endl;
+			std::exit(1);
+		}
+		return std::max(minimum, std::atoi(argv[++i]));
+	};
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		if (arg == "-n") iterations = intArg(i, 1);
+		else if (arg == "-O0" || arg == "-O1") optimizationLevel = arg[2] - '0';
+		else if (arg == "--classes") shape.classes = intArg(i, 1);
+		else if (arg == "--methods") shape.methods = intArg(i, 0);
+		else if (arg == "--statements") shape.statements = intArg(i, 0);
+		else if (arg == "--depth") shape.depth = intArg(i, 0);
+		else if (arg == "--string-length") shape.stringLength = intArg(i, 0);
+		else if (arg == "--tolerance") tolerance = intArg(i, 0);
+		else if ((arg == "--emit" || arg == "--json" || arg == "--baseline") && i + 1 < argc) {
+			(arg == "--emit" ? emitDir : arg == "--json" ? jsonPath : baselinePath) = argv[++i];
+		} else if (!arg.empty() && arg[0] == '-') {
+			std::cerr << "Usage: jack_bench [-n N] [-O0|-O1] [--classes N] [--methods N] [--statements N] [--depth N]"
+						 " [--string-length N] [--emit dir] [--json file] [--baseline file] [--tolerance P]"
+						 " [<file.jack or directory>...]" << std::endl;
+			return 1;
+		} else {
+			inputs.push_back(arg);
+		}
+	}
+
+	std::vector<PhaseResult> results;
+	std::vector<Source> sources;
+	std::size_t totalBytes = 0, totalLines = 0, totalTokens = 0;
+	CodeGenOptions options;
+	options.optimizationLevel = optimizationLevel;
+
+	try {
+		sources = inputs.empty() ? generateProject(shape) : readProject(inputs);
+		if (sources.empty()) throw std::runtime_error("No .jack files found.");
+		if (!emitDir.empty()) {
+			fs::create_directories(emitDir);
+			for (const auto& s : sources) std::ofstream(fs::path(emitDir) / s.name, std::ios::binary) << s.text;
+		}
+		for (const auto& s : sources) {
+			totalBytes += s.text.size();
+			totalLines += static_cast<std::size_t>(std::count(s.text.begin(), s.text.end(), '\n'));
+		}
+
+		const GlobalRegistry standardLibrary;
+
+		results.push_back(measure("tokenizer", iterations,
+			[&] { return buffersOf(sources); },
+			[&](std::vector<SourceBuffer>& buffers) {
+				std::size_t tokens = 0;
+				for (auto& buffer : buffers) {
+					Tokenizer tokenizer(std::move(buffer));
+					while (tokenizer.hasMoreTokens()) {
+						++tokens;
+						tokenizer.advance();
+					}
+				}
+				totalTokens = tokens;
+			}));
+
+		struct ParseState {
+			std::unique_ptr<GlobalRegistry> registry;
+			std::vector<Unit> units;
+		};
+		results.push_back(measure("parser", iterations,
+			[&] {
+				ParseState state{std::make_unique<GlobalRegistry>(standardLibrary), std::vector<Unit>(sources.size())};
+				for (std::size_t i = 0; i < sources.size(); ++i) {
+					state.units[i].tokenizer = std::make_unique<Tokenizer>(SourceBuffer::fromString(sources[i].name, sources[i].text));
+					state.units[i].arena = std::make_unique<AstArena>();
+				}
+				return state;
+			},
+			[&](ParseState& state) {
+				for (Unit& unit : state.units) {
+					Parser parser(*unit.tokenizer, *state.registry, *unit.arena);
+					unit.ast = parser.parse();
+				}
+			}));
+
+		// The later phases share one parsed, frozen program.
+		GlobalRegistry registry(standardLibrary);
+		std::vector<Unit> units = parseAll(sources, registry);
+		registry.freeze();
+
+		results.push_back(measure("semantic", iterations,
+			[&] { return std::vector<SymbolTable>(units.size()); },
+			[&](std::vector<SymbolTable>& tables) {
+				for (std::size_t i = 0; i < units.size(); ++i) {
+					SemanticAnalyser analyser(registry);
+					analyser.analyseClass(*units[i].ast, tables[i]);
+				}
+			}));
+
+		for (Unit& unit : units) {
+			SemanticAnalyser analyser(registry);
+			analyser.analyseClass(*unit.ast, unit.symbolTable);
+			CaptureSink sink(&unit.code);
+			CodeGenerator generator(registry, sink, unit.symbolTable, options);
+			generator.compileClass(*unit.ast);
+		}
+
+		results.push_back(measure("codegen", iterations,
+			[] { return CaptureSink(nullptr); },
+			[&](CaptureSink& sink) {
+				for (Unit& unit : units) {
+					CodeGenerator generator(registry, sink, unit.symbolTable, options);
+					generator.compileClass(*unit.ast);
+				}
+			}));
+
+		results.push_back(measure("vmwriter", iterations,
+			[] { return std::string(); },
+			[&](std::string& text) {
+				for (const Unit& unit : units) {
+					text.clear();
+					unit.code.print(text);
+				}
+			}));
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	const bool synthetic = inputs.empty();
+	std::cout << "Workload:   " << (synthetic ? "synthetic" : "files") << ", " << sources.size() << " classes, "
+			  << totalLines << " lines, " << totalTokens << " tokens, " << totalBytes << " bytes" << std::endl;
+	std::cout << "Iterations: " << iterations << ", -O" << optimizationLevel << std::endl << std::endl;
+	std::printf("%-10s %10s %10s %14s %14s %10s %12s\n",
+				"phase", "median ms", "p99 ms", "lines/sec", "tokens/sec", "allocs", "alloc bytes");
+	for (const auto& r : results) {
+		const double seconds = r.median() / 1000.0;
+		std::printf("%-10s %10.3f %10.3f %14.0f %14.0f %10zu %12zu\n", r.name.c_str(), r.median(), r.percentile(0.99),
+					static_cast<double>(totalLines) / seconds, static_cast<double>(totalTokens) / seconds,
+					r.allocations, r.bytes);
+	}
+
+	if (!jsonPath.empty()) {
+		std::ostringstream json;
+		json << "{\n"
+			 << "  \"schema\": 1,\n"
+			 << "  \"workload\": {\"source\": \"" << (synthetic ? "synthetic" : "files") << "\"";
+		if (synthetic) {
+			json << ", \"classes\": " << shape.classes << ", \"methods\": " << shape.methods
+				 << ", \"statements\": " << shape.statements << ", \"depth\": " << shape.depth
+				 << ", \"string_length\": " << shape.stringLength;
+		}
+		json << ", \"files\": " << sources.size() << ", \"lines\": " << totalLines << ", \"tokens\": " << totalTokens
+			 << ", \"bytes\": " << totalBytes << "},\n"
+			 << "  \"iterations\": " << iterations << ",\n"
+			 << "  \"optimization_level\": " << optimizationLevel << ",\n"
+			 << "  \"phases\": [\n";
+		for (std::size_t i = 0; i < results.size(); ++i) {
+			const auto& r = results[i];
+			const double seconds = r.median() / 1000.0;
+			json << "    {\"name\": \"" << r.name << "\", \"median_ms\": " << jsonNumber(r.median())
+				 << ", \"p99_ms\": " << jsonNumber(r.percentile(0.99))
+				 << ", \"min_ms\": " << jsonNumber(r.samples.front())
+				 << ", \"max_ms\": " << jsonNumber(r.samples.back())
+				 << ", \"lines_per_sec\": " << jsonNumber(static_cast<double>(totalLines) / seconds)
+				 << ", \"tokens_per_sec\": " << jsonNumber(static_cast<double>(totalTokens) / seconds)
+				 << ", \"allocations\": " << r.allocations << ", \"allocated_bytes\": " << r.bytes << "}"
+				 << (i + 1 < results.size() ? ",\n" : "\n");
+		}
+		json << "  ]\n}\n";
+		if (jsonPath == "-") {
+			std::cout << json.str();
+		} else if (!(std::ofstream(jsonPath, std::ios::binary) << json.str())) {
+			std::cerr << "Cannot write " << jsonPath << std::endl;
+			return 1;
+		}
+	}
+
+	if (!baselinePath.empty()) {
+		std::ifstream in(baselinePath, std::ios::binary);
+		if (!in) {
+			std::cerr << "Cannot read " << baselinePath << std::endl;
+			return 1;
+		}
+		std::ostringstream text;
+		text << in.rdbuf();
+		bool regressed = false;
+		std::cout << std::endl << "Against " << baselinePath << " (tolerance " << tolerance << "%):" << std::endl;
+		for (const auto& r : results) {
+			const double before = baselineMedian(text.str(), r.name);
+			if (before <= 0) {
+				std::printf("%-10s no baseline\n", r.name.c_str());
+				continue;
+			}
+			const double change = (r.median() - before) / before * 100.0;
+			const bool slower = change > tolerance;
+			regressed |= slower;
+			std::printf("%-10s %10.3f -> %10.3f ms  %+7.1f%%%s\n", r.name.c_str(), before, r.median(), change,
+						slower ? "  REGRESSION" : "");
+		}
+		if (regressed) return 2;
+	}
+	return 0;
+}
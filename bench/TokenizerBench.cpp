@@ -0,0 +1,86 @@
+//
+// Created by Nithin Kondabathini on 14/10/2026.
+//
+
+// Tokenizer microbenchmark.
+// Usage: tokenizer_bench [-n iterations] <file.jack or directory>...
+// Tokenizes every input file 'iterations' times and reports tokens/sec and MB/sec.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../Compiler/Tokenizer/Tokenizer.h"
+#include "../Compiler/Tokenizer/SimdScan.h"
+
+using namespace nand2tetris::jack;
+namespace fs = std::filesystem;
+
+int main(int argc, char* argv[]) {
+	int iterations = 50;
+	std::vector<std::string> files;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		if (arg == "-n" && i + 1 < argc) {
+			iterations = std::max(1, std::atoi(argv[++i]));
+			continue;
+		}
+		if (fs::is_directory(arg)) {
+			for (const auto& entry : fs::directory_iterator(arg)) {
+				if (entry.path().extension() == ".jack") files.push_back(entry.path().string());
+			}
+		} else {
+			files.push_back(arg);
+		}
+	}
+
+	if (files.empty()) {
+		std::cerr << "Usage: tokenizer_bench [-n iterations] <file.jack or directory>..." << std::endl;
+		return 1;
+	}
+	std::sort(files.begin(), files.end());
+
+	std::size_t totalBytes = 0;
+	for (const auto& f : files) totalBytes += fs::file_size(f);
+
+	std::vector<double> samples;
+	samples.reserve(iterations);
+	std::size_t tokensPerPass = 0;
+
+	try {
+		for (int it = 0; it < iterations; ++it) {
+			std::size_t tokens = 0;
+			const auto start = std::chrono::steady_clock::now();
+			for (const auto& f : files) {
+				Tokenizer tokenizer(f);
+				while (tokenizer.hasMoreTokens()) {
+					++tokens;
+					tokenizer.advance();
+				}
+			}
+			const auto end = std::chrono::steady_clock::now();
+			samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+			tokensPerPass = tokens;
+		}
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	std::sort(samples.begin(), samples.end());
+	const double median = samples[samples.size() / 2];
+
+	std::cout << "Scan kernels: " << scan::backendName() << std::endl;
+	std::cout << "Files:        " << files.size() << " (" << totalBytes << " bytes)" << std::endl;
+	std::cout << "Tokens/pass:  " << tokensPerPass << std::endl;
+	std::cout << "Iterations:   " << iterations << std::endl;
+	std::cout << "Median pass:  " << median << " ms (min " << samples.front() << ", max " << samples.back() << ")" << std::endl;
+	std::cout << "Throughput:   " << static_cast<double>(tokensPerPass) / (median / 1000.0) / 1e6 << " M tokens/sec, "
+			  << static_cast<double>(totalBytes) / (median / 1000.0) / (1024.0 * 1024.0) << " MB/sec" << std::endl;
+	return 0;
+}
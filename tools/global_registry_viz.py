@@ -8,6 +8,15 @@ from textual.widgets import Header, Footer, DataTable, Input
 from textual.containers import Container
 from textual.binding import Binding
 
+def load_registry(path):
+    """
+    Reads the registry dump (see GlobalRegistry::dumpToNdjson), one method per line,
+    into {"registry": [...]}.
+    """
+    with open(path, 'r', encoding='utf-8') as f:
+        return {"registry": [json.loads(line) for line in f if line.strip()]}
+
+
 # ==================================================================================================
 # WIDGET: Registry Browser
 # Displays the registry data in a searchable table.
@@ -49,8 +58,7 @@ class RegistryBrowser(Container):
         # 2. Parse JSON
         # We keep specific exceptions for IO/JSON as they are expected runtime conditions
         try:
-            with open(self.json_path, 'r') as f:
-                data = json.load(f)
+            data = load_registry(self.json_path)
         except json.JSONDecodeError as e:
             self.notify(f"Invalid JSON format: {e}", severity="error")
             raise # Re-raise to ensure visibility in logs/traceback if needed
@@ -145,7 +153,7 @@ def cleanup_temp_file(path):
 
 if __name__ == "__main__":
     if len(sys.argv) < 2:
-        print("Usage: python3 global_registry_viz.py <path_to_json>")
+        print("Usage: python3 global_registry_viz.py <path_to_ndjson>")
         sys.exit(1)
 
     json_path = sys.argv[1]
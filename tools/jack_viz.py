@@ -1,27 +1,62 @@
 import sys
 import os
-import xml.etree.ElementTree as ET
 import json
 import webview
 
 
 # 1. PARSER
-def parse_node(element):
-    tag = element.tag
-    text = element.text.strip() if element.text else ""
+STYLE_MAP = {
+    "class": {"f": "#1f6feb", "s": "#388bfd"}, "subroutineDec": {"f": "#238636", "s": "#2ea043"},
+    "classVarDec": {"f": "#238636", "s": "#2ea043"}, "varDec": {"f": "#30363d", "s": "#2ea043"},
+    "doStatement": {"f": "#8957e5", "s": "#a371f7"}, "letStatement": {"f": "#8957e5", "s": "#a371f7"},
+    "ifStatement": {"f": "#d29922", "s": "#e3b341"}, "whileStatement": {"f": "#d29922", "s": "#e3b341"},
+    "statements": {"f": "#30363d", "s": "#e3b341"}, "else": {"f": "#30363d", "s": "#e3b341"},
+    "returnStatement": {"f": "#da3633", "s": "#f85149"}, "identifier": {"f": "#30363d", "s": "#6e7681"},
+    "binaryOp": {"f": "#30363d", "s": "#8b949e"}, "unaryOp": {"f": "#30363d", "s": "#8b949e"},
+    "subroutineCall": {"f": "#8957e5", "s": "#a371f7"}, "integerConstant": {"f": "#1f6feb", "s": "#58a6ff"},
+    "stringConstant": {"f": "#1f6feb", "s": "#58a6ff"}, "keyword": {"f": "#da3633", "s": "#f85149"},
+    "default": {"f": "#30363d", "s": "#6e7681"}
+}
+
+
+def make_node(record):
+    tag = record["t"]
     label = tag
-    if text: label += f": {text}"
-    style_map = {
-        "class": {"f": "#1f6feb", "s": "#388bfd"}, "subroutineDec": {"f": "#238636", "s": "#2ea043"},
-        "doStatement": {"f": "#8957e5", "s": "#a371f7"}, "letStatement": {"f": "#8957e5", "s": "#a371f7"},
-        "ifStatement": {"f": "#d29922", "s": "#e3b341"}, "whileStatement": {"f": "#d29922", "s": "#e3b341"},
-        "returnStatement": {"f": "#da3633", "s": "#f85149"}, "identifier": {"f": "#30363d", "s": "#6e7681"},
-        "symbol": {"f": "#30363d", "s": "#8b949e"}, "integerConstant": {"f": "#1f6feb", "s": "#58a6ff"},
-        "stringConstant": {"f": "#1f6feb", "s": "#58a6ff"}, "keyword": {"f": "#da3633", "s": "#f85149"},
-        "default": {"f": "#30363d", "s": "#6e7681"}
-    }
-    style = style_map.get(tag, style_map["default"])
-    return { "name": label, "fill": style["f"], "stroke": style["s"], "children": [parse_node(child) for child in element] }
+    if record.get("x"): label += f": {record['x']}"
+    style = STYLE_MAP.get(tag, STYLE_MAP["default"])
+    return {"name": label, "fill": style["f"], "stroke": style["s"], "children": []}
+
+
+def load_ast(path):
+    """
+    Reads one .ast.ndjson dump (see Compiler/Viz/AstExport.h) line by line.
+    Nodes come in pre-order with their depth, so each one is attached to the last node
+    one level up; nothing but that path of open nodes is kept aside.
+    Returns (display name, tree).
+    """
+    display_name = os.path.basename(path)
+    root = None
+    open_nodes = []  # open_nodes[d]: the most recent node at depth d
+    with open(path, "r", encoding="utf-8") as f:
+        for line_no, line in enumerate(f, 1):
+            if not line.strip(): continue
+            record = json.loads(line)
+            if "file" in record:
+                display_name = record["file"]
+                continue
+            depth = record["d"]
+            if depth > len(open_nodes) or (depth == 0 and root is not None):
+                raise ValueError(f"line {line_no}: node at depth {depth} has no parent")
+            node = make_node(record)
+            del open_nodes[depth:]
+            if depth == 0:
+                root = node
+            else:
+                open_nodes[depth - 1]["children"].append(node)
+            open_nodes.append(node)
+    if root is None:
+        raise ValueError("Empty AST dump")
+    return display_name, root
 
 
 # 2. LOCAL ASSET LOADER
@@ -170,43 +205,34 @@ def get_html_content(files_payload, d3_script_tag):
 if __name__ == "__main__":
     # Validation: Arguments
     if len(sys.argv) < 2:
-        print("Error: No XML files provided.", file=sys.stderr)
-        print("Usage: python jack_viz.py <file1.xml> <file2.xml> ...", file=sys.stderr)
+        print("Error: No AST dumps provided.", file=sys.stderr)
+        print("Usage: python jack_viz.py <file1.ast.ndjson> <file2.ast.ndjson> ...", file=sys.stderr)
         sys.exit(1)
 
-    xml_files = sys.argv[1:]
+    dump_files = sys.argv[1:]
     files_payload = []
     errors = []
 
     # Parse Files with Explicit Error Handling
-    for xml_path in xml_files:
-        if not os.path.exists(xml_path):
-            print(f" Error: File not found: {xml_path}", file=sys.stderr)
-            errors.append(xml_path)
+    for dump_path in dump_files:
+        if not os.path.exists(dump_path):
+            print(f" Error: File not found: {dump_path}", file=sys.stderr)
+            errors.append(dump_path)
             continue
 
         try:
-            tree = ET.parse(xml_path)
-
-            # Extract clean name: "Main_18293.xml" -> "Main.jack"
-            raw_name = os.path.basename(xml_path)
-            display_name = raw_name.split('_')[0] + ".jack" if "_" in raw_name else raw_name
-
-            root = tree.getroot()
-            if root is None:
-                raise ValueError("Empty XML root")
-
+            display_name, tree = load_ast(dump_path)
             files_payload.append({
                 "filename": display_name,
-                "tree": parse_node(root)
+                "tree": tree
             })
 
-        except ET.ParseError as e:
-            print(f" JSON Parse Error in {xml_path}: {e}", file=sys.stderr)
-            errors.append(xml_path)
+        except json.JSONDecodeError as e:
+            print(f" JSON Parse Error in {dump_path}: {e}", file=sys.stderr)
+            errors.append(dump_path)
         except Exception as e:
-            print(f" Unexpected Error processing {xml_path}: {e}", file=sys.stderr)
-            errors.append(xml_path)
+            print(f" Unexpected Error processing {dump_path}: {e}", file=sys.stderr)
+            errors.append(dump_path)
 
     # Critical Failure Check
     if not files_payload:
@@ -8,6 +8,32 @@ from textual.widgets import Header, Footer, DataTable, Tree, Label
 from textual.containers import Container, Vertical, Horizontal
 from textual.binding import Binding
 
+def load_symbols(path):
+    """
+    Reads one .sym.ndjson dump (see SymbolTable::dumpToNdjson) line by line into
+    {"className", "classSymbols": [...], "subroutines": [{"name", "symbols": [...]}]}.
+    """
+    data = {"className": os.path.basename(path), "classSymbols": [], "subroutines": []}
+    scopes = {}  # subroutine name -> its entry in data["subroutines"]
+    with open(path, 'r', encoding='utf-8') as f:
+        for line in f:
+            if not line.strip(): continue
+            record = json.loads(line)
+            if "className" in record:
+                data["className"] = record["className"]
+            elif "subroutine" in record:
+                scope = {"name": record["subroutine"], "symbols": []}
+                scopes[scope["name"]] = scope
+                data["subroutines"].append(scope)
+            else:
+                scope = record.pop("scope", "class")
+                if scope == "class":
+                    data["classSymbols"].append(record)
+                else:
+                    scopes[scope]["symbols"].append(record)
+    return data
+
+
 # ==================================================================================================
 # WIDGET: Symbol Table Browser
 # A split-view widget: File Tree (left) + Symbol Table (right).
@@ -56,8 +82,7 @@ class SymbolTableBrowser(Container):
                 continue
             
             try:
-                with open(path, 'r') as f:
-                    data = json.load(f)
+                data = load_symbols(path)
 
                 # Use class name as key, fallback to filename
                 name = data.get("className", os.path.basename(path))
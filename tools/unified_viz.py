@@ -79,8 +79,8 @@ def cleanup_files(paths):
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="Unified Dashboard for Jack Compiler Visualization")
-    parser.add_argument("--registry", required=True, help="Path to the global registry JSON file")
-    parser.add_argument("--symbols", nargs="+", default=[], help="List of paths to symbol table JSON files")
+    parser.add_argument("--registry", required=True, help="Path to the global registry NDJSON dump")
+    parser.add_argument("--symbols", nargs="+", default=[], help="List of paths to symbol table NDJSON dumps")
     
     # Removed try/except around parse_args as argparse handles errors well
     args = parser.parse_args()